@@ -0,0 +1,102 @@
+/*
+ * opencog/cogserver/checkpoint/AtomDump.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/cogserver/checkpoint/BackgroundSave.h>
+
+#include "AtomDump.h"
+
+using namespace opencog;
+
+std::string AtomDump::send(const AtomSpacePtr& as, const Sender& send,
+                           const FileSender& send_file)
+{
+    std::string path = config().get("DUMP_DIR", "/tmp");
+    path += "/cogserver-dump-XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if (fd < 0)
+        throw IOException(TRACE_INFO, "Cannot create %s: %s",
+                          path.c_str(), strerror(errno));
+    close(fd);
+
+    // The child replaces the file made above, when it is done.
+    auto start = std::chrono::steady_clock::now();
+    BackgroundSave child("dump");
+    bool saved_ok = false;
+    try {
+        child.start(as, path);
+        saved_ok = child.wait();
+    } catch (...) {
+        unlink(path.c_str());
+        throw;
+    }
+    if (not saved_ok)
+    {
+        unlink(path.c_str());
+        unlink((path + ".tmp").c_str());
+        throw IOException(TRACE_INFO, "Cannot write %s: %s",
+                          path.c_str(), child.last_error().c_str());
+    }
+    size_t natoms = child.last_atoms();
+    auto saved = std::chrono::steady_clock::now();
+
+    // The file stays open after the unlink; it goes away when closed.
+    fd = open(path.c_str(), O_RDONLY);
+    unlink(path.c_str());
+    struct stat st;
+    if (fd < 0 or fstat(fd, &st))
+    {
+        if (0 <= fd) close(fd);
+        throw IOException(TRACE_INFO, "Cannot read %s: %s",
+                          path.c_str(), strerror(errno));
+    }
+
+    size_t frame = config().get_int("DUMP_FRAME_SIZE", 16*1024*1024);
+    size_t left = st.st_size;
+    bool ok = true;
+    while (ok and 0 < left)
+    {
+        uint32_t len = std::min(left, frame);
+        unsigned char hdr[4] = {
+            (unsigned char) len, (unsigned char) (len >> 8),
+            (unsigned char) (len >> 16), (unsigned char) (len >> 24)};
+        send(std::string((char*) hdr, 4));
+        ok = send_file(fd, len);
+        left -= len;
+    }
+    close(fd);
+    if (ok) send(std::string(4, 0));
+
+    auto sent = std::chrono::steady_clock::now();
+    std::chrono::duration<double> save_secs = saved - start;
+    std::chrono::duration<double> send_secs = sent - saved;
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "Dumped %zu atoms, %zu bytes: %.3f seconds to save, "
+             "%.3f to send (%.1f MB/s)%s\n",
+             natoms, (size_t) st.st_size, save_secs.count(),
+             send_secs.count(),
+             st.st_size / 1048576.0 / std::max(send_secs.count(), 1e-6),
+             ok ? "" : "; the client went away");
+    logger().info("%s", buf);
+    return buf;
+}
+
+/* ===================== END OF FILE ============================ */
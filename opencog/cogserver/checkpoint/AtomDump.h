@@ -0,0 +1,53 @@
+/*
+ * opencog/cogserver/checkpoint/AtomDump.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_ATOM_DUMP_H
+#define _OPENCOG_ATOM_DUMP_H
+
+#include <functional>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Stream a snapshot of the AtomSpace to a client, as binary frames:
+ * a four-byte little-endian length, then that many bytes, ended by an
+ * empty frame. The `restore` shell takes the same stream.
+ *
+ * The snapshot is written to a file in DUMP_DIR first, and not to the
+ * socket, so that the kernel can send it from the page cache, and so
+ * that a slow client does not hold up the walk over the AtomSpace. It
+ * is written by a forked child, as a `checkpoint` is (see
+ * BackgroundSave), so that nothing is locked while it is written;
+ * only the fork waits for the shells to be idle.
+ */
+class AtomDump
+{
+public:
+    /// Send bytes as they are.
+    typedef std::function<void(const std::string&)> Sender;
+
+    /// Send `len` bytes from `fd`; false if the client went away.
+    typedef std::function<bool(int fd, size_t len)> FileSender;
+
+    /** Write the snapshot, and send it, in frames of up to
+     *  DUMP_FRAME_SIZE bytes. Returns a short report, for the log.
+     *  Throws if the snapshot cannot be written. */
+    static std::string send(const AtomSpacePtr&, const Sender&,
+                            const FileSender&);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_ATOM_DUMP_H
@@ -0,0 +1,318 @@
+/*
+ * opencog/cogserver/checkpoint/BackgroundSave.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <shared_mutex>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/network/GenericShell.h>
+
+#include <opencog/cogserver/server/AtomSnapshot.h>
+
+#include "BackgroundSave.h"
+
+using namespace opencog;
+
+BackgroundSave::BackgroundSave(const std::string& what) :
+    _what(what),
+    _monitor(nullptr),
+    _child(0),
+    _started(0),
+    _timeout(3600),
+    _ndone(0),
+    _nfailed(0),
+    _last_result(false),
+    _last_ok(0),
+    _last_atoms(0),
+    _last_secs(0.0),
+    _last_cow_kb(0)
+{
+}
+
+BackgroundSave::~BackgroundSave()
+{
+    // Let a running checkpoint finish; it is probably wanted.
+    if (_monitor)
+    {
+        _monitor->join();
+        delete _monitor;
+    }
+}
+
+bool BackgroundSave::running(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return 0 < _child;
+}
+
+bool BackgroundSave::wait(void)
+{
+    // The monitor takes _mtx before it finishes; join it without.
+    std::unique_lock<std::mutex> lck(_mtx);
+    std::thread* mon = _monitor;
+    _monitor = nullptr;
+    lck.unlock();
+
+    if (mon)
+    {
+        mon->join();
+        delete mon;
+    }
+
+    lck.lock();
+    return _last_result;
+}
+
+size_t BackgroundSave::last_atoms(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _last_atoms;
+}
+
+std::string BackgroundSave::last_error(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _last_error;
+}
+
+/// Memory that the child had to copy, or allocate, for itself.
+static size_t private_dirty_kb(void)
+{
+    // smaps_rollup is much cheaper, where there is one.
+    std::ifstream in("/proc/self/smaps_rollup");
+    if (not in.is_open()) in.open("/proc/self/smaps");
+
+    size_t kb = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (0 == line.compare(0, 14, "Private_Dirty:"))
+            kb += strtoul(line.c_str() + 14, nullptr, 10);
+    }
+    return kb;
+}
+
+std::string BackgroundSave::start(const AtomSpacePtr& as,
+                                  const std::string& path,
+                                  std::function<void(bool)> done)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (0 < _child)
+        throw RuntimeException(TRACE_INFO,
+            "A %s to %s is already running", _what.c_str(), _path.c_str());
+
+    // The previous monitor has finished, or is about to.
+    if (_monitor)
+    {
+        _monitor->join();
+        delete _monitor;
+        _monitor = nullptr;
+    }
+
+    int pfd[2];
+    if (pipe(pfd))
+        throw RuntimeException(TRACE_INFO, "Cannot create a pipe: %s",
+                               strerror(errno));
+
+    _timeout = config().get_int("CHECKPOINT_TIMEOUT", 3600);
+    int wait = config().get_int("CHECKPOINT_WAIT", 30);
+
+    // Fork only when no shell is evaluating, and no other writer is
+    // running, so that no AtomSpace lock is held by a thread that the
+    // child won't have. Logging would take the logger's lock, so log
+    // nothing until the fork is done.
+    std::unique_lock<std::shared_timed_mutex> quiet(
+        GenericShell::eval_barrier(), std::defer_lock);
+    if (not quiet.try_lock_for(std::chrono::seconds(wait)))
+    {
+        close(pfd[0]);
+        close(pfd[1]);
+        throw RuntimeException(TRACE_INFO,
+            "The AtomSpace has been busy for %d seconds; "
+            "try the checkpoint again later", wait);
+    }
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        int err = errno;
+        quiet.unlock();
+        close(pfd[0]);
+        close(pfd[1]);
+        throw RuntimeException(TRACE_INFO, "Cannot fork: %s", strerror(err));
+    }
+
+    if (0 == pid)
+    {
+        // The child. It must not take a lock that some other thread
+        // might have held at the time of the fork: in particular, it
+        // must not log. Nor may it run the parent's atexit handlers
+        // or destructors.
+        close(pfd[0]);
+        prctl(PR_SET_NAME, "cogserv:ckpt", 0, 0, 0);
+        prctl(PR_SET_PDEATHSIG, SIGTERM, 0, 0, 0);
+
+        char buf[512];
+        int rc = 0;
+        try
+        {
+            size_t nskipped = 0;
+            size_t natoms = AtomSnapshot::save(as, path, &nskipped);
+            snprintf(buf, sizeof(buf), "ok %zu %zu %zu\n",
+                     natoms, private_dirty_kb(), nskipped);
+        }
+        catch (const std::exception& ex)
+        {
+            snprintf(buf, sizeof(buf), "error %s\n", ex.what());
+            rc = 1;
+        }
+        ssize_t unused = write(pfd[1], buf, strlen(buf));
+        (void) unused;
+        _exit(rc);
+    }
+
+    quiet.unlock();
+    close(pfd[1]);
+    _child = pid;
+    _path = path;
+    _done = done;
+    _started = time(nullptr);
+    _monitor = new std::thread(&BackgroundSave::monitor, this, pfd[0]);
+
+    logger().info("[BackgroundSave] %s to %s started in pid %d",
+                  _what.c_str(), path.c_str(), pid);
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "Checkpoint to %s started in process %d; see `stats`\n",
+             path.c_str(), pid);
+    return buf;
+}
+
+/// Wait for the child to report, or for it to time out.
+void BackgroundSave::monitor(int fd)
+{
+    prctl(PR_SET_NAME, "cogserv:ckptmon", 0, 0, 0);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::seconds(_timeout);
+
+    std::string report;
+    bool timed_out = false;
+    while (true)
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) { timed_out = true; break; }
+
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        int rc = poll(&pfd, 1, left.count());
+        if (rc < 0 and EINTR == errno) continue;
+        if (0 == rc) { timed_out = true; break; }
+
+        char buf[512];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0 and EINTR == errno) continue;
+        if (n <= 0) break;
+        report.append(buf, n);
+    }
+    close(fd);
+
+    if (timed_out) kill(_child, SIGKILL);
+    int status = 0;
+    while (waitpid(_child, &status, 0) < 0 and EINTR == errno);
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    size_t natoms = 0;
+    size_t cow_kb = 0;
+    size_t nskipped = 0;
+    bool ok = false;
+    if (not timed_out and WIFEXITED(status) and 0 == WEXITSTATUS(status) and
+        3 == sscanf(report.c_str(), "ok %zu %zu %zu",
+                    &natoms, &cow_kb, &nskipped))
+    {
+        ok = true;
+        _ndone++;
+        _last_ok = time(nullptr);
+        _last_atoms = natoms;
+        _last_secs = secs.count();
+        _last_cow_kb = cow_kb;
+        logger().info("[BackgroundSave] wrote %zu atoms to %s in %.3f "
+                      "seconds; copy-on-write %zu KB",
+                      natoms, _path.c_str(), secs.count(), cow_kb);
+        if (nskipped)
+            logger().info("[BackgroundSave] skipped %zu values of "
+                          "unsupported type", nskipped);
+    }
+    else
+    {
+        _nfailed++;
+        if (timed_out)
+            _last_error = "killed after " + std::to_string(_timeout) + "s";
+        else if (0 == report.compare(0, 6, "error "))
+            _last_error = report.substr(6, report.find('\n') - 6);
+        else if (WIFSIGNALED(status))
+            _last_error = std::string("killed by ") +
+                strsignal(WTERMSIG(status));
+        else
+            _last_error = "exited with status " +
+                std::to_string(WEXITSTATUS(status));
+        logger().error("[BackgroundSave] %s to %s failed: %s",
+                       _what.c_str(), _path.c_str(), _last_error.c_str());
+    }
+    _last_result = ok;
+    std::function<void(bool)> notify;
+    notify.swap(_done);
+    lck.unlock();
+
+    // Before the next checkpoint can start.
+    if (notify) notify(ok);
+
+    lck.lock();
+    _child = 0;
+}
+
+std::string BackgroundSave::display_stats(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (0 == _ndone and 0 == _nfailed and 0 == _child) return "";
+
+    std::string rc = _what + ":";
+    char buf[256];
+    if (_last_ok)
+    {
+        struct tm tm;
+        char tbuf[40];
+        gmtime_r(&_last_ok, &tm);
+        strftime(tbuf, sizeof(tbuf), "%d %b %H:%M:%S", &tm);
+        snprintf(buf, sizeof(buf),
+                 " last-ok: %s UTC (%zu atoms, %.1fs, cow %zu KB)",
+                 tbuf, _last_atoms, _last_secs, _last_cow_kb);
+        rc += buf;
+    }
+    if (_child)
+    {
+        snprintf(buf, sizeof(buf), " running: %lds",
+                 (long) (time(nullptr) - _started));
+        rc += buf;
+    }
+    snprintf(buf, sizeof(buf), " done: %zu failed: %zu", _ndone, _nfailed);
+    rc += buf;
+    if (0 < _nfailed) rc += " (" + _last_error + ")";
+    return rc + "\n";
+}
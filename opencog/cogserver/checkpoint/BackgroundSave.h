@@ -0,0 +1,105 @@
+/*
+ * opencog/cogserver/checkpoint/BackgroundSave.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_BACKGROUND_SAVE_H
+#define _OPENCOG_BACKGROUND_SAVE_H
+
+#include <sys/types.h>
+#include <time.h>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Write snapshots of the AtomSpace without stopping the server.
+ *
+ * Saving a large AtomSpace takes a while, and the client that asked
+ * for it waits, while the save competes with everyone else for the
+ * AtomSpace locks. Instead, start() forks the server. The child
+ * process has a copy-on-write image of the AtomSpace as it was at the
+ * moment of the fork; it writes that to a snapshot file (see
+ * AtomSnapshot), and exits. Meanwhile, the parent carries on. Pages
+ * that the parent changes while the child runs are copied by the
+ * kernel; the child reports how much memory that cost.
+ *
+ * Only the thread that called fork() exists in the child. If some
+ * other thread was holding an AtomSpace lock at the time, the child
+ * would wait for it forever. So start() first locks the shells' eval
+ * barrier (see GenericShell::eval_barrier()), waiting up to
+ * CHECKPOINT_WAIT seconds for the evaluations in progress to finish;
+ * the replica follower holds the same barrier while it applies
+ * changes. The barrier is released as soon as the fork is done. The
+ * child takes no other locks; it does not log, but reports back over
+ * a pipe. As a last resort, a child that runs for longer than
+ * CHECKPOINT_TIMEOUT seconds is killed, and the checkpoint counted as
+ * failed.
+ */
+class BackgroundSave
+{
+    std::string _what;
+    std::mutex _mtx;
+    std::thread* _monitor;
+    pid_t _child;
+    std::string _path;
+    std::function<void(bool)> _done;
+    time_t _started;
+    unsigned int _timeout;
+
+    // Statistics
+    size_t _ndone;
+    size_t _nfailed;
+    bool _last_result;
+    time_t _last_ok;
+    size_t _last_atoms;
+    double _last_secs;
+    size_t _last_cow_kb;
+    std::string _last_error;
+
+    void monitor(int fd);
+
+public:
+    /** `what` names the saves in the log, and in `stats`. */
+    BackgroundSave(const std::string& what = "checkpoint");
+    ~BackgroundSave();
+
+    /** Fork, and write the AtomSpace to `path` in the child. Returns
+     *  a short report. Throws if a checkpoint is already running, or
+     *  the fork fails. When the child is done, `done` is called, in
+     *  another thread, with whether it succeeded. */
+    std::string start(const AtomSpacePtr&, const std::string& path,
+                      std::function<void(bool)> done = nullptr);
+
+    bool running(void);
+
+    /** Wait for the child, if one is running, to finish. Returns
+     *  whether the last save succeeded. */
+    bool wait(void);
+
+    /** The number of atoms in the last successful save, and why the
+     *  last failed one failed. */
+    size_t last_atoms(void);
+    std::string last_error(void);
+
+    /** One line: last successful checkpoint, its duration, atoms and
+     *  copy-on-write growth; the number done and failed. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_BACKGROUND_SAVE_H
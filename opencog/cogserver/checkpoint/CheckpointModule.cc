@@ -0,0 +1,293 @@
+/*
+ * opencog/cogserver/checkpoint/CheckpointModule.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <chrono>
+#include <thread>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/util/oc_assert.h>
+#include <opencog/network/ConsoleSocket.h>
+#include <opencog/cogserver/server/AtomSnapshot.h>
+#include <opencog/cogserver/checkpoint/AtomDump.h>
+
+#include "CheckpointModule.h"
+
+using namespace opencog;
+
+DECLARE_MODULE(CheckpointModule);
+
+CheckpointModule::CheckpointModule(CogServer& cs) :
+    Module(cs),
+    _deltas(cs.changeFeed())
+{
+}
+
+void CheckpointModule::init(void)
+{
+    _cogserver.addStats("checkpoint", [this]() { return display_stats(); });
+
+    do_snapshot_register();
+    do_checkpoint_register();
+    do_checkpoint_delta_register();
+    do_checkpoint_compact_register();
+    do_dump_register();
+    do_wal_register();
+}
+
+CheckpointModule::~CheckpointModule()
+{
+    do_snapshot_unregister();
+    do_checkpoint_unregister();
+    do_checkpoint_delta_unregister();
+    do_checkpoint_compact_unregister();
+    do_dump_unregister();
+    do_wal_unregister();
+
+    _cogserver.removeStats("checkpoint");
+}
+
+/// The only config string is `load <filename>`.
+bool CheckpointModule::config(const char* cfg)
+{
+    std::string str(cfg);
+    if (0 != str.compare(0, 5, "load ")) return false;
+
+    std::string path(str.substr(5));
+    try {
+        loadSnapshot(path);
+    }
+    catch (const RuntimeException& ex) {
+        logger().error("[CheckpointModule] Unable to load snapshot %s: %s",
+                       path.c_str(), ex.what());
+        return false;
+    }
+    return true;
+}
+
+/* ============================================================== */
+
+/// Take _base_mtx, or throw, if a base is being written already,
+/// in the foreground, or by a background checkpoint.
+void CheckpointModule::lockBase(std::unique_lock<std::mutex>& lck)
+{
+    lck = std::unique_lock<std::mutex>(_base_mtx, std::try_to_lock);
+    if (not lck.owns_lock() or _bgsave.running())
+        throw RuntimeException(TRACE_INFO,
+            "A checkpoint is being written or compacted; "
+            "try again when it is done");
+}
+
+std::string CheckpointModule::saveSnapshot(const std::string& path)
+{
+    std::unique_lock<std::mutex> lck;
+    lockBase(lck);
+
+    auto start = std::chrono::steady_clock::now();
+    _deltas.begin_base();
+    size_t natoms = 0;
+    try {
+        natoms = AtomSnapshot::save(_cogserver.getAtomSpace(), path);
+    } catch (...) {
+        _deltas.end_base(path, false);
+        throw;
+    }
+    _deltas.end_base(path, true);
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "Wrote %zu atoms to %s in %.3f seconds\n",
+             natoms, path.c_str(), secs.count());
+    logger().info("%s", buf);
+    return buf;
+}
+
+std::string CheckpointModule::loadSnapshot(const std::string& path)
+{
+    // Loading starts tracking deltas against this base afresh.
+    std::unique_lock<std::mutex> lck;
+    lockBase(lck);
+    _cogserver.newAtomSpaceGeneration();
+
+    int nthreads = opencog::config().get_int("SNAPSHOT_LOAD_THREADS",
+                                    std::thread::hardware_concurrency());
+
+    const AtomSpacePtr& as = _cogserver.getAtomSpace();
+    ChangeFeed& feed = _cogserver.changeFeed();
+    auto start = std::chrono::steady_clock::now();
+    size_t natoms = AtomSnapshot::load(as, path, nthreads, &feed);
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "Loaded %zu atoms from %s in %.3f seconds (%d threads)\n",
+             natoms, path.c_str(), secs.count(), nthreads);
+    logger().info("%s", buf);
+
+    std::string report(buf);
+    report += DeltaCheckpoint::restore(as, path, feed);
+    _deltas.reset(path);
+    return report;
+}
+
+static std::string checkpoint_file(const std::string& path)
+{
+    std::string file(path);
+    if (0 == file.size()) file = opencog::config().get("CHECKPOINT_FILE", "");
+    if (0 == file.size())
+        throw RuntimeException(TRACE_INFO,
+            "No file given, and CHECKPOINT_FILE is not set");
+    return file;
+}
+
+std::string CheckpointModule::checkpoint(const std::string& path)
+{
+    std::string file(checkpoint_file(path));
+    std::unique_lock<std::mutex> lck;
+    lockBase(lck);
+
+    // The deltas that exist now are included in the new base; any
+    // written while the child runs are not.
+    size_t ndeltas = _deltas.chain_length(file);
+    _deltas.begin_base();
+    try {
+        return _bgsave.start(_cogserver.getAtomSpace(), file,
+            [this, file, ndeltas](bool ok) {
+                _deltas.end_base(file, ok, ndeltas); });
+    } catch (...) {
+        _deltas.end_base(file, false);
+        throw;
+    }
+}
+
+std::string CheckpointModule::checkpointDelta(const std::string& path)
+{
+    return _deltas.write(_cogserver.getAtomSpace(), checkpoint_file(path));
+}
+
+std::string CheckpointModule::compactCheckpoint(const std::string& path)
+{
+    std::unique_lock<std::mutex> lck;
+    lockBase(lck);
+
+    int nthreads = opencog::config().get_int("SNAPSHOT_LOAD_THREADS",
+                                    std::thread::hardware_concurrency());
+    return _deltas.compact(checkpoint_file(path), nthreads);
+}
+
+std::string CheckpointModule::checkpointWAL(void)
+{
+    WriteAheadLog& wal = _cogserver.writeAheadLog();
+    if (not wal.enabled())
+        return "The write-ahead log is not in use; set WAL_FILE\n";
+    wal.checkpoint();
+    return "Write-ahead log emptied\n";
+}
+
+std::string CheckpointModule::display_stats(void)
+{
+    return _bgsave.display_stats() + _deltas.display_stats();
+}
+
+/* ============================================================== */
+// Write or load a snapshot of the atomspace.
+std::string CheckpointModule::do_snapshot(Request *req, std::list<std::string> args)
+{
+    std::string verb("save");
+    if (2 == args.size())
+    {
+        verb = args.front();
+        args.pop_front();
+    }
+    if (1 != args.size() or (verb != "save" and verb != "load"))
+        return "invalid syntax: snapshot [save|load] <filename>\n";
+
+    try {
+        if (verb == "load")
+            return loadSnapshot(args.front());
+        return saveSnapshot(args.front());
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Snapshot failed: ") + ex.what() + "\n";
+    }
+}
+
+// Write a snapshot from a forked child.
+std::string CheckpointModule::do_checkpoint(Request *req, std::list<std::string> args)
+{
+    try {
+        return checkpoint(args.empty() ? "" : args.front());
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Checkpoint failed: ") + ex.what() + "\n";
+    }
+}
+
+std::string CheckpointModule::do_checkpoint_delta(Request *req, std::list<std::string> args)
+{
+    try {
+        return checkpointDelta(args.empty() ? "" : args.front());
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Delta checkpoint failed: ") + ex.what() + "\n";
+    }
+}
+
+std::string CheckpointModule::do_checkpoint_compact(Request *req, std::list<std::string> args)
+{
+    try {
+        return compactCheckpoint(args.empty() ? "" : args.front());
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Compaction failed: ") + ex.what() + "\n";
+    }
+}
+
+// Stream the atomspace to the client.
+std::string CheckpointModule::do_dump(Request *req, std::list<std::string> args)
+{
+    ConsoleSocket* con = req->get_console();
+    OC_ASSERT(con, "Bad request state");
+    if (con->is_websocket())
+        return "dump is not available over WebSockets\n";
+
+    // The request lets go of the socket now, so that it sends no
+    // prompt into the middle of the frames.
+    AtomSpacePtr as = _cogserver.getAtomSpace();
+    req->run_detached("Dump failed: ", [as, con]() {
+        return AtomDump::send(as,
+            [con](const std::string& bytes) { con->Send(bytes); },
+            [con](int fd, size_t len) { return con->SendFile(fd, len); });
+    });
+    return "";
+}
+
+std::string CheckpointModule::do_wal(Request *req, std::list<std::string> args)
+{
+    if (args.empty())
+    {
+        WriteAheadLog& wal = _cogserver.writeAheadLog();
+        if (not wal.enabled())
+            return "The write-ahead log is not in use; set WAL_FILE\n";
+        return wal.display_stats();
+    }
+
+    if (args.front() != "checkpoint")
+        return "invalid syntax: wal [checkpoint]\n";
+
+    try {
+        return checkpointWAL();
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Checkpoint failed: ") + ex.what() + "\n";
+    }
+}
+
+/* ===================== END OF FILE ============================ */
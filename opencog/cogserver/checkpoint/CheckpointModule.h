@@ -0,0 +1,172 @@
+/*
+ * opencog/cogserver/checkpoint/CheckpointModule.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_CHECKPOINT_MODULE_H
+#define _OPENCOG_CHECKPOINT_MODULE_H
+
+#include <mutex>
+#include <string>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/cogserver/checkpoint/BackgroundSave.h>
+#include <opencog/cogserver/checkpoint/DeltaCheckpoint.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Save the CogServer AtomSpace to disk, and load it back.
+ *
+ * This module provides the `snapshot`, `checkpoint`, `checkpoint-delta`
+ * and `checkpoint-compact` commands. A snapshot is written while the
+ * client waits (see AtomSnapshot); a checkpoint is written by a forked
+ * child, while the server carries on (see BackgroundSave). Either one
+ * becomes the base for a chain of deltas (see DeltaCheckpoint). Only
+ * one base is written at a time: a snapshot, checkpoint or compaction
+ * is refused while another is in progress.
+ *
+ * It also provides the `dump` command, which streams a snapshot to
+ * the client (see AtomDump), and the `wal` command, to empty the
+ * write-ahead log once the AtomSpace has been saved. The log itself
+ * belongs to the server, which replays it at startup.
+ *
+ * The config string `load <filename>` loads a snapshot and its chain
+ * of deltas; the cogserver passes `--snapshot <filename>` on to this
+ * module in that way, after the modules are loaded, and before the
+ * network ports are opened.
+ */
+class CheckpointModule : public Module
+{
+private:
+    // The deltas must outlive the background save, which calls back
+    // into them when the child finishes.
+    DeltaCheckpoint _deltas;
+    BackgroundSave _bgsave;
+
+    // Held while a base is written in the foreground, compacted, or
+    // a checkpoint is started; only one of these at a time.
+    std::mutex _base_mtx;
+    void lockBase(std::unique_lock<std::mutex>&);
+
+    std::string display_stats(void);
+
+DECLARE_CMD_REQUEST(CheckpointModule, "snapshot", do_snapshot,
+       "Write or load a binary snapshot of the AtomSpace.",
+       "Usage: snapshot [save] <filename>\n"
+       "       snapshot load <filename>\n\n"
+       "`save` writes every atom in the AtomSpace, together with its\n"
+       "values, to the named file, in a compact binary format. `load`\n"
+       "adds the atoms and values in the file to the AtomSpace, followed\n"
+       "by its chain of deltas, if it has one, as does starting the\n"
+       "cogserver with `--snapshot <filename>`. The file is on the\n"
+       "server, not the client.\n",
+       false, false)
+
+DECLARE_CMD_REQUEST(CheckpointModule, "checkpoint", do_checkpoint,
+       "Write a snapshot in the background.",
+       "Usage: checkpoint [<filename>]\n\n"
+       "Like `snapshot`, but the server does not pause while the file is\n"
+       "written: the server is forked, and the child process writes a\n"
+       "copy-on-write image of the AtomSpace as it was at that moment,\n"
+       "while the server carries on. The command returns at once. The\n"
+       "outcome, the time taken and the memory used are shown by `stats`.\n"
+       "With no filename, CHECKPOINT_FILE from the config file is used.\n",
+       false, false)
+
+DECLARE_CMD_REQUEST(CheckpointModule, "checkpoint-delta", do_checkpoint_delta,
+       "Write the atoms changed since the last checkpoint.",
+       "Usage: checkpoint-delta [<filename>]\n\n"
+       "After a base has been written with `snapshot` or `checkpoint`, or\n"
+       "loaded at startup, the server keeps track of which atoms change.\n"
+       "This writes just those atoms, with all of their values, and the\n"
+       "atoms that were removed, to <filename>.delta.<n>, and adds it to\n"
+       "the chain of deltas listed in <filename>.chain. Starting the\n"
+       "server with `--snapshot <filename>` loads the base, and then\n"
+       "applies the chain. With no filename, CHECKPOINT_FILE is used.\n",
+       false, false)
+
+DECLARE_CMD_REQUEST(CheckpointModule, "checkpoint-compact", do_checkpoint_compact,
+       "Merge a chain of checkpoint deltas into a new base.",
+       "Usage: checkpoint-compact [<filename>]\n\n"
+       "Load the base snapshot <filename> and its chain of deltas into a\n"
+       "scratch AtomSpace, write that out as the new base, and remove the\n"
+       "deltas. The AtomSpace being served is not touched. With no\n"
+       "filename, CHECKPOINT_FILE is used. Refused while a `checkpoint`\n"
+       "is being written.\n",
+       false, false)
+
+DECLARE_CMD_REQUEST(CheckpointModule, "dump", do_dump,
+       "Send the AtomSpace over this connection.",
+       "Usage: dump\n\n"
+       "Send all of the atoms, and their values, in the compact binary\n"
+       "form of the `snapshot` command, as length-prefixed frames (a\n"
+       "four-byte little-endian length, then the bytes), ended by an\n"
+       "empty frame. A short report follows, in text. The dump can be\n"
+       "sent, as it is, to the `restore` shell of another server.\n"
+       "The snapshot is written to a file in DUMP_DIR by a forked child,\n"
+       "as by `checkpoint`, and sent from there with sendfile, in a\n"
+       "thread of its own, so that the rest of the server carries on.\n"
+       "Wait for the report before sending anything else on this\n"
+       "connection. Not available over WebSockets.\n",
+       false, false)
+
+DECLARE_CMD_REQUEST(CheckpointModule, "wal", do_wal,
+       "Manage the write-ahead log.",
+       "Usage: wal [checkpoint]\n\n"
+       "When WAL_FILE is set in the config file, every change to the\n"
+       "AtomSpace is also written to that file, and replayed from it at\n"
+       "startup, so that nothing is lost in a crash. With no arguments,\n"
+       "this shows the log statistics. After the AtomSpace has been saved\n"
+       "elsewhere, e.g. to a StorageNode or a snapshot that is loaded at\n"
+       "startup, `wal checkpoint` empties the log.\n",
+       false, false)
+
+public:
+    static const char* id(void);
+    CheckpointModule(CogServer&);
+    virtual ~CheckpointModule();
+    virtual void init(void);
+    virtual bool config(const char*);
+
+    /** Write the AtomSpace to a binary snapshot file. Returns a short
+     *  report, suitable for display. Throws on error. */
+    std::string saveSnapshot(const std::string& path);
+
+    /** Load a snapshot written by saveSnapshot() into the AtomSpace,
+     *  using SNAPSHOT_LOAD_THREADS threads, followed by its chain of
+     *  deltas, if it has one. Returns a short report. Throws on error,
+     *  or if a checkpoint is being written. */
+    std::string loadSnapshot(const std::string& path);
+
+    /** Write a snapshot in a forked child process, so that the server
+     *  does not pause. An empty path means CHECKPOINT_FILE. Returns
+     *  at once, with a short report; the outcome is shown by `stats`.
+     *  Throws if one is already running. */
+    std::string checkpoint(const std::string& path);
+    bool checkpointRunning(void) { return _bgsave.running(); }
+
+    /** Write the atoms changed since the last checkpoint, as the next
+     *  delta after the base at `path` (or CHECKPOINT_FILE). */
+    std::string checkpointDelta(const std::string& path);
+
+    /** Merge the base at `path` (or CHECKPOINT_FILE) and its deltas
+     *  into a new base. Throws if a checkpoint is being written. */
+    std::string compactCheckpoint(const std::string& path);
+
+    /** Empty the write-ahead log, after the AtomSpace was saved. */
+    std::string checkpointWAL(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_CHECKPOINT_MODULE_H
@@ -0,0 +1,350 @@
+/*
+ * opencog/cogserver/checkpoint/DeltaCheckpoint.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+
+#include <opencog/cogserver/server/AtomSnapshot.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+#include <opencog/cogserver/server/WriteAheadLog.h>
+
+#include "DeltaCheckpoint.h"
+
+using namespace opencog;
+
+DeltaCheckpoint::DeltaCheckpoint(ChangeFeed& feed) :
+    _feed(feed),
+    _tracking(false),
+    _chain(0),
+    _ndeltas(0),
+    _last_atoms(0),
+    _last_bytes(0),
+    _last_ms(0.0)
+{
+}
+
+DeltaCheckpoint::~DeltaCheckpoint()
+{
+    if (_tracking) _feed.remove_listener("delta-checkpoint");
+}
+
+void DeltaCheckpoint::mark(int kind, const Handle& h)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (ChangeFeed::ATOM_REMOVED == kind)
+    {
+        _dirty.erase(h);
+        _removed.insert(h);
+        return;
+    }
+    _removed.erase(h);
+    _dirty.insert(h);
+}
+
+/// Must be called with _mtx held. Put older changes back into the
+/// current sets; where both have an atom, the current one wins.
+void DeltaCheckpoint::merge(UnorderedHandleSet& dirty,
+                            UnorderedHandleSet& removed)
+{
+    for (const Handle& h : dirty)
+        if (0 == _removed.count(h)) _dirty.insert(h);
+    for (const Handle& h : removed)
+        if (0 == _dirty.count(h)) _removed.insert(h);
+    dirty.clear();
+    removed.clear();
+}
+
+void DeltaCheckpoint::begin_base(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    // Set the changes aside, in case the base cannot be written.
+    for (const Handle& h : _dirty)
+    {
+        _held_removed.erase(h);
+        _held_dirty.insert(h);
+    }
+    for (const Handle& h : _removed)
+    {
+        _held_dirty.erase(h);
+        _held_removed.insert(h);
+    }
+    _dirty.clear();
+    _removed.clear();
+    if (_tracking) return;
+
+    _tracking = true;
+    _feed.add_listener("delta-checkpoint",
+        [this](ChangeFeed::Kind kind, const Handle& h,
+               const Handle&, const ValuePtr&)
+        { mark(kind, h); });
+}
+
+void DeltaCheckpoint::end_base(const std::string& base, bool ok, size_t n)
+{
+    size_t len = 0;
+    if (ok)
+    {
+        drop_chain(base, n);
+        len = chain_length(base);
+    }
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (not ok)
+    {
+        merge(_held_dirty, _held_removed);
+        return;
+    }
+    _held_dirty.clear();
+    _held_removed.clear();
+    _base = base;
+    _chain = len;
+}
+
+void DeltaCheckpoint::reset(const std::string& base)
+{
+    begin_base();
+    end_base(base, true, 0);
+}
+
+/* ============================================================== */
+
+std::vector<std::string> DeltaCheckpoint::read_chain(const std::string& base)
+{
+    std::vector<std::string> chain;
+    std::ifstream in(base + ".chain");
+    std::string line;
+    while (std::getline(in, line))
+        if (0 < line.size()) chain.push_back(line);
+    return chain;
+}
+
+void DeltaCheckpoint::write_chain(const std::string& base,
+                                  const std::vector<std::string>& chain)
+{
+    std::string path = base + ".chain";
+    if (chain.empty())
+    {
+        unlink(path.c_str());
+        return;
+    }
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        for (const std::string& d : chain) out << d << "\n";
+        out.flush();
+        if (not out.good())
+            throw IOException(TRACE_INFO, "Cannot write %s", tmp.c_str());
+    }
+    AtomSnapshot::commit_file(tmp, path);
+}
+
+size_t DeltaCheckpoint::chain_length(const std::string& base)
+{
+    std::lock_guard<std::mutex> wlck(_write_mtx);
+    return read_chain(base).size();
+}
+
+void DeltaCheckpoint::drop_chain(const std::string& base, size_t n)
+{
+    std::lock_guard<std::mutex> wlck(_write_mtx);
+    std::vector<std::string> chain(read_chain(base));
+    if (n > chain.size()) n = chain.size();
+    for (size_t i = 0; i < n; i++)
+        unlink(chain[i].c_str());
+    chain.erase(chain.begin(), chain.begin() + n);
+    write_chain(base, chain);
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (base == _base) _chain = chain.size();
+}
+
+/* ============================================================== */
+
+std::string DeltaCheckpoint::write(const AtomSpacePtr& as,
+                                   const std::string& base)
+{
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (_base.empty())
+            throw RuntimeException(TRACE_INFO,
+                "No base to write a delta against; use `snapshot` or "
+                "`checkpoint` first");
+        if (base != _base)
+            throw RuntimeException(TRACE_INFO,
+                "Changes are being tracked against %s, not %s",
+                _base.c_str(), base.c_str());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // One delta at a time, so that they are in order.
+    std::lock_guard<std::mutex> wlck(_write_mtx);
+
+    // Take the changes; anything from here on goes in the next delta.
+    // Writers are not held up while the file is written.
+    UnorderedHandleSet dirty;
+    UnorderedHandleSet removed;
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        dirty.swap(_dirty);
+        removed.swap(_removed);
+    }
+
+    std::vector<std::string> chain(read_chain(base));
+    size_t seq = 1;
+    if (not chain.empty())
+    {
+        size_t dot = chain.back().find_last_of('.');
+        seq = strtoul(chain.back().c_str() + dot + 1, nullptr, 10) + 1;
+    }
+    std::string path = base + ".delta." + std::to_string(seq);
+    std::string tmp = path + ".tmp";
+
+    size_t natoms = 0;
+    size_t nbytes = 0;
+    try
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (not out.is_open())
+            throw IOException(TRACE_INFO, "Cannot open %s: %s",
+                              tmp.c_str(), strerror(errno));
+
+        for (const Handle& h : removed)
+        {
+            std::string line("(atom-removed " + Sexpr::encode_atom(h) + ")\n");
+            out << line;
+            nbytes += line.size();
+            natoms++;
+        }
+        for (const Handle& h : dirty)
+        {
+            // Removed after it was changed, but before the removal
+            // was heard about.
+            if (nullptr == as->get_atom(h)) continue;
+
+            std::string atom(Sexpr::encode_atom(h));
+            std::string lines("(atom-added " + atom + ")\n");
+            for (const Handle& key : h->getKeys())
+            {
+                ValuePtr v(h->getValue(key));
+                if (nullptr == v) continue;
+                lines += "(value-changed " + atom + " " +
+                    Sexpr::encode_atom(key) + " " +
+                    Sexpr::encode_value(v) + ")\n";
+            }
+            out << lines;
+            nbytes += lines.size();
+            natoms++;
+        }
+        out.flush();
+        if (not out.good())
+            throw IOException(TRACE_INFO, "Cannot write %s", tmp.c_str());
+        out.close();
+
+        AtomSnapshot::commit_file(tmp, path);
+        chain.push_back(path);
+        write_chain(base, chain);
+    }
+    catch (...)
+    {
+        // Keep the changes for the next try.
+        std::lock_guard<std::mutex> lck(_mtx);
+        merge(dirty, removed);
+        unlink(tmp.c_str());
+        throw;
+    }
+
+    std::chrono::duration<double, std::milli> ms =
+        std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lck(_mtx);
+    _base = base;
+    _chain = chain.size();
+    _ndeltas++;
+    _last_atoms = natoms;
+    _last_bytes = nbytes;
+    _last_ms = ms.count();
+
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+             "Wrote %zu changed atoms (%zu bytes) to %s in %.1f ms; "
+             "the chain has %zu deltas\n",
+             natoms, nbytes, path.c_str(), ms.count(), chain.size());
+    logger().info("%s", buf);
+    return buf;
+}
+
+std::string DeltaCheckpoint::restore(const AtomSpacePtr& as,
+                                     const std::string& base,
+                                     ChangeFeed& feed)
+{
+    std::string report;
+    for (const std::string& delta : read_chain(base))
+        report += WriteAheadLog::recover(delta, as, feed);
+    return report;
+}
+
+std::string DeltaCheckpoint::compact(const std::string& base,
+                                     unsigned int nthreads)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // No new deltas while this runs.
+    std::lock_guard<std::mutex> wlck(_write_mtx);
+    std::vector<std::string> chain(read_chain(base));
+    if (chain.empty()) return "No deltas to compact\n";
+
+    // Rebuild in a scratch AtomSpace; its feed has no listeners.
+    AtomSpacePtr scratch(createAtomSpace());
+    ChangeFeed feed;
+    AtomSnapshot::load(scratch, base, nthreads);
+    for (const std::string& delta : chain)
+        WriteAheadLog::recover(delta, scratch, feed);
+    size_t natoms = AtomSnapshot::save(scratch, base);
+
+    for (const std::string& delta : chain)
+        unlink(delta.c_str());
+    write_chain(base, {});
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (base == _base) _chain = 0;
+    }
+
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+             "Merged %zu deltas into %s (%zu atoms) in %.3f seconds\n",
+             chain.size(), base.c_str(), natoms, secs.count());
+    logger().info("%s", buf);
+    return buf;
+}
+
+std::string DeltaCheckpoint::display_stats(void)
+{
+    if (not _tracking) return "";
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "deltas: pending %zu changed %zu removed  chain: %zu  "
+             "written: %zu  last: %zu atoms, %zu bytes, %.1f ms\n",
+             _dirty.size(), _removed.size(), _chain, _ndeltas,
+             _last_atoms, _last_bytes, _last_ms);
+    return buf;
+}
@@ -0,0 +1,118 @@
+/*
+ * opencog/cogserver/checkpoint/DeltaCheckpoint.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_DELTA_CHECKPOINT_H
+#define _OPENCOG_DELTA_CHECKPOINT_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+class ChangeFeed;
+
+/**
+ * Incremental checkpoints: a base snapshot, followed by a chain of
+ * deltas, each holding only the atoms changed since the one before.
+ *
+ * Once a base has been written (with `snapshot` or `checkpoint`) or
+ * loaded, every atom that is added, removed or has a value changed
+ * is remembered, by listening to the ChangeFeed. write() saves the
+ * current state of just those atoms -- the atom, and all of its
+ * values -- to `<base>.delta.<n>`, and starts remembering afresh. The
+ * delta is in the same text form as the change feed and the
+ * write-ahead log, and is written to a temp file, synced and renamed,
+ * so that it is complete or absent, even after a crash.
+ *
+ * The chain is listed, in order, in `<base>.chain`. restore() applies
+ * it after the base has been loaded. compact() merges the base and
+ * the chain into a new base, without touching the live AtomSpace.
+ * Replaying a chain on a base that already includes it gives the same
+ * result, so a crash part-way through compaction loses nothing.
+ */
+class DeltaCheckpoint
+{
+    ChangeFeed& _feed;
+    std::mutex _write_mtx;
+    std::mutex _mtx;
+    std::atomic_bool _tracking;
+    UnorderedHandleSet _dirty;
+    UnorderedHandleSet _removed;
+
+    // Changes that the base being written may not include.
+    UnorderedHandleSet _held_dirty;
+    UnorderedHandleSet _held_removed;
+
+    // Statistics
+    std::string _base;
+    size_t _chain;
+    size_t _ndeltas;
+    size_t _last_atoms;
+    size_t _last_bytes;
+    double _last_ms;
+
+    void mark(int kind, const Handle&);
+    void merge(UnorderedHandleSet& dirty, UnorderedHandleSet& removed);
+    static std::vector<std::string> read_chain(const std::string& base);
+    static void write_chain(const std::string& base,
+                            const std::vector<std::string>&);
+
+public:
+    DeltaCheckpoint(ChangeFeed&);
+    ~DeltaCheckpoint();
+
+    /** Call just before a new base is written. Changes made from now
+     *  on go in the deltas after it. The first call starts listening
+     *  to the feed; until then, this costs nothing. */
+    void begin_base(void);
+
+    /** Call when the base is written. If it failed, the changes set
+     *  aside by begin_base() are put back. If not, the first `n`
+     *  deltas of the old chain, which the new base includes, are
+     *  removed. */
+    void end_base(const std::string& base, bool ok, size_t n = SIZE_MAX);
+
+    /** Start afresh, after `base` and its chain have been loaded. */
+    void reset(const std::string& base);
+
+    /** Write the changes since the last checkpoint as the next delta
+     *  after `base`. Returns a short report. Throws on error; then
+     *  the changes are kept for the next try. */
+    std::string write(const AtomSpacePtr&, const std::string& base);
+
+    /** Apply the chain of deltas after `base` to the AtomSpace. */
+    static std::string restore(const AtomSpacePtr&, const std::string& base,
+                               ChangeFeed&);
+
+    /** Merge `base` and its chain into a new `base`, using up to
+     *  `nthreads` threads to load it. Returns a short report. */
+    std::string compact(const std::string& base, unsigned int nthreads);
+
+    /** Remove the first `n` deltas after `base`, or all of them, when
+     *  the base has been rewritten. */
+    void drop_chain(const std::string& base, size_t n = SIZE_MAX);
+    size_t chain_length(const std::string& base);
+
+    /** One line: changes waiting, chain length, size of the last
+     *  delta. Empty, if nothing is being tracked. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_DELTA_CHECKPOINT_H
@@ -10,6 +10,8 @@
 #include <unistd.h>
 
 #include <opencog/util/ansi.h>
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/cogserver/server/CogServer.h>
 #include <opencog/network/ConsoleSocket.h>
@@ -22,24 +24,6 @@ DECLARE_MODULE(BuiltinRequestsModule)
 
 BuiltinRequestsModule::BuiltinRequestsModule(CogServer& cs) : Module(cs)
 {
-    _cogserver.registerRequest(ShutdownRequest::info().id,     &shutdownFactory);
-    _cogserver.registerRequest(ConfigModuleRequest::info().id, &configmoduleFactory);
-    _cogserver.registerRequest(ListModulesRequest::info().id,  &listmodulesFactory);
-    _cogserver.registerRequest(LoadModuleRequest::info().id,   &loadmoduleFactory);
-    _cogserver.registerRequest(UnloadModuleRequest::info().id, &unloadmoduleFactory);
-
-    do_help_register();
-    do_h_register();
-
-    do_exit_register();
-    do_quit_register();
-    do_q_register();
-    do_ctrld_register();
-    do_iaceof_register();
-    do_dot_register();
-
-    do_stats_register();
-
 }
 
 BuiltinRequestsModule::~BuiltinRequestsModule()
@@ -55,16 +39,49 @@ BuiltinRequestsModule::~BuiltinRequestsModule()
     do_dot_unregister();
 
     do_stats_unregister();
+    do_ingest_unregister();
+    do_follow_unregister();
+    do_hot_unregister();
+#ifdef HAVE_ZSTD
+    do_compress_unregister();
+#endif
 
-    _cogserver.unregisterRequest(ShutdownRequest::info().id);
-    _cogserver.unregisterRequest(ConfigModuleRequest::info().id);
-    _cogserver.unregisterRequest(ListModulesRequest::info().id);
-    _cogserver.unregisterRequest(LoadModuleRequest::info().id);
-    _cogserver.unregisterRequest(UnloadModuleRequest::info().id);
+    _cogserver.unregisterRequest(ShutdownRequest::info().id,     &shutdownFactory);
+    _cogserver.unregisterRequest(ConfigModuleRequest::info().id, &configmoduleFactory);
+    _cogserver.unregisterRequest(ListModulesRequest::info().id,  &listmodulesFactory);
+    _cogserver.unregisterRequest(LoadModuleRequest::info().id,   &loadmoduleFactory);
+    _cogserver.unregisterRequest(UnloadModuleRequest::info().id, &unloadmoduleFactory);
+    _cogserver.unregisterRequest(ReloadModuleRequest::info().id, &reloadmoduleFactory);
 }
 
+// Requests are registered in init(), and not in the constructor,
+// because module constructors may run concurrently during startup.
 void BuiltinRequestsModule::init()
 {
+    _cogserver.registerRequest(ShutdownRequest::info().id,     &shutdownFactory);
+    _cogserver.registerRequest(ConfigModuleRequest::info().id, &configmoduleFactory);
+    _cogserver.registerRequest(ListModulesRequest::info().id,  &listmodulesFactory);
+    _cogserver.registerRequest(LoadModuleRequest::info().id,   &loadmoduleFactory);
+    _cogserver.registerRequest(UnloadModuleRequest::info().id, &unloadmoduleFactory);
+    _cogserver.registerRequest(ReloadModuleRequest::info().id, &reloadmoduleFactory);
+
+    do_help_register();
+    do_h_register();
+
+    do_exit_register();
+    do_quit_register();
+    do_q_register();
+    do_ctrld_register();
+    do_iaceof_register();
+    do_dot_register();
+
+    do_stats_register();
+    do_ingest_register();
+    do_follow_register();
+    do_hot_register();
+#ifdef HAVE_ZSTD
+    do_compress_register();
+#endif
 }
 
 // ====================================================================
@@ -165,3 +182,75 @@ std::string BuiltinRequestsModule::do_stats(Request *req, std::list<std::string>
 }
 
 // ====================================================================
+// Bulk-load Atomese from a file.
+std::string BuiltinRequestsModule::do_ingest(Request *req, std::list<std::string> args)
+{
+    if (args.empty())
+        return "invalid syntax: ingest <filename>\n";
+
+    CogServer& cs = _cogserver;
+    std::string path(args.front());
+    req->run_detached("Ingest failed: ",
+                      [&cs, path]() { return cs.ingest(path); });
+    return "";
+}
+
+std::string BuiltinRequestsModule::do_follow(Request *req, std::list<std::string> args)
+{
+    if (args.empty())
+        return "invalid syntax: follow <host>[:<port>] | follow stop\n";
+
+    if (args.front() == "stop")
+        return _cogserver.follow("");
+
+    try {
+        return _cogserver.follow(args.front());
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Follow failed: ") + ex.what() + "\n";
+    }
+}
+
+// ====================================================================
+// Compress the connection.
+std::string BuiltinRequestsModule::do_compress(Request *req, std::list<std::string> args)
+{
+    if (args.empty() or args.front() != "zstd" or 2 < args.size())
+        return "invalid syntax: compress zstd [<level>]\n";
+
+    int level = opencog::config().get_int("ZSTD_LEVEL", 3);
+    if (2 == args.size())
+        level = atoi(args.back().c_str());
+
+    ConsoleSocket* con = req->get_console();
+    OC_ASSERT(con, "Bad request state");
+    try {
+        con->compress(level, "compress zstd " + std::to_string(level) + "\n");
+    }
+    catch (const RuntimeException& ex) {
+        return std::string("Compress failed: ") + ex.what() + "\n";
+    }
+    return "";
+}
+
+// ====================================================================
+// Most used atoms and keys.
+std::string BuiltinRequestsModule::do_hot(Request *req, std::list<std::string> args)
+{
+    AccessSampler& hot = _cogserver.accessSampler();
+    if (args.empty())
+        return hot.display(20);
+
+    if (args.front() == "reset")
+    {
+        hot.reset();
+        return "";
+    }
+
+    int k = atoi(args.front().c_str());
+    if (k <= 0)
+        return "invalid syntax: hot [<count>] | hot reset\n";
+    return hot.display(k);
+}
+
+// ====================================================================
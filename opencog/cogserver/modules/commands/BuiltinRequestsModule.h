@@ -30,6 +30,7 @@ private:
     Factory<ListModulesRequest, Request>  listmodulesFactory;
     Factory<LoadModuleRequest, Request>   loadmoduleFactory;
     Factory<UnloadModuleRequest, Request> unloadmoduleFactory;
+    Factory<ReloadModuleRequest, Request> reloadmoduleFactory;
 
     Factory<ShutdownRequest, Request>     shutdownFactory;
 
@@ -90,6 +91,59 @@ DECLARE_CMD_REQUEST(BuiltinRequestsModule, "stats", do_stats,
        "Usage: stats\n\n" + CogServer::stats_legend(),
        false, false)
 
+DECLARE_CMD_REQUEST(BuiltinRequestsModule, "ingest", do_ingest,
+       "Bulk-load a file of Atomese into the AtomSpace.",
+       "Usage: ingest <filename>\n\n"
+       "Load a large file of Atomese s-expressions, such as a dump of an\n"
+       "AtomSpace, parsing it in parallel. Each top-level expression in\n"
+       "the file must be an Atom, or a one-line `cog-set-value!` of an\n"
+       "Atom; anything else is skipped and counted as an error. The file\n"
+       "is read on the server, not the client; a named pipe may be used\n"
+       "to stream data in. The rest of the server carries on meanwhile.\n"
+       "Progress is written to the log, and a report is sent when done.\n"
+       "The number of parser threads is set by INGEST_THREADS.\n",
+       false, false)
+
+DECLARE_CMD_REQUEST(BuiltinRequestsModule, "follow", do_follow,
+       "Replicate the AtomSpace of another CogServer.",
+       "Usage: follow <host>[:<port>] | follow stop\n\n"
+       "Make this server a read-only replica of the leader at the given\n"
+       "host and console port (17001 by default). The leader's AtomSpace\n"
+       "is copied here, replacing the current contents, and from then on\n"
+       "every change made on the leader is applied here as well. If the\n"
+       "connection is lost, it is re-established, and only the changes\n"
+       "that were missed are sent. `follow stop` stops following; the\n"
+       "AtomSpace is left as it is. The replication lag is shown by\n"
+       "`stats`. A follower can also be started with REPLICATE_FROM in\n"
+       "the config file.\n",
+       false, false)
+
+// This is a "shell" command only so that it runs before the next
+// line is read from the socket; that line is already compressed.
+DECLARE_CMD_REQUEST(BuiltinRequestsModule, "compress", do_compress,
+       "Compress this connection.",
+       "Usage: compress zstd [<level>]\n\n"
+       "Compress everything sent on this connection, in both directions,\n"
+       "as one zstd stream each way. The reply, `compress zstd <level>`,\n"
+       "is the last thing sent uncompressed. Everything the client sends\n"
+       "after the `compress` line must be compressed. The server flushes\n"
+       "its stream after each reply, so that it can be decompressed at\n"
+       "once. The level defaults to ZSTD_LEVEL. Bytes before and after\n"
+       "compression are shown by `stats`. Not available over WebSockets.\n",
+       true, false)
+
+DECLARE_CMD_REQUEST(BuiltinRequestsModule, "hot", do_hot,
+       "Show the atoms and keys used the most.",
+       "Usage: hot [<count>] | hot reset\n\n"
+       "Show the atoms, and the value keys, that sexpr shell commands\n"
+       "used the most, 20 of each unless a count is given. Commands are\n"
+       "sampled, one in HOT_SAMPLE_EVERY, and counted in a fixed-size\n"
+       "sketch; the counts shown are estimates of the number of uses,\n"
+       "where a use HOT_HALF_LIFE seconds ago counts half. This is meant\n"
+       "for sizing caches and picking shard keys and prefetch sets.\n"
+       "`hot reset` forgets all counts.\n",
+       false, false)
+
 public:
     static const char* id();
     BuiltinRequestsModule(CogServer&);
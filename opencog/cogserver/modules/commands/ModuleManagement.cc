@@ -69,7 +69,8 @@ ListModulesRequest::info(void)
         "list",
         "List the currently loaded cogserver modules",
         "Usage: list\n\n"
-        "List modules currently loaded into the cogserver.\n"
+        "List modules currently loaded into the cogserver, together\n"
+        "with the time, in milliseconds, that each took to load.\n"
     );
     return _cci;
 }
@@ -157,3 +158,42 @@ bool UnloadModuleRequest::execute()
 }
 
 // ====================================================================
+
+const RequestClassInfo&
+ReloadModuleRequest::info(void)
+{
+    static const RequestClassInfo _cci(
+        "reload",
+        "Reload an opencog module",
+        "Usage: reload <module>\n\n"
+        "Load a fresh copy of the indicated module, and switch over to it.\n"
+        "Commands issued after this use the new version; commands already\n"
+        "in progress, and open shells, finish on the old one. The old copy\n"
+        "is unloaded once it is no longer in use. The module can be given\n"
+        "either as the shared-lib filename, or as the module id.\n"
+    );
+    return _cci;
+}
+
+bool ReloadModuleRequest::execute()
+{
+    logger().debug("[ReloadModuleRequest] execute");
+    std::ostringstream oss;
+    if (_parameters.empty()) {
+        oss << "invalid syntax: reload <filename> | <module id>" << std::endl;
+        send(oss.str());
+        return false;
+    }
+    std::string& filename = _parameters.front();
+    if (_cogserver.reloadModule(filename)) {
+        oss << "done" << std::endl;
+        send(oss.str());
+        return true;
+    }
+    oss << "Unable to reload module \"" << filename
+        << "\". Check the server logs for details." << std::endl;
+    send(oss.str());
+    return false;
+}
+
+// ====================================================================
@@ -32,6 +32,7 @@ DEFINE_REQUEST(ConfigModuleRequest)
 DEFINE_REQUEST(ListModulesRequest)
 DEFINE_REQUEST(LoadModuleRequest)
 DEFINE_REQUEST(UnloadModuleRequest)
+DEFINE_REQUEST(ReloadModuleRequest)
 };
 
 #endif /* _COGSERVER_MODULE_MANAGEMENT_H */
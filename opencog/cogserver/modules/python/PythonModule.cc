@@ -24,6 +24,9 @@ using namespace opencog;
 
 DECLARE_MODULE(PythonModule);
 
+// Start Python after the shells that start Python and Guile.
+DECLARE_MODULE_DEPENDS("SchemeShellModule, PythonShellModule");
+
 Request* PythonRequestFactory::create(CogServer& cs) const
 {
     PyGILState_STATE gstate;
@@ -64,9 +67,9 @@ PythonModule::~PythonModule()
 bool PythonModule::unregisterRequests()
 {
     // Requires GIL
-    for (std::string s : _requestNames) {
-        DPRINTF("Unregistering requests of id %s\n", s.c_str());
-        _cogserver.unregisterRequest(s);
+    for (size_t i = 0; i < _requestNames.size(); i++) {
+        DPRINTF("Unregistering requests of id %s\n", _requestNames[i].c_str());
+        _cogserver.unregisterRequest(_requestNames[i], _requestFactories[i]);
     }
 
     return true;
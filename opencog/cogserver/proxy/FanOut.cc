@@ -0,0 +1,141 @@
+/*
+ * opencog/cogserver/proxy/FanOut.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <sys/prctl.h>
+
+#include "FanOut.h"
+
+using namespace opencog;
+
+FanOut::FanOut(size_t nthreads, const std::string& name) :
+    _name(name),
+    _stop(false),
+    _nbatches(0),
+    _njobs(0),
+    _nfailed(0),
+    _ntimeouts(0)
+{
+    if (0 == nthreads) nthreads = 1;
+    for (size_t i = 0; i < nthreads; i++)
+        _workers.push_back(std::thread(&FanOut::work, this));
+}
+
+FanOut::~FanOut()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _stop = true;
+        _cv.notify_all();
+    }
+    for (std::thread& w : _workers) w.join();
+}
+
+void FanOut::work(void)
+{
+    // Thread names are limited to 15 chars.
+    prctl(PR_SET_NAME, _name.substr(0, 15).c_str(), 0, 0, 0);
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    while (true)
+    {
+        while (_queue.empty() and not _stop) _cv.wait(lck);
+        if (_queue.empty()) return;
+
+        BatchPtr batch(_queue.front().first);
+        Job job(std::move(_queue.front().second));
+        _queue.pop_front();
+        lck.unlock();
+
+        bool skip;
+        {
+            std::lock_guard<std::mutex> blck(batch->mtx);
+            skip = batch->abandoned;
+        }
+
+        std::string error;
+        bool failed = false;
+        if (not skip)
+        {
+            try { job(); }
+            catch (const std::exception& ex)
+            {
+                failed = true;
+                error = ex.what();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> blck(batch->mtx);
+            if (not batch->abandoned)
+            {
+                if (failed)
+                {
+                    batch->result.failed++;
+                    if (batch->result.error.empty())
+                        batch->result.error = error;
+                }
+                else batch->result.ok++;
+            }
+            if (0 == --batch->remaining) batch->cv.notify_all();
+        }
+
+        lck.lock();
+        if (failed) _nfailed++;
+    }
+}
+
+FanOut::Result FanOut::run(std::vector<Job>& jobs,
+                           std::chrono::milliseconds timeout)
+{
+    BatchPtr batch(std::make_shared<Batch>());
+    batch->remaining = jobs.size();
+    batch->abandoned = false;
+    batch->result = Result();
+    if (jobs.empty()) return batch->result;
+
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        for (Job& job : jobs)
+            _queue.emplace_back(batch, std::move(job));
+        _nbatches++;
+        _njobs += jobs.size();
+        _cv.notify_all();
+    }
+    jobs.clear();
+
+    std::unique_lock<std::mutex> blck(batch->mtx);
+    if (0 == timeout.count())
+    {
+        while (0 < batch->remaining) batch->cv.wait(blck);
+        return batch->result;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (0 < batch->remaining and
+           std::cv_status::timeout != batch->cv.wait_until(blck, deadline))
+        ;
+    if (0 < batch->remaining)
+    {
+        batch->abandoned = true;
+        batch->result.timed_out = batch->remaining;
+        std::lock_guard<std::mutex> lck(_mtx);
+        _ntimeouts += batch->remaining;
+    }
+    return batch->result;
+}
+
+std::string FanOut::stats(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    char buff[256];
+    snprintf(buff, sizeof(buff),
+        "fan-out threads: %zu  batches: %zu  calls: %zu  queued: %zu  "
+        "failed: %zu  timed out: %zu\n",
+        _workers.size(), _nbatches, _njobs, _queue.size(), _nfailed,
+        _ntimeouts);
+    return buff;
+}
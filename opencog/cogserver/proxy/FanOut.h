@@ -0,0 +1,97 @@
+/*
+ * opencog/cogserver/proxy/FanOut.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_FAN_OUT_H
+#define _OPENCOG_FAN_OUT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Run a set of calls to storage in parallel, and wait for all of them.
+ *
+ * The proxies talk to several StorageNodes; done one after another,
+ * the latency of a read is the sum of the latencies of all of the
+ * targets. A FanOut hands each call to a fixed pool of threads, so
+ * that no more than that many are in flight at once, and waits until
+ * all have finished, or until the timeout has passed.
+ *
+ * A call that is still running at the timeout cannot be interrupted;
+ * it is left to finish in the background, and its result is not
+ * waited for. Calls that have not yet started when the timeout passes
+ * are skipped. Exceptions thrown by calls are caught and counted.
+ */
+class FanOut
+{
+public:
+    typedef std::function<void(void)> Job;
+
+    struct Result
+    {
+        size_t ok;
+        size_t failed;
+        size_t timed_out;
+        std::string error;  // The first failure, if any.
+    };
+
+private:
+    struct Batch
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        size_t remaining;
+        bool abandoned;
+        Result result;
+    };
+    typedef std::shared_ptr<Batch> BatchPtr;
+
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::deque<std::pair<BatchPtr, Job>> _queue;
+    std::vector<std::thread> _workers;
+    std::string _name;
+    bool _stop;
+
+    size_t _nbatches;
+    size_t _njobs;
+    size_t _nfailed;
+    size_t _ntimeouts;
+
+    void work(void);
+
+public:
+    /** Start `nthreads` workers; `name` names them, in `top`. */
+    FanOut(size_t nthreads, const std::string& name);
+    ~FanOut();
+
+    /** Run all of the jobs, and wait for them to finish. A zero
+     *  timeout waits for as long as it takes. */
+    Result run(std::vector<Job>&, std::chrono::milliseconds timeout);
+
+    size_t size(void) const { return _workers.size(); }
+
+    /** One line: threads, batches and jobs run, failures, timeouts. */
+    std::string stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_FAN_OUT_H
@@ -0,0 +1,543 @@
+/*
+ * opencog/cogserver/proxy/ReadThruProxy.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+
+#include "ReadThruProxy.h"
+
+using namespace opencog;
+
+DECLARE_MODULE(ReadThruProxy);
+
+// Number of bits set for each entry in the Bloom filter. Four is
+// close to optimal when the filter is about ten bits per entry.
+#define BLOOM_HASHES 4
+
+static uint64_t mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+void ReadThruProxy::Missing::resize(size_t nbits,
+                                    std::chrono::milliseconds ttl)
+{
+    _nbits = (nbits + 63) & ~((size_t) 63);
+    if (0 == _nbits) _nbits = 64;
+    _bits[0].assign(_nbits / 64, 0);
+    _bits[1].assign(_nbits / 64, 0);
+    _cur = 0;
+    _half_life = ttl / 2;
+    _rotated = std::chrono::steady_clock::now();
+    ninserts = 0;
+}
+
+void ReadThruProxy::Missing::clear(void)
+{
+    resize(_nbits, 2 * _half_life);
+}
+
+void ReadThruProxy::Missing::insert(uint64_t h)
+{
+    uint64_t h1 = mix(h);
+    uint64_t h2 = mix(h1) | 1;
+    std::vector<uint64_t>& bits = _bits[_cur];
+    for (int i = 0; i < BLOOM_HASHES; i++)
+    {
+        size_t b = (h1 + i * h2) % _nbits;
+        bits[b / 64] |= 1ULL << (b % 64);
+    }
+    ninserts++;
+}
+
+bool ReadThruProxy::Missing::contains(uint64_t h)
+{
+    // Age out the older half.
+    time_point now = std::chrono::steady_clock::now();
+    if (_half_life <= now - _rotated)
+    {
+        _cur = 1 - _cur;
+        std::fill(_bits[_cur].begin(), _bits[_cur].end(), 0);
+        _rotated = now;
+    }
+
+    uint64_t h1 = mix(h);
+    uint64_t h2 = mix(h1) | 1;
+    for (const std::vector<uint64_t>& bits : _bits)
+    {
+        int i = 0;
+        for (; i < BLOOM_HASHES; i++)
+        {
+            size_t b = (h1 + i * h2) % _nbits;
+            if (0 == (bits[b / 64] & (1ULL << (b % 64)))) break;
+        }
+        if (BLOOM_HASHES == i) return true;
+    }
+    return false;
+}
+
+/* ============================================================== */
+
+ReadThruProxy::ReadThruProxy(CogServer& cs) :
+    Module(cs),
+    _counts(),
+    _nevicted(0),
+    _fanout(opencog::config().get_int("PROXY_FANOUT_THREADS", 8),
+            "cogserv:rt-out")
+{
+    _timeout = std::chrono::milliseconds(
+        opencog::config().get_int("PROXY_TIMEOUT_MS", 10000));
+    _ttl[ATOM] = std::chrono::milliseconds(
+        opencog::config().get_int("RTHRU_TTL_ATOM_MS", 60000));
+    _ttl[INCOMING] = std::chrono::milliseconds(
+        opencog::config().get_int("RTHRU_TTL_INCOMING_MS", 10000));
+    _ttl[VALUE] = std::chrono::milliseconds(
+        opencog::config().get_int("RTHRU_TTL_VALUE_MS", 5000));
+    _ttl[TYPE] = std::chrono::milliseconds(
+        opencog::config().get_int("RTHRU_TTL_TYPE_MS", 60000));
+    _max_entries = opencog::config().get_int("RTHRU_CACHE_MAX", 1000000);
+
+    _ttl_missing = std::chrono::milliseconds(
+        opencog::config().get_int("RTHRU_TTL_MISSING_MS", 5000));
+    _missing.resize(opencog::config().get_int("RTHRU_BLOOM_BITS", 1 << 23),
+                    _ttl_missing);
+}
+
+void ReadThruProxy::init(void)
+{
+    find_targets();
+
+    // Forget atoms that are removed, so that they are fetched again,
+    // if asked for.
+    _cogserver.changeFeed().add_listener("r-thru",
+        [this](ChangeFeed::Kind kind, const Handle& h,
+               const Handle&, const ValuePtr&)
+        {
+            if (ChangeFeed::ATOM_REMOVED != kind) return;
+            std::lock_guard<std::mutex> lck(_mtx);
+            forget(h);
+        });
+
+    _cogserver.readThrough().set(this);
+
+    do_rthru_register();
+}
+
+ReadThruProxy::~ReadThruProxy()
+{
+    do_rthru_unregister();
+    _cogserver.readThrough().set(nullptr);
+    _cogserver.changeFeed().remove_listener("r-thru");
+}
+
+void ReadThruProxy::find_targets(void)
+{
+    HandleSeq hs;
+    _cogserver.getAtomSpace()->get_handles_by_type(hs, STORAGE_NODE, true);
+
+    std::vector<StorageNodePtr> targets;
+    for (const Handle& h : hs)
+    {
+        StorageNodePtr snp(StorageNodeCast(h));
+        if (snp and snp->connected()) targets.push_back(snp);
+    }
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    _targets.swap(targets);
+    logger().info("[ReadThruProxy] reading from %zu StorageNodes",
+                  _targets.size());
+}
+
+/* ============================================================== */
+
+/// Must be called with _mtx held. Counts the lookup, and the hit.
+bool ReadThruProxy::is_fresh(const Key& key, Kind kind)
+{
+    _counts[kind].lookups++;
+    auto it = _fresh.find(key);
+    if (it == _fresh.end()) return false;
+    if (it->second < std::chrono::steady_clock::now())
+    {
+        _fresh.erase(it);
+        return false;
+    }
+    _counts[kind].hits++;
+    return true;
+}
+
+void ReadThruProxy::set_fresh(const Key& key, Kind kind)
+{
+    if (0 == _ttl[kind].count()) return;
+    time_point now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (_max_entries <= _fresh.size())
+    {
+        for (auto it = _fresh.begin(); it != _fresh.end(); )
+        {
+            if (it->second < now) it = _fresh.erase(it);
+            else it++;
+        }
+        // Everything is still fresh; drop the tenth that would go
+        // stale soonest.
+        if (not _fresh.empty() and _max_entries <= _fresh.size())
+        {
+            std::vector<time_point> when;
+            when.reserve(_fresh.size());
+            for (const auto& it : _fresh) when.push_back(it.second);
+            size_t n = when.size() / 10;
+            std::nth_element(when.begin(), when.begin() + n, when.end());
+            time_point cut = when[n];
+            for (auto it = _fresh.begin(); it != _fresh.end(); )
+            {
+                if (it->second <= cut)
+                {
+                    it = _fresh.erase(it);
+                    _nevicted++;
+                }
+                else it++;
+            }
+        }
+    }
+    _fresh[key] = now + _ttl[kind];
+}
+
+/// Must be called with _mtx held. `h` is the hash that was put in
+/// the Bloom filter; `atom` is the atom it is about.
+bool ReadThruProxy::is_missing(uint64_t h, const Handle& atom, Kind kind)
+{
+    if (not _unmissing.empty())
+    {
+        auto it = _unmissing.find(atom->get_hash());
+        if (_unmissing.end() != it)
+        {
+            if (std::chrono::steady_clock::now() < it->second) return false;
+            _unmissing.erase(it);
+        }
+    }
+    if (not _missing.contains(h)) return false;
+    _counts[kind].missing++;
+    return true;
+}
+
+/// Must be called with _mtx held.
+void ReadThruProxy::forget(const Handle& h)
+{
+    ContentHash ch = h->get_hash();
+    auto it = _fresh.lower_bound(Key(ch, 0, 0));
+    while (it != _fresh.end() and std::get<0>(it->first) == ch)
+        it = _fresh.erase(it);
+}
+
+void ReadThruProxy::invalidate(const Handle& h)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (nullptr == h)
+    {
+        _fresh.clear();
+        _missing.clear();
+        _unmissing.clear();
+        return;
+    }
+    forget(h);
+
+    // Anything the filter holds about the atom now is gone from it
+    // by the time this runs out.
+    time_point now = std::chrono::steady_clock::now();
+    for (auto it = _unmissing.begin(); it != _unmissing.end(); )
+    {
+        if (it->second <= now) it = _unmissing.erase(it);
+        else it++;
+    }
+    _unmissing[h->get_hash()] = now + _ttl_missing;
+}
+
+std::vector<StorageNodePtr> ReadThruProxy::targets(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _targets;
+}
+
+/// Run the fetches in parallel. Returns true if all of them finished
+/// without error; if not, the read should not be remembered.
+bool ReadThruProxy::fan_out(std::vector<FanOut::Job>& jobs, Kind kind)
+{
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _counts[kind].fetches += jobs.size();
+    }
+
+    FanOut::Result res = _fanout.run(jobs, _timeout);
+    if (0 == res.failed and 0 == res.timed_out) return true;
+
+    logger().warn("[ReadThruProxy] %zu fetches failed, %zu timed out%s%s",
+                  res.failed, res.timed_out,
+                  res.error.empty() ? "" : ": ", res.error.c_str());
+    return false;
+}
+
+/// Hash of a value's atom and key, for the missing-values filter.
+static uint64_t value_hash(const Handle& h, const Handle& key)
+{
+    return mix(h->get_hash()) ^ key->get_hash();
+}
+
+/// Copy an atom that was fetched into the scratch space into the
+/// served one, with its values, and publish it. Returns the atom, or
+/// null, if it is in neither space.
+Handle ReadThruProxy::keep(const AtomSpacePtr& scratch, const Handle& h)
+{
+    Handle got(scratch->get_atom(h));
+    if (nullptr == got or got->getAtomSpace() != scratch.get())
+        return got;
+
+    const AtomSpacePtr& as = _cogserver.getAtomSpace();
+    ChangeFeed& feed = _cogserver.changeFeed();
+    bool is_new = (nullptr == as->get_atom(got));
+    Handle kept(as->add_atom(got));
+    if (is_new) feed.atom_added(kept);
+    for (const Handle& key : got->getKeys())
+    {
+        ValuePtr v(got->getValue(key));
+        Handle k(as->add_atom(key));
+        as->set_value(kept, k, v);
+        feed.value_changed(kept, k, v);
+    }
+    return kept;
+}
+
+// Each fetch goes into a scratch space of its own, that the jobs hold
+// on to, so that one that is given up on cannot touch anything else.
+
+void ReadThruProxy::fetch_atom(const Handle& h)
+{
+    Key key(h->get_hash(), ATOM, 0);
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (is_fresh(key, ATOM)) return;
+        if (is_missing(h->get_hash(), h, ATOM)) return;
+    }
+
+    // Get the atom from all targets. They run in parallel, so if
+    // they disagree about a value, any one of them may win.
+    AtomSpacePtr scratch(createAtomSpace(_cogserver.getAtomSpace()));
+    std::vector<FanOut::Job> jobs;
+    for (const StorageNodePtr& snp : targets())
+        jobs.push_back([snp, h, scratch]() {
+            snp->fetch_atom(h, scratch.get());
+            snp->barrier(scratch.get());
+        });
+    if (not fan_out(jobs, ATOM)) return;
+
+    if (nullptr == keep(scratch, h))
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _missing.insert(h->get_hash());
+        return;
+    }
+    set_fresh(key, ATOM);
+}
+
+void ReadThruProxy::fetch_value(const Handle& atom, const Handle& vkey)
+{
+    uint64_t vh = value_hash(atom, vkey);
+    Key key(atom->get_hash(), VALUE, vkey->get_hash());
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (is_fresh(key, VALUE)) return;
+        if (is_missing(vh, atom, VALUE)) return;
+    }
+
+    const AtomSpacePtr& as = _cogserver.getAtomSpace();
+    AtomSpacePtr scratch(createAtomSpace(as));
+    std::vector<FanOut::Job> jobs;
+    for (const StorageNodePtr& snp : targets())
+        jobs.push_back([snp, atom, vkey, scratch]() {
+            snp->fetch_value(atom, vkey, scratch.get());
+            snp->barrier(scratch.get());
+        });
+    if (not fan_out(jobs, VALUE)) return;
+
+    Handle got(scratch->get_atom(atom));
+    Handle gkey(scratch->get_atom(vkey));
+    ValuePtr v;
+    if (got and gkey) v = got->getValue(gkey);
+    if (nullptr == v)
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _missing.insert(vh);
+        return;
+    }
+
+    // Only the value asked for; a fetched atom may carry others.
+    if (got->getAtomSpace() == scratch.get())
+    {
+        ChangeFeed& feed = _cogserver.changeFeed();
+        bool is_new = (nullptr == as->get_atom(got));
+        Handle h(as->add_atom(got));
+        if (is_new) feed.atom_added(h);
+        Handle k(as->add_atom(gkey));
+        as->set_value(h, k, v);
+        feed.value_changed(h, k, v);
+    }
+    set_fresh(key, VALUE);
+}
+
+void ReadThruProxy::fetch_incoming(const Handle& atom, Type t)
+{
+    Key key(atom->get_hash(), INCOMING, t);
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (is_fresh(key, INCOMING)) return;
+        if (is_missing(atom->get_hash(), atom, INCOMING)) return;
+    }
+
+    AtomSpacePtr scratch(createAtomSpace(_cogserver.getAtomSpace()));
+    std::vector<FanOut::Job> jobs;
+    for (const StorageNodePtr& snp : targets())
+        jobs.push_back([snp, atom, t, scratch]() {
+            if (NOTYPE == t)
+                snp->fetch_incoming_set(atom, false, scratch.get());
+            else
+                snp->fetch_incoming_by_type(atom, t, scratch.get());
+            snp->barrier(scratch.get());
+        });
+    if (not fan_out(jobs, INCOMING)) return;
+
+    Handle got(scratch->get_atom(atom));
+    if (got)
+    {
+        for (const Handle& l : got->getIncomingSet(scratch.get()))
+            if (NOTYPE == t or l->get_type() == t)
+                keep(scratch, l);
+    }
+    set_fresh(key, INCOMING);
+}
+
+void ReadThruProxy::fetch_type(Type type, bool subtypes)
+{
+    Key key(0, TYPE, 2 * type + subtypes);
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        if (is_fresh(key, TYPE)) return;
+    }
+
+    std::vector<Type> types({type});
+    if (subtypes)
+    {
+        for (Type t = type+1; t < nameserver().getNumberOfClasses(); t++)
+        {
+            if (nameserver().isA(t, type))
+                types.push_back(t);
+        }
+    }
+
+    // One fetch for each type from each target, all at once; then
+    // wait for each target to finish.
+    AtomSpacePtr scratch(createAtomSpace(_cogserver.getAtomSpace()));
+    std::vector<StorageNodePtr> tgts(targets());
+    std::vector<FanOut::Job> jobs;
+    for (const StorageNodePtr& snp : tgts)
+        for (Type t : types)
+            jobs.push_back([snp, t, scratch]() {
+                snp->fetch_all_atoms_of_type(t, scratch.get()); });
+    if (not fan_out(jobs, TYPE)) return;
+
+    for (const StorageNodePtr& snp : tgts)
+        jobs.push_back([snp, scratch]() { snp->barrier(scratch.get()); });
+    if (not fan_out(jobs, TYPE)) return;
+
+    HandleSeq hs;
+    scratch->get_handles_by_type(hs, type, subtypes);
+    for (const Handle& h : hs)
+        keep(scratch, h);
+    set_fresh(key, TYPE);
+}
+
+/* ============================================================== */
+
+std::string ReadThruProxy::stats(void)
+{
+    static const char* names[NKINDS] =
+        { "atoms", "incoming", "values", "types" };
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    std::string rc;
+    char buff[256];
+    snprintf(buff, sizeof(buff),
+        "targets: %zu  cached: %zu (max %zu)  evicted: %zu  "
+        "missing inserts: %zu\n",
+        _targets.size(), _fresh.size(), _max_entries, _nevicted,
+        _missing.ninserts);
+    rc += buff;
+
+    size_t nfetch = 0;
+    for (int k = 0; k < NKINDS; k++)
+    {
+        const Counts& c = _counts[k];
+        double rate = c.lookups ?
+            100.0 * (c.hits + c.missing) / c.lookups : 0.0;
+        snprintf(buff, sizeof(buff),
+            "%-9s ttl: %6ldms  reads: %zu  hits: %zu  known missing: %zu"
+            "  hit rate: %.1f%%  fetches: %zu\n",
+            names[k], (long) _ttl[k].count(), c.lookups, c.hits,
+            c.missing, rate, c.fetches);
+        rc += buff;
+        nfetch += c.fetches;
+    }
+    snprintf(buff, sizeof(buff), "total fetches from storage: %zu\n",
+             nfetch);
+    rc += buff;
+    rc += _fanout.stats();
+    return rc;
+}
+
+std::string ReadThruProxy::do_rthru(Request* req,
+                                    std::list<std::string> args)
+{
+    if (args.empty()) return stats();
+
+    if (args.front() == "invalidate")
+    {
+        args.pop_front();
+        if (args.empty())
+        {
+            invalidate(Handle::UNDEFINED);
+            return "Forgot everything\n";
+        }
+
+        std::string atom;
+        for (const std::string& a : args)
+            atom += (atom.empty() ? "" : " ") + a;
+        invalidate(Sexpr::decode_atom(atom));
+        return "Forgot " + atom + "\n";
+    }
+
+    if (args.front() == "targets")
+    {
+        find_targets();
+        std::string rc;
+        std::lock_guard<std::mutex> lck(_mtx);
+        for (const StorageNodePtr& snp : _targets)
+            rc += snp->to_short_string() + "\n";
+        if (0 == rc.size()) rc = "No open StorageNodes\n";
+        return rc;
+    }
+
+    return "invalid syntax: r-thru [invalidate [<atom>] | targets]\n";
+}
@@ -0,0 +1,176 @@
+/*
+ * opencog/cogserver/proxy/ReadThruProxy.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_READ_THRU_PROXY_H
+#define _OPENCOG_READ_THRU_PROXY_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/persist/api/StorageNode.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/ReadThrough.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/cogserver/proxy/FanOut.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Fetch atoms from StorageNodes when sexpr shell clients read them,
+ * remembering what was fetched.
+ *
+ * The old read-thru proxy (see the attic) went to every target on
+ * every read, even when the same atom had been fetched a moment
+ * before, or had just been found not to exist. Instead, this module
+ * remembers, for each read, when it was last fetched, and does not
+ * fetch it again until its time-to-live has run out. There are
+ * separate TTLs for atoms, incoming sets, values and whole types,
+ * since they go stale at different rates.
+ *
+ * Fetches go into a scratch AtomSpace, layered over the served one.
+ * Only what the targets actually had is copied into the served
+ * AtomSpace, and published on the ChangeFeed; a read of something
+ * that does not exist leaves no trace, and neither does a fetch that
+ * is still running when it is given up on.
+ *
+ * Atoms and values that the targets do not have are remembered in a
+ * Bloom filter, so that clients probing for things that do not exist
+ * do not cost a round trip each time. The filter has two halves; the
+ * older one is emptied every half of RTHRU_TTL_MISSING_MS, so that
+ * nothing is taken to be missing for longer than that. A Bloom filter
+ * can return false positives: RTHRU_BLOOM_BITS should be some ten
+ * times the number of distinct misses expected within the TTL.
+ *
+ * When RTHRU_CACHE_MAX reads are remembered, the tenth that would go
+ * stale soonest are dropped.
+ *
+ * An atom that is removed from the AtomSpace is forgotten, so that it
+ * is fetched again if asked for. `r-thru invalidate` forgets about
+ * one atom, or everything. A Bloom filter cannot drop one entry, so
+ * an atom that is forgotten is, instead, never taken to be missing
+ * until RTHRU_TTL_MISSING_MS has passed; until then, each read of it
+ * goes to the targets.
+ *
+ * Each read goes to all of the targets at once, and, for a read of all
+ * atoms of a type and its subtypes, to each type at once, with no more
+ * than PROXY_FANOUT_THREADS fetches in flight. A read that takes longer
+ * than PROXY_TIMEOUT_MS is given up on, and not remembered.
+ *
+ * The targets are the StorageNodes that are open when the module is
+ * loaded. Open them first, or use `r-thru targets` afterwards.
+ */
+class ReadThruProxy : public Module, public ReadThrough
+{
+private:
+    enum Kind { ATOM, INCOMING, VALUE, TYPE, NKINDS };
+    typedef std::chrono::steady_clock::time_point time_point;
+
+    /// Two-generation Bloom filter of content hashes.
+    class Missing
+    {
+        std::vector<uint64_t> _bits[2];
+        size_t _nbits;
+        int _cur;
+        time_point _rotated;
+        std::chrono::milliseconds _half_life;
+    public:
+        size_t ninserts;
+        void resize(size_t nbits, std::chrono::milliseconds ttl);
+        void insert(uint64_t);
+        bool contains(uint64_t);
+        void clear(void);
+    };
+
+    struct Counts
+    {
+        size_t lookups;
+        size_t hits;
+        size_t missing;
+        size_t fetches;
+    };
+
+    std::mutex _mtx;
+
+    // (atom hash, kind, detail) -> when the fetch goes stale. The atom
+    // comes first, so that everything about one atom is together.
+    typedef std::tuple<ContentHash, int, uint64_t> Key;
+    std::map<Key, time_point> _fresh;
+    Missing _missing;
+    std::chrono::milliseconds _ttl_missing;
+
+    // Atoms that were invalidated, and when the Bloom filter can
+    // again be trusted about them.
+    std::unordered_map<ContentHash, time_point> _unmissing;
+
+    std::vector<StorageNodePtr> _targets;
+    std::chrono::milliseconds _ttl[NKINDS];
+    size_t _max_entries;
+
+    Counts _counts[NKINDS];
+    size_t _nevicted;
+
+    // Declared last, so that it is destroyed first, while the rest is
+    // still there for fetches that are finishing up.
+    FanOut _fanout;
+    std::chrono::milliseconds _timeout;
+
+    bool is_fresh(const Key&, Kind);
+    void set_fresh(const Key&, Kind);
+    bool is_missing(uint64_t, const Handle&, Kind);
+    void forget(const Handle&);
+    std::vector<StorageNodePtr> targets(void);
+    bool fan_out(std::vector<FanOut::Job>&, Kind);
+    Handle keep(const AtomSpacePtr&, const Handle&);
+
+    void find_targets(void);
+
+DECLARE_CMD_REQUEST(ReadThruProxy, "r-thru", do_rthru,
+       "Control the read-through proxy.",
+       "Usage: r-thru [invalidate [<atom>] | targets]\n\n"
+       "Atoms, values and incoming sets read by sexpr shell clients are\n"
+       "fetched from every open StorageNode, unless they were fetched\n"
+       "recently. With no arguments, this shows the hit rates and the\n"
+       "number of fetches from storage. `r-thru invalidate` forgets\n"
+       "what was fetched, and what was found to be missing, so that it\n"
+       "is fetched again; given an atom, only that atom, its values and\n"
+       "its incoming set are forgotten. `r-thru targets` looks for open\n"
+       "StorageNodes again, and lists them.\n",
+       false, false)
+
+public:
+    static const char* id(void);
+    ReadThruProxy(CogServer&);
+    virtual ~ReadThruProxy();
+    virtual void init(void);
+    virtual bool config(const char*) { return false; }
+
+    virtual void fetch_atom(const Handle&);
+    virtual void fetch_value(const Handle&, const Handle&);
+    virtual void fetch_incoming(const Handle&, Type);
+    virtual void fetch_type(Type, bool subtypes);
+
+    /** Forget one atom, or, given nullptr, everything. */
+    void invalidate(const Handle&);
+
+    /** Hit rates, and the number of fetches from storage. */
+    std::string stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_READ_THRU_PROXY_H
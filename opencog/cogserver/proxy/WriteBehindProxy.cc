@@ -0,0 +1,356 @@
+/*
+ * opencog/cogserver/proxy/WriteBehindProxy.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <sys/prctl.h>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/atoms/base/Atom.h>
+
+#include "WriteBehindProxy.h"
+
+using namespace opencog;
+
+DECLARE_MODULE(WriteBehindProxy);
+
+WriteBehindProxy::WriteBehindProxy(CogServer& cs) :
+    Module(cs),
+    _thread(nullptr),
+    _stop(false),
+    _flush_now(false),
+    _inflight(0),
+    _nflushing(0),
+    _nqueued(0),
+    _nmerged(0),
+    _nwritten(0),
+    _nbatches(0),
+    _noverflows(0),
+    _nerrors(0),
+    _nlost(0),
+    _max_lag_ms(0.0),
+    _fanout(opencog::config().get_int("PROXY_FANOUT_THREADS", 8),
+            "cogserv:wb-out")
+{
+    _max_pending = opencog::config().get_int("WBEHIND_MAX_PENDING", 100000);
+    _batch_size = opencog::config().get_int("WBEHIND_BATCH_SIZE", 1000);
+    _staleness = std::chrono::milliseconds(
+        opencog::config().get_int("WBEHIND_MAX_STALENESS_MS", 1000));
+    _flush_timeout = std::chrono::milliseconds(
+        opencog::config().get_int("WBEHIND_FLUSH_TIMEOUT_MS", 60000));
+    _write_timeout = std::chrono::milliseconds(
+        opencog::config().get_int("PROXY_WRITE_TIMEOUT_MS", 60000));
+    if (0 == _write_timeout.count())
+        _write_timeout = std::chrono::milliseconds(1);
+    if (0 == _batch_size) _batch_size = 1;
+    if (_max_pending < _batch_size) _max_pending = _batch_size;
+}
+
+void WriteBehindProxy::init(void)
+{
+    find_targets();
+    _thread = new std::thread(&WriteBehindProxy::flush_loop, this);
+
+    _cogserver.changeFeed().add_listener("w-behind",
+        [this](ChangeFeed::Kind kind, const Handle& h,
+               const Handle& key, const ValuePtr&)
+        { enqueue(kind, h, key); });
+
+    do_wbehind_register();
+}
+
+WriteBehindProxy::~WriteBehindProxy()
+{
+    do_wbehind_unregister();
+
+    _cogserver.changeFeed().remove_listener("w-behind");
+
+    // The flush thread writes out whatever is left before exiting.
+    // Flush commands still waiting give up now.
+    {
+        std::unique_lock<std::mutex> lck(_mtx);
+        _stop = true;
+        _flush_cv.notify_all();
+        _done_cv.notify_all();
+        while (0 < _nflushing) _done_cv.wait(lck);
+    }
+    if (_thread)
+    {
+        _thread->join();
+        delete _thread;
+    }
+}
+
+/* ============================================================== */
+
+void WriteBehindProxy::find_targets(void)
+{
+    HandleSeq hs;
+    _cogserver.getAtomSpace()->get_handles_by_type(hs, STORAGE_NODE, true);
+
+    std::vector<StorageNodePtr> targets;
+    for (const Handle& h : hs)
+    {
+        StorageNodePtr snp(StorageNodeCast(h));
+        if (snp and snp->connected()) targets.push_back(snp);
+    }
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    _targets.swap(targets);
+    logger().info("[WriteBehindProxy] writing to %zu StorageNodes",
+                  _targets.size());
+}
+
+void WriteBehindProxy::unindex(const Op& op)
+{
+    if (ChangeFeed::ATOM_REMOVED == op.kind) return;
+    auto it = _index.find(op.atom.get());
+    if (it == _index.end()) return;
+    it->second.erase(op.key.get());
+    if (it->second.empty()) _index.erase(it);
+}
+
+/// Called in the thread that changed the AtomSpace.
+void WriteBehindProxy::enqueue(ChangeFeed::Kind kind, const Handle& h,
+                               const Handle& key)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    if (ChangeFeed::ATOM_REMOVED == kind)
+    {
+        // Anything still waiting to be stored for this atom would
+        // only be deleted again.
+        auto it = _index.find(h.get());
+        if (it != _index.end())
+        {
+            for (const auto& pr : it->second)
+            {
+                _queue.erase(pr.second);
+                _nmerged++;
+            }
+            _index.erase(it);
+        }
+    }
+    else
+    {
+        // Only the atom and the key are recorded; the value is read
+        // when the store is done, so merging keeps the newest one.
+        const Atom* kp = (ChangeFeed::VALUE_CHANGED == kind) ?
+            key.get() : nullptr;
+        auto& keys = _index[h.get()];
+        if (keys.find(kp) != keys.end())
+        {
+            _nmerged++;
+            return;
+        }
+        // An atom store stores every value, too.
+        if (nullptr == kp and 0 < keys.size())
+        {
+            for (const auto& pr : keys)
+                _queue.erase(pr.second);
+            _nmerged += keys.size();
+            keys.clear();
+        }
+        else if (keys.find(nullptr) != keys.end())
+        {
+            _nmerged++;
+            return;
+        }
+    }
+
+    // This runs inside the writer's command, which must not wait
+    // here; see the class comment.
+    if (_max_pending <= _queue.size())
+    {
+        if (0 == _noverflows++)
+            logger().warn("[WriteBehindProxy] more than %zu changes "
+                          "waiting; storage is not keeping up",
+                          _max_pending);
+        _flush_cv.notify_all();
+    }
+
+    Op op;
+    op.kind = kind;
+    op.atom = h;
+    op.key = (ChangeFeed::VALUE_CHANGED == kind) ? key : Handle::UNDEFINED;
+    op.since = std::chrono::steady_clock::now();
+    _queue.push_back(op);
+    _nqueued++;
+
+    if (ChangeFeed::ATOM_REMOVED != kind)
+        _index[h.get()][op.key.get()] = std::prev(_queue.end());
+
+    if (1 == _queue.size() or _batch_size <= _queue.size())
+        _flush_cv.notify_all();
+}
+
+/* ============================================================== */
+
+/// Write the batch to one target. Runs in a fan-out thread, and may
+/// still be running after the flush thread has given up on it.
+void WriteBehindProxy::write_out(const Batch& batch,
+                                 const StorageNodePtr& snp)
+{
+    const AtomSpacePtr& as = _cogserver.getAtomSpace();
+    for (const Op& op : *batch)
+    {
+        try
+        {
+            switch (op.kind)
+            {
+                case ChangeFeed::ATOM_ADDED:
+                    snp->store_atom(op.atom);
+                    break;
+                case ChangeFeed::VALUE_CHANGED:
+                    snp->store_value(op.atom, op.key);
+                    break;
+                case ChangeFeed::ATOM_REMOVED:
+                    // A non-recursive extract only succeeds when
+                    // there is no incoming set, so this is the
+                    // same, either way.
+                    snp->remove_atom(as, op.atom, true);
+                    break;
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            std::lock_guard<std::mutex> lck(_mtx);
+            if (_nerrors++ < 10)
+                logger().warn("[WriteBehindProxy] store failed: %s",
+                              ex.what());
+        }
+    }
+    snp->barrier();
+}
+
+void WriteBehindProxy::flush_loop(void)
+{
+    prctl(PR_SET_NAME, "cogserv:wbehind", 0, 0, 0);
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    while (true)
+    {
+        while (_queue.empty() and not _stop)
+            _flush_cv.wait(lck);
+        if (_queue.empty()) break;
+
+        // Wait for a full batch, or for the oldest entry to get
+        // too old, whichever comes first.
+        auto deadline = _queue.front().since + _staleness;
+        while (not _stop and not _flush_now and
+               _queue.size() < _batch_size and
+               std::chrono::steady_clock::now() < deadline)
+            _flush_cv.wait_until(lck, deadline);
+
+        std::shared_ptr<std::vector<Op>> ops(
+            std::make_shared<std::vector<Op>>());
+        while (ops->size() < _batch_size and not _queue.empty())
+        {
+            unindex(_queue.front());
+            ops->emplace_back(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+        // Removals may have emptied the queue while waiting.
+        if (ops->empty()) continue;
+        Batch batch(ops);
+        std::vector<StorageNodePtr> targets(_targets);
+        _inflight = batch->size();
+        lck.unlock();
+
+        // All targets at once. A stuck target would stall the queue
+        // for good, so it is given up on after the timeout.
+        std::vector<FanOut::Job> jobs;
+        for (const StorageNodePtr& snp : targets)
+            jobs.push_back([this, batch, snp]() { write_out(batch, snp); });
+        FanOut::Result res = _fanout.run(jobs, _write_timeout);
+        if (0 < res.timed_out)
+            logger().warn("[WriteBehindProxy] %zu of %zu targets did not "
+                          "finish writing %zu changes in %ldms",
+                          res.timed_out, targets.size(), batch->size(),
+                          (long) _write_timeout.count());
+
+        lck.lock();
+        std::chrono::duration<double, std::milli> lag =
+            std::chrono::steady_clock::now() - batch->front().since;
+        if (_max_lag_ms < lag.count()) _max_lag_ms = lag.count();
+        _nlost += res.timed_out * batch->size();
+        _nwritten += batch->size();
+        _nbatches++;
+        _inflight = 0;
+        _done_cv.notify_all();
+    }
+}
+
+/* ============================================================== */
+
+std::string WriteBehindProxy::stats(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    char buff[512];
+    snprintf(buff, sizeof(buff),
+        "targets: %zu  pending: %zu (max %zu)  batch: %zu  "
+        "max-staleness: %ldms\n"
+        "queued: %zu  merged: %zu  written: %zu in %zu batches\n"
+        "over limit: %zu  store errors: %zu  timed out: %zu  "
+        "worst lag: %.1fms\n",
+        _targets.size(), _queue.size(), _max_pending, _batch_size,
+        (long) _staleness.count(), _nqueued, _nmerged, _nwritten,
+        _nbatches, _noverflows, _nerrors, _nlost, _max_lag_ms);
+    return buff + _fanout.stats();
+}
+
+/// Write out the whole queue, and wait for that. Runs in a thread of
+/// its own; the module is not destroyed until it returns.
+std::string WriteBehindProxy::flush(void)
+{
+    auto deadline = std::chrono::steady_clock::now() + _flush_timeout;
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    _flush_now = true;
+    _flush_cv.notify_all();
+    while ((not _queue.empty() or 0 < _inflight) and not _stop and
+           std::chrono::steady_clock::now() < deadline)
+        _done_cv.wait_until(lck, deadline);
+
+    std::string rc("Flushed\n");
+    size_t left = _queue.size() + _inflight;
+    if (0 < left)
+        rc = "Flush gave up with " + std::to_string(left) +
+             " changes still waiting\n";
+    if (0 == --_nflushing) _flush_now = false;
+    _done_cv.notify_all();
+    return rc;
+}
+
+std::string WriteBehindProxy::do_wbehind(Request* req,
+                                         std::list<std::string> args)
+{
+    if (args.empty()) return stats();
+
+    // Waiting for storage can take a while; not on the server loop.
+    if (args.front() == "flush")
+    {
+        {
+            std::lock_guard<std::mutex> lck(_mtx);
+            _nflushing++;
+        }
+        req->run_detached("Flush failed: ", [this]() { return flush(); });
+        return "";
+    }
+
+    if (args.front() == "targets")
+    {
+        find_targets();
+        std::string rc;
+        std::lock_guard<std::mutex> lck(_mtx);
+        for (const StorageNodePtr& snp : _targets)
+            rc += snp->to_short_string() + "\n";
+        if (0 == rc.size()) rc = "No open StorageNodes\n";
+        return rc;
+    }
+
+    return "invalid syntax: w-behind [flush | targets]\n";
+}
@@ -0,0 +1,141 @@
+/*
+ * opencog/cogserver/proxy/WriteBehindProxy.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_WRITE_BEHIND_PROXY_H
+#define _OPENCOG_WRITE_BEHIND_PROXY_H
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/persist/api/StorageNode.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/cogserver/proxy/FanOut.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Pass changes made to the CogServer AtomSpace on to StorageNodes,
+ * in the background.
+ *
+ * The old write-thru proxy (see the attic) stored each change to
+ * every target inside the client's command, so that one slow backend
+ * slowed down every writer, and a value updated a thousand times was
+ * stored a thousand times. Instead, this module listens to the
+ * ChangeFeed, and queues each change. Repeated writes to the same
+ * (atom, key) are merged into one queue entry, and when it is
+ * written, the value at that time is stored. A background thread
+ * writes the queue out in batches of WBEHIND_BATCH_SIZE, and never
+ * lets an entry wait longer than WBEHIND_MAX_STALENESS_MS.
+ *
+ * Writers are never made to wait: the queue is filled from inside
+ * their commands, where a wait would hold up checkpoints and snapshot
+ * reads as well. If more than WBEHIND_MAX_PENDING entries are
+ * waiting, the queue is written out at once, and the overflow is
+ * counted and logged, so that a backend that cannot keep up is seen.
+ *
+ * Each batch is written to all of the targets at once, so that a
+ * batch takes as long as the slowest target, not as long as all of
+ * them together. A target that has not finished a batch after
+ * PROXY_WRITE_TIMEOUT_MS is given up on, for that batch: the writes
+ * still running are left to finish, the ones not started are dropped,
+ * and both are counted as timed out.
+ *
+ * The targets are the StorageNodes that are open when the module is
+ * loaded. Open them first, or use `w-behind targets` afterwards.
+ */
+class WriteBehindProxy : public Module
+{
+private:
+    struct Op
+    {
+        ChangeFeed::Kind kind;
+        Handle atom;
+        Handle key;
+        std::chrono::steady_clock::time_point since;
+    };
+    typedef std::list<Op> OpList;
+
+    std::mutex _mtx;
+    std::condition_variable _flush_cv;
+    std::condition_variable _done_cv;
+    OpList _queue;
+
+    // Stores that can still be merged: atom -> key -> queue entry.
+    // Atom stores use a null key. Removals are never merged.
+    std::unordered_map<const Atom*,
+        std::unordered_map<const Atom*, OpList::iterator>> _index;
+
+    std::vector<StorageNodePtr> _targets;
+    std::thread* _thread;
+    bool _stop;
+    bool _flush_now;
+    size_t _inflight;
+    size_t _nflushing;
+
+    size_t _max_pending;
+    size_t _batch_size;
+    std::chrono::milliseconds _staleness;
+    std::chrono::milliseconds _flush_timeout;
+    std::chrono::milliseconds _write_timeout;
+
+    size_t _nqueued;
+    size_t _nmerged;
+    size_t _nwritten;
+    size_t _nbatches;
+    size_t _noverflows;
+    size_t _nerrors;
+    size_t _nlost;
+    double _max_lag_ms;
+
+    // Each batch is written to all targets at once.
+    FanOut _fanout;
+
+    void enqueue(ChangeFeed::Kind, const Handle&, const Handle&);
+    void unindex(const Op&);
+    void find_targets(void);
+    typedef std::shared_ptr<const std::vector<Op>> Batch;
+    void write_out(const Batch&, const StorageNodePtr&);
+    void flush_loop(void);
+    std::string flush(void);
+    std::string stats(void);
+
+DECLARE_CMD_REQUEST(WriteBehindProxy, "w-behind", do_wbehind,
+       "Control the write-behind proxy.",
+       "Usage: w-behind [flush | targets]\n\n"
+       "Changes made to the AtomSpace are queued, and written to every\n"
+       "open StorageNode in the background. With no arguments, this\n"
+       "shows the queue statistics. `w-behind flush` writes out the\n"
+       "whole queue, and waits for that to finish, for up to\n"
+       "WBEHIND_FLUSH_TIMEOUT_MS. `w-behind targets` looks for open\n"
+       "StorageNodes again, and lists them.\n",
+       false, false)
+
+public:
+    static const char* id(void);
+    WriteBehindProxy(CogServer&);
+    virtual ~WriteBehindProxy();
+    virtual void init(void);
+    virtual bool config(const char*) { return false; }
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_WRITE_BEHIND_PROXY_H
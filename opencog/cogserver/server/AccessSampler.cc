@@ -0,0 +1,198 @@
+/*
+ * opencog/cogserver/server/AccessSampler.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/Config.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+
+#include "AccessSampler.h"
+
+using namespace opencog;
+
+#define DEPTH 4
+
+/// Count-min sketch, plus the atoms with the highest counts.
+class AccessSampler::Sketch
+{
+    private:
+        size_t _width;
+        size_t _track;
+        std::vector<double> _counts;
+        std::unordered_map<ContentHash, std::pair<Handle, double>> _top;
+
+    public:
+        Sketch(size_t width, size_t track) :
+            _width(width), _track(track), _counts(DEPTH * width, 0.0) {}
+
+        void add(const Handle&, double);
+        void scale(double);
+        void clear(void);
+        std::vector<std::pair<Handle, double>> top(size_t) const;
+};
+
+void AccessSampler::Sketch::add(const Handle& item, double w)
+{
+    // Row hashes are made from one, as h1 + i*h2.
+    uint64_t h1 = item->get_hash();
+    uint64_t h2 = (h1 * 0x9E3779B97F4A7C15ULL) | 1;
+    double est = HUGE_VAL;
+    for (size_t i = 0; i < DEPTH; i++)
+    {
+        double& c = _counts[i * _width + (h1 + i * h2) % _width];
+        c += w;
+        est = std::min(est, c);
+    }
+
+    auto it = _top.find(h1);
+    if (_top.end() != it)
+    {
+        it->second.second = est;
+        return;
+    }
+    if (_top.size() < _track)
+    {
+        _top.emplace(h1, std::make_pair(item, est));
+        return;
+    }
+    auto low = std::min_element(_top.begin(), _top.end(),
+        [](const auto& a, const auto& b)
+        { return a.second.second < b.second.second; });
+    if (low->second.second < est)
+    {
+        _top.erase(low);
+        _top.emplace(h1, std::make_pair(item, est));
+    }
+}
+
+void AccessSampler::Sketch::scale(double f)
+{
+    for (double& c : _counts) c *= f;
+    for (auto& it : _top) it.second.second *= f;
+}
+
+void AccessSampler::Sketch::clear(void)
+{
+    std::fill(_counts.begin(), _counts.end(), 0.0);
+    _top.clear();
+}
+
+std::vector<std::pair<Handle, double>>
+AccessSampler::Sketch::top(size_t k) const
+{
+    std::vector<std::pair<Handle, double>> rv;
+    for (const auto& it : _top) rv.push_back(it.second);
+    std::sort(rv.begin(), rv.end(),
+        [](const auto& a, const auto& b) { return a.second > b.second; });
+    if (k < rv.size()) rv.resize(k);
+    return rv;
+}
+
+/* ============================================================== */
+
+AccessSampler::AccessSampler(void) :
+    _nsampled(0)
+{
+    int every = config().get_int("HOT_SAMPLE_EVERY", 16);
+    _every = (every < 0) ? 0 : every;
+    _half_life = config().get_int("HOT_HALF_LIFE", 300);
+    if (_half_life <= 0) _half_life = 1;
+    int width = config().get_int("HOT_SKETCH_WIDTH", 4096);
+    if (width <= 0) width = 1;
+    int track = config().get_int("HOT_TRACK", 256);
+    if (track < 0) track = 0;
+    _atoms.reset(new Sketch(width, track));
+    _keys.reset(new Sketch(width, track));
+    _epoch = std::chrono::steady_clock::now();
+}
+
+AccessSampler::~AccessSampler()
+{
+}
+
+/// The weight of an access made now, relative to one made at the
+/// epoch. Rescales everything when it gets large. Call with the lock.
+double AccessSampler::weight(void)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> age = now - _epoch;
+    double w = exp2(age.count() / _half_life);
+    if (w < 1e30) return w;
+
+    _atoms->scale(1.0 / w);
+    _keys->scale(1.0 / w);
+    _epoch = now;
+    return 1.0;
+}
+
+void AccessSampler::sample(const Handle& atom, const Handle& key)
+{
+    if (0 == _every or nullptr == atom) return;
+
+    // xorshift; cheap, and the threads don't share it.
+    static thread_local uint64_t rng =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    if (rng % _every) return;
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    double w = weight();
+    _atoms->add(atom, w);
+    if (key) _keys->add(key, w);
+    _nsampled++;
+}
+
+void AccessSampler::reset(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _atoms->clear();
+    _keys->clear();
+    _epoch = std::chrono::steady_clock::now();
+    _nsampled = 0;
+}
+
+std::string AccessSampler::display(size_t k)
+{
+    if (0 == _every)
+        return "Access sampling is off; set HOT_SAMPLE_EVERY\n";
+
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    // Counts are as of now, and stand for all commands, not just
+    // the sampled ones.
+    double f = _every / weight();
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "sampled: %zu uses (1 in %u)  half-life: %.0f secs\n",
+             _nsampled, _every, _half_life);
+    std::string rc = buf;
+
+    rc += "atoms:\n";
+    for (const auto& it : _atoms->top(k))
+    {
+        snprintf(buf, sizeof(buf), "  %10.1f  ", it.second * f);
+        rc += buf + Sexpr::encode_atom(it.first) + "\n";
+    }
+    rc += "keys:\n";
+    for (const auto& it : _keys->top(k))
+    {
+        snprintf(buf, sizeof(buf), "  %10.1f  ", it.second * f);
+        rc += buf + Sexpr::encode_atom(it.first) + "\n";
+    }
+    return rc;
+}
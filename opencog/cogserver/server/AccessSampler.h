@@ -0,0 +1,72 @@
+/*
+ * opencog/cogserver/server/AccessSampler.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_ACCESS_SAMPLER_H
+#define _OPENCOG_ACCESS_SAMPLER_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Find the atoms and keys that the clients use the most.
+ *
+ * The sexpr shell's command handlers call sample() with the atom each
+ * command is about, and the key, if any. One call in HOT_SAMPLE_EVERY,
+ * picked at random, is counted; the rest cost a random number. Atoms
+ * and keys are counted, by their hash, in a count-min sketch, one for
+ * atoms and one for keys, so that memory stays fixed however many
+ * distinct atoms there are. A few hundred of the highest counts are
+ * remembered, with the atom, so that they can be printed.
+ *
+ * Counts decay: an access made HOT_HALF_LIFE seconds ago counts half
+ * as much as one made now. Rather than touching every counter, new
+ * accesses are given an ever-growing weight, and everything is scaled
+ * down, once in a long while, before the weight gets too large.
+ */
+class AccessSampler
+{
+    class Sketch;
+
+    std::mutex _mtx;
+    std::unique_ptr<Sketch> _atoms;
+    std::unique_ptr<Sketch> _keys;
+    unsigned int _every;
+    double _half_life;
+    std::chrono::steady_clock::time_point _epoch;
+    size_t _nsampled;
+
+    double weight(void);
+
+public:
+    AccessSampler(void);
+    ~AccessSampler();
+
+    /** Maybe count a use of an atom, and of one of its keys. */
+    void sample(const Handle& atom, const Handle& key = Handle::UNDEFINED);
+
+    /** Forget all counts. */
+    void reset(void);
+
+    /** The `k` most used atoms and keys, with their decayed counts,
+     *  scaled up by the sampling rate. */
+    std::string display(size_t k);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_ACCESS_SAMPLER_H
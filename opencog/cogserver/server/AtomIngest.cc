@@ -0,0 +1,319 @@
+/*
+ * opencog/cogserver/server/AtomIngest.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+#include <opencog/network/GenericShell.h>
+
+#include "AtomIngest.h"
+
+using namespace opencog;
+
+// Size of each read from the input. Each chunk handed to the workers
+// is about this big, so it should be large enough to keep a worker
+// busy for a while, and small enough to spread the load.
+#define BLOCK_SIZE (4*1024*1024)
+
+// Number of atoms to parse before adding them to the AtomSpace.
+#define BATCH_SIZE 1000
+
+// Only the first few parse errors are logged in full.
+#define MAX_LOGGED_ERRORS 10
+
+namespace {
+
+/// A run of complete top-level expressions, and where each one is.
+struct Chunk
+{
+    std::string text;
+    std::vector<std::pair<size_t, size_t>> exprs;
+};
+
+/// Just enough of the s-expression syntax to find where each
+/// top-level expression begins and ends: parens, strings with
+/// backslash escapes, and semicolon comments.
+struct Scanner
+{
+    int depth = 0;
+    bool in_string = false;
+    bool escape = false;
+    bool in_comment = false;
+    size_t start = 0;
+    size_t stray = 0;
+
+    /// Scan buf[from, to), appending each complete expression to
+    /// `out`. Returns the offset just past the last one, or zero.
+    size_t scan(const std::string& buf, size_t from, size_t to,
+                std::vector<std::pair<size_t, size_t>>& out)
+    {
+        size_t cut = 0;
+        for (size_t i = from; i < to; i++)
+        {
+            char c = buf[i];
+            if (in_comment)
+            {
+                if ('\n' == c) in_comment = false;
+                continue;
+            }
+            if (in_string)
+            {
+                if (escape) escape = false;
+                else if ('\\' == c) escape = true;
+                else if ('"' == c) in_string = false;
+                continue;
+            }
+            if ('"' == c) in_string = true;
+            else if (';' == c) in_comment = true;
+            else if ('(' == c)
+            {
+                if (0 == depth) start = i;
+                depth++;
+            }
+            else if (')' == c)
+            {
+                if (0 == depth) { stray++; continue; }
+                depth--;
+                if (0 == depth)
+                {
+                    out.emplace_back(start, i + 1 - start);
+                    cut = i + 1;
+                }
+            }
+        }
+        return cut;
+    }
+};
+
+/// Chunks waiting to be parsed. Bounded, so that a fast reader
+/// does not pull the whole file into memory.
+class ChunkQueue
+{
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::deque<Chunk> _q;
+    size_t _max;
+    bool _done = false;
+public:
+    ChunkQueue(size_t max) : _max(max) {}
+
+    void push(Chunk&& c)
+    {
+        std::unique_lock<std::mutex> lck(_mtx);
+        while (_max <= _q.size()) _cv.wait(lck);
+        _q.emplace_back(std::move(c));
+        _cv.notify_all();
+    }
+
+    bool pop(Chunk& c)
+    {
+        std::unique_lock<std::mutex> lck(_mtx);
+        while (_q.empty() and not _done) _cv.wait(lck);
+        if (_q.empty()) return false;
+        c = std::move(_q.front());
+        _q.pop_front();
+        _cv.notify_all();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _done = true;
+        _cv.notify_all();
+    }
+};
+
+/// One parsed expression: an atom or, for `cog-set-value!`, an atom,
+/// a key and a value.
+struct Parsed
+{
+    Handle atom;
+    Handle key;
+    ValuePtr value;
+};
+
+Parsed parse_expr(const std::string& expr)
+{
+    static const std::string setv("(cog-set-value!");
+    if (expr.compare(0, setv.size(), setv) or expr.size() <= setv.size() or
+        (' ' != expr[setv.size()] and '\t' != expr[setv.size()]))
+        return {Sexpr::decode_atom(expr), Handle::UNDEFINED, nullptr};
+
+    size_t pos = setv.size();
+    Parsed p;
+    p.atom = Sexpr::decode_atom(ChangeFeed::next_expr(expr, pos));
+    p.key = Sexpr::decode_atom(ChangeFeed::next_expr(expr, pos));
+    std::string vstr(ChangeFeed::next_expr(expr, pos));
+    size_t vpos = 0;
+    p.value = Sexpr::decode_value(vstr, vpos);
+    return p;
+}
+
+void parse_chunks(AtomSpace* as, ChunkQueue& queue,
+                  AtomIngest::Counters& cnt, ChangeFeed* feed)
+{
+    std::vector<Parsed> batch;
+    batch.reserve(BATCH_SIZE);
+
+    auto flush = [&]() {
+        // Hold off a checkpoint fork, one batch at a time; see
+        // BackgroundSave.
+        std::shared_lock<std::shared_timed_mutex> lck(
+            GenericShell::eval_barrier());
+        for (const Parsed& p : batch)
+        {
+            try
+            {
+                Handle added(as->add_atom(p.atom));
+                if (p.key)
+                {
+                    Handle key(as->add_atom(p.key));
+                    as->set_value(added, key, p.value);
+                    cnt.values++;
+                    if (feed) feed->value_changed(added, key, p.value);
+                    continue;
+                }
+                cnt.exprs++;
+                if (feed) feed->atom_added(added);
+            }
+            catch (const std::exception& e) {
+                if (cnt.errors++ < MAX_LOGGED_ERRORS)
+                    logger().warn("[AtomIngest] cannot add atom: %s",
+                                  e.what());
+            }
+        }
+        batch.clear();
+    };
+
+    Chunk chunk;
+    while (queue.pop(chunk))
+    {
+        for (const auto& ex : chunk.exprs)
+        {
+            std::string expr(chunk.text, ex.first, ex.second);
+            try
+            {
+                batch.emplace_back(parse_expr(expr));
+            }
+            catch (const std::exception& e)
+            {
+                size_t nerr = cnt.errors++;
+                if (nerr < MAX_LOGGED_ERRORS)
+                    logger().warn("[AtomIngest] skipping %.80s: %s",
+                                  expr.c_str(), e.what());
+                continue;
+            }
+            if (BATCH_SIZE <= batch.size()) flush();
+        }
+    }
+    flush();
+}
+
+} // namespace
+
+void AtomIngest::load(const AtomSpacePtr& asp, const std::string& path,
+                      unsigned int nthreads, Counters& cnt,
+                      ChangeFeed* feed)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw IOException(TRACE_INFO, "Cannot open %s: %s",
+                          path.c_str(), strerror(errno));
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    if (0 == nthreads) nthreads = 1;
+    ChunkQueue queue(2 * nthreads);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < nthreads; i++)
+        workers.push_back(std::thread(parse_chunks, asp.get(),
+                                      std::ref(queue), std::ref(cnt),
+                                      feed));
+
+    auto start = std::chrono::steady_clock::now();
+    auto last_report = start;
+
+    // The reader: this thread. `carry` holds text that has not yet
+    // been handed off; everything before `scanned` has been scanned.
+    Scanner scanner;
+    std::string carry;
+    std::vector<std::pair<size_t, size_t>> exprs;
+    size_t scanned = 0;
+    int read_errno = 0;
+    while (true)
+    {
+        size_t have = carry.size();
+        carry.resize(have + BLOCK_SIZE);
+        ssize_t got = read(fd, &carry[have], BLOCK_SIZE);
+        if (got < 0 and EINTR == errno) { carry.resize(have); continue; }
+        if (got <= 0)
+        {
+            if (got < 0) read_errno = errno;
+            carry.resize(have);
+            break;
+        }
+        carry.resize(have + got);
+        cnt.bytes += got;
+
+        size_t cut = scanner.scan(carry, scanned, carry.size(), exprs);
+        scanned = carry.size();
+        if (0 < cut)
+        {
+            Chunk chunk;
+            chunk.text = carry.substr(0, cut);
+            chunk.exprs.swap(exprs);
+            carry.erase(0, cut);
+            scanned -= cut;
+            if (0 < scanner.depth) scanner.start -= cut;
+            queue.push(std::move(chunk));
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::seconds(5) <= now - last_report)
+        {
+            last_report = now;
+            std::chrono::duration<double> secs = now - start;
+            logger().info("[AtomIngest] %s: %zu MB read, %zu atoms, "
+                "%zu values, %zu errors; %.1f MB/s, %.0f atoms/s",
+                path.c_str(), cnt.bytes.load() >> 20, cnt.exprs.load(),
+                cnt.values.load(), cnt.errors.load(), (cnt.bytes >> 20) / secs.count(),
+                cnt.exprs / secs.count());
+        }
+    }
+    close(fd);
+
+    queue.close();
+    for (std::thread& w : workers) w.join();
+
+    if (0 < scanner.depth)
+    {
+        cnt.errors++;
+        logger().warn("[AtomIngest] %s ends in the middle of an expression",
+                      path.c_str());
+    }
+    if (0 < scanner.stray)
+        logger().warn("[AtomIngest] %s has %zu unbalanced close parens",
+                      path.c_str(), scanner.stray);
+
+    if (read_errno)
+        throw IOException(TRACE_INFO, "Error reading %s: %s",
+                          path.c_str(), strerror(read_errno));
+}
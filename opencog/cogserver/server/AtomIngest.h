@@ -0,0 +1,67 @@
+/*
+ * opencog/cogserver/server/AtomIngest.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_ATOM_INGEST_H
+#define _OPENCOG_ATOM_INGEST_H
+
+#include <atomic>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Bulk loader for large files of Atomese s-expressions.
+ *
+ * Loading a big dump through a shell runs every expression through a
+ * single evaluator, one at a time. Instead, this reads the input in
+ * large blocks. Each block is cut at the end of the last complete
+ * top-level s-expression, and handed to a pool of worker threads.
+ * The workers split their block into expressions, parse each one,
+ * and add the resulting atoms to the AtomSpace in batches.
+ *
+ * Only plain Atomese is accepted: each top-level expression must be
+ * an Atom, or `(cog-set-value! <atom> <key> <value>)`, on one line,
+ * which adds the atom and the key, and sets the value. Other
+ * expressions, such as other scheme function calls, are counted as
+ * errors and skipped. Comments are ignored. The input can be a
+ * regular file or a named pipe.
+ *
+ * The workers hold GenericShell::eval_barrier() while they add each
+ * batch, as a shell would.
+ */
+class AtomIngest
+{
+public:
+    /// Progress counters; may be read while an ingest is running.
+    struct Counters
+    {
+        std::atomic_size_t bytes;
+        std::atomic_size_t exprs;
+        std::atomic_size_t values;
+        std::atomic_size_t errors;
+    };
+
+    /** Read `path` into the AtomSpace using `nthreads` parser threads.
+     *  Progress is logged every few seconds. Throws if the file
+     *  cannot be opened, or on a read error. If `feed` is given,
+     *  each added atom is published to it. */
+    static void load(const AtomSpacePtr&, const std::string& path,
+                     unsigned int nthreads, Counters&,
+                     ChangeFeed* feed = nullptr);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_ATOM_INGEST_H
@@ -0,0 +1,637 @@
+/*
+ * opencog/cogserver/server/AtomSnapshot.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+
+#include "AtomSnapshot.h"
+#include "ChangeFeed.h"
+
+using namespace opencog;
+
+// File layout. All integers are in host byte order.
+//
+//   header:  char[8] magic, uint32 byte-order mark,
+//            uint32 ntypes, uint64 natoms, uint64 nvalues
+//   types:   ntypes x { uint16 len, char[len] type name }
+//   atoms:   natoms x { uint16 type, uint8 kind, uint32 n,
+//                       node: char[n] name
+//                       link: uint64[n] outgoing atom index }
+//   values:  nvalues x { uint64 atom index, uint64 key index,
+//                        uint16 type, uint8 kind, uint32 n,
+//                        float:  double[n]
+//                        string: n x { uint32 len, char[len] }
+//                        sexpr:  char[n] s-expression }
+//
+// Type numbers in the file are indexes into the type table, so that
+// a snapshot stays loadable when the type numbering changes. Version
+// 01 files, which have no s-expression values, are still read.
+
+static const char MAGIC[8] = {'O', 'C', 'S', 'N', 'A', 'P', '0', '2'};
+static const char MAGIC_01[8] = {'O', 'C', 'S', 'N', 'A', 'P', '0', '1'};
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+enum : uint8_t { KIND_NODE = 0, KIND_LINK = 1 };
+enum : uint8_t { KIND_FLOAT = 0, KIND_STRING = 1, KIND_SEXPR = 2 };
+
+// ==============================================================
+// Writing
+
+namespace {
+
+class SnapWriter
+{
+    FILE* _fh;
+    std::string _path;
+public:
+    SnapWriter(const std::string& path) : _path(path)
+    {
+        _fh = fopen(path.c_str(), "wb");
+        if (nullptr == _fh)
+            throw IOException(TRACE_INFO, "Cannot open %s for writing: %s",
+                              path.c_str(), strerror(errno));
+        setvbuf(_fh, nullptr, _IOFBF, 1<<20);
+    }
+    ~SnapWriter() { if (_fh) fclose(_fh); }
+
+    void put(const void* buf, size_t len)
+    {
+        if (len != fwrite(buf, 1, len, _fh))
+            throw IOException(TRACE_INFO, "Write to %s failed: %s",
+                              _path.c_str(), strerror(errno));
+    }
+    template<typename T> void put(T val) { put(&val, sizeof(T)); }
+
+    void close(void)
+    {
+        int rc = fclose(_fh);
+        _fh = nullptr;
+        if (rc)
+            throw IOException(TRACE_INFO, "Close of %s failed: %s",
+                              _path.c_str(), strerror(errno));
+    }
+};
+
+typedef std::unordered_map<Handle, uint64_t> AtomIndex;
+
+/// Append `h` to `order`, after everything in its outgoing set.
+void order_atom(const Handle& h, AtomIndex& index, HandleSeq& order)
+{
+    if (index.find(h) != index.end()) return;
+    if (h->is_link())
+        for (const Handle& ho : h->getOutgoingSet())
+            order_atom(ho, index, order);
+    index.emplace(h, order.size());
+    order.push_back(h);
+}
+
+} // anon namespace
+
+size_t AtomSnapshot::save(const AtomSpacePtr& as, const std::string& path,
+                          size_t* nskipped_out)
+{
+    HandleSeq all;
+    as->get_handles_by_type(all, ATOM, true);
+
+    AtomIndex index;
+    HandleSeq order;
+    order.reserve(all.size());
+    for (const Handle& h : all)
+        order_atom(h, index, order);
+
+    // Value keys are atoms too; make sure they get written. The
+    // loop picks up the keys of the keys, as they are appended.
+    for (size_t i = 0; i < order.size(); i++)
+        for (const Handle& key : order[i]->getKeys())
+            order_atom(key, index, order);
+
+    // Assign file-local type numbers, and collect the values. The
+    // values are copied out now, as they may be changing underneath
+    // us. Values other than floats and strings are written as their
+    // s-expressions, as in the deltas and the write-ahead log.
+    std::map<Type, uint16_t> ftypes;
+    std::vector<Type> types;
+    auto ftype = [&](Type t) -> uint16_t {
+        auto it = ftypes.find(t);
+        if (it != ftypes.end()) return it->second;
+        ftypes[t] = types.size();
+        types.push_back(t);
+        return types.size() - 1;
+    };
+
+    struct ValueEntry
+    {
+        uint64_t atom;
+        uint64_t key;
+        ValuePtr v;
+        std::string sexpr;
+    };
+    std::vector<ValueEntry> values;
+    size_t nskipped = 0;
+    for (const Handle& h : order)
+    {
+        ftype(h->get_type());
+        for (const Handle& key : h->getKeys())
+        {
+            ValuePtr v = h->getValue(key);
+            if (nullptr == v) continue;
+
+            // A key added since the scan above has no index.
+            auto kit = index.find(key);
+            if (kit == index.end()) continue;
+
+            // Streams compute a new sample each time they are read;
+            // the sample is not the stream, and the stream cannot be
+            // rebuilt from it.
+            Type vt = v->get_type();
+            if (nameserver().isA(vt, STREAM_VALUE))
+            {
+                nskipped++;
+                continue;
+            }
+
+            // Only the plain types are rebuilt from their numbers or
+            // strings; subtypes may need more than that.
+            if (FLOAT_VALUE == vt or STRING_VALUE == vt)
+            {
+                ftype(vt);
+                values.push_back({index[h], kit->second, v, ""});
+                continue;
+            }
+
+            // Streams and the like have no s-expression.
+            try
+            {
+                std::string sx(Sexpr::encode_value(v));
+                ftype(vt);
+                values.push_back({index[h], kit->second, v, std::move(sx)});
+            }
+            catch (const std::exception&)
+            {
+                nskipped++;
+            }
+        }
+    }
+    if (nskipped_out)
+        *nskipped_out = nskipped;
+    else if (nskipped)
+        logger().info("[AtomSnapshot] skipped %zu values of unsupported type",
+                      nskipped);
+
+    // Write to a temp file, and rename when done, so that a crash
+    // part-way through doesn't clobber the previous snapshot.
+    std::string tmp = path + ".tmp";
+    SnapWriter out(tmp);
+
+    out.put(MAGIC, sizeof(MAGIC));
+    out.put<uint32_t>(BYTE_ORDER_MARK);
+    out.put<uint32_t>(types.size());
+    out.put<uint64_t>(order.size());
+    out.put<uint64_t>(values.size());
+
+    for (Type t : types)
+    {
+        const std::string& tname = nameserver().getTypeName(t);
+        out.put<uint16_t>(tname.size());
+        out.put(tname.data(), tname.size());
+    }
+
+    for (const Handle& h : order)
+    {
+        out.put<uint16_t>(ftypes[h->get_type()]);
+        if (h->is_node())
+        {
+            const std::string& name = h->get_name();
+            out.put<uint8_t>(KIND_NODE);
+            out.put<uint32_t>(name.size());
+            out.put(name.data(), name.size());
+            continue;
+        }
+        const HandleSeq& oset = h->getOutgoingSet();
+        out.put<uint8_t>(KIND_LINK);
+        out.put<uint32_t>(oset.size());
+        for (const Handle& ho : oset)
+            out.put<uint64_t>(index[ho]);
+    }
+
+    for (const ValueEntry& ve : values)
+    {
+        Type vt = ve.v->get_type();
+        out.put<uint64_t>(ve.atom);
+        out.put<uint64_t>(ve.key);
+        out.put<uint16_t>(ftypes[vt]);
+        if (not ve.sexpr.empty())
+        {
+            out.put<uint8_t>(KIND_SEXPR);
+            out.put<uint32_t>(ve.sexpr.size());
+            out.put(ve.sexpr.data(), ve.sexpr.size());
+            continue;
+        }
+        if (FLOAT_VALUE == vt)
+        {
+            const std::vector<double>& dv = FloatValueCast(ve.v)->value();
+            out.put<uint8_t>(KIND_FLOAT);
+            out.put<uint32_t>(dv.size());
+            out.put(dv.data(), dv.size() * sizeof(double));
+            continue;
+        }
+        const std::vector<std::string>& sv = StringValueCast(ve.v)->value();
+        out.put<uint8_t>(KIND_STRING);
+        out.put<uint32_t>(sv.size());
+        for (const std::string& str : sv)
+        {
+            out.put<uint32_t>(str.size());
+            out.put(str.data(), str.size());
+        }
+    }
+    out.close();
+    commit_file(tmp, path);
+
+    return order.size();
+}
+
+void AtomSnapshot::commit_file(const std::string& tmp, const std::string& path)
+{
+    int fd = open(tmp.c_str(), O_RDONLY);
+    if (fd < 0 or fsync(fd))
+    {
+        int err = errno;
+        if (0 <= fd) close(fd);
+        throw IOException(TRACE_INFO, "Cannot sync %s: %s",
+                          tmp.c_str(), strerror(err));
+    }
+    close(fd);
+
+    if (rename(tmp.c_str(), path.c_str()))
+        throw IOException(TRACE_INFO, "Cannot rename %s to %s: %s",
+                          tmp.c_str(), path.c_str(), strerror(errno));
+
+    // The rename is only durable once the directory is.
+    size_t slash = path.find_last_of('/');
+    std::string dir(std::string::npos == slash ? "." :
+                    0 == slash ? "/" : path.substr(0, slash));
+    fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0 or fsync(fd))
+    {
+        int err = errno;
+        if (0 <= fd) close(fd);
+        throw IOException(TRACE_INFO, "Cannot sync directory %s: %s",
+                          dir.c_str(), strerror(err));
+    }
+    close(fd);
+}
+
+// ==============================================================
+// Reading
+
+namespace {
+
+/// Read-only memory map of a file.
+class MappedFile
+{
+    int _fd;
+public:
+    const char* base;
+    size_t size;
+
+    MappedFile(const std::string& path) : _fd(-1), base(nullptr), size(0)
+    {
+        _fd = open(path.c_str(), O_RDONLY);
+        if (_fd < 0)
+            throw IOException(TRACE_INFO, "Cannot open snapshot %s: %s",
+                              path.c_str(), strerror(errno));
+        struct stat st;
+        if (fstat(_fd, &st) or 0 == st.st_size)
+        {
+            ::close(_fd);
+            throw IOException(TRACE_INFO, "Empty or unreadable snapshot %s",
+                              path.c_str());
+        }
+        size = st.st_size;
+        void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if (MAP_FAILED == addr)
+        {
+            ::close(_fd);
+            throw IOException(TRACE_INFO, "Cannot map snapshot %s: %s",
+                              path.c_str(), strerror(errno));
+        }
+        base = (const char*) addr;
+        madvise(addr, size, MADV_WILLNEED);
+    }
+    ~MappedFile()
+    {
+        if (base) munmap((void*) base, size);
+        if (0 <= _fd) ::close(_fd);
+    }
+};
+
+/// Bounds-checked reader over the mapped file.
+class Cursor
+{
+    const char* _end;
+public:
+    const char* p;
+
+    Cursor(const char* start, const char* end) : _end(end), p(start) {}
+
+    const char* skip(size_t len)
+    {
+        if ((size_t)(_end - p) < len)
+            throw SyntaxException(TRACE_INFO, "Truncated snapshot file");
+        const char* at = p;
+        p += len;
+        return at;
+    }
+    template<typename T> T get(void)
+    {
+        T val;
+        memcpy(&val, skip(sizeof(T)), sizeof(T));
+        return val;
+    }
+};
+
+struct ValueRec
+{
+    uint64_t atom;
+    uint64_t key;
+    const char* rec;
+};
+
+/// Run fn(i) for i in [0, n), spread over nthreads threads.
+/// The first exception thrown by any thread is re-thrown here.
+template<typename F>
+void parallel_for(size_t n, unsigned int nthreads, const F& fn)
+{
+    if (nthreads < 2 or n < 1024)
+    {
+        for (size_t i = 0; i < n; i++) fn(i);
+        return;
+    }
+
+    std::mutex emtx;
+    std::exception_ptr eptr;
+    size_t chunk = (n + nthreads - 1) / nthreads;
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < nthreads; t++)
+    {
+        size_t lo = t * chunk;
+        size_t hi = std::min(n, lo + chunk);
+        if (hi <= lo) break;
+        workers.push_back(std::thread([&, lo, hi]() {
+            try {
+                for (size_t i = lo; i < hi; i++) fn(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lck(emtx);
+                if (not eptr) eptr = std::current_exception();
+            }
+        }));
+    }
+    for (std::thread& w : workers) w.join();
+    if (eptr) std::rethrow_exception(eptr);
+}
+
+} // anon namespace
+
+size_t AtomSnapshot::load(const AtomSpacePtr& as, const std::string& path,
+                          unsigned int nthreads, ChangeFeed* feed)
+{
+    MappedFile mf(path);
+    Cursor cur(mf.base, mf.base + mf.size);
+
+    const char* magic = cur.skip(sizeof(MAGIC));
+    if (memcmp(magic, MAGIC, sizeof(MAGIC)) and
+        memcmp(magic, MAGIC_01, sizeof(MAGIC_01)))
+        throw SyntaxException(TRACE_INFO, "Not a snapshot file: %s",
+                              path.c_str());
+    if (BYTE_ORDER_MARK != cur.get<uint32_t>())
+        throw SyntaxException(TRACE_INFO,
+            "Snapshot %s was written on a machine with different byte order",
+            path.c_str());
+
+    uint32_t ntypes = cur.get<uint32_t>();
+    uint64_t natoms = cur.get<uint64_t>();
+    uint64_t nvalues = cur.get<uint64_t>();
+
+    std::vector<Type> types(ntypes);
+    for (uint32_t i = 0; i < ntypes; i++)
+    {
+        uint16_t len = cur.get<uint16_t>();
+        std::string tname(cur.skip(len), len);
+        types[i] = nameserver().getType(tname);
+        if (NOTYPE == types[i])
+            throw SyntaxException(TRACE_INFO,
+                "Snapshot uses unknown type %s", tname.c_str());
+    }
+    auto get_type = [&](Cursor& c) -> Type {
+        uint16_t ft = c.get<uint16_t>();
+        if (ntypes <= ft)
+            throw SyntaxException(TRACE_INFO, "Bad type in snapshot");
+        return types[ft];
+    };
+
+    // Index the atom records, and sort them into levels. A link can
+    // only be created after its outgoing set, so it goes one level
+    // above the highest of those.
+    std::vector<const char*> recs(natoms);
+    std::vector<uint32_t> level(natoms);
+    std::vector<std::vector<uint64_t>> levels(1);
+    for (uint64_t i = 0; i < natoms; i++)
+    {
+        recs[i] = cur.p;
+        get_type(cur);
+        uint8_t kind = cur.get<uint8_t>();
+        uint32_t n = cur.get<uint32_t>();
+        uint32_t lvl = 0;
+        if (KIND_NODE == kind)
+            cur.skip(n);
+        else
+        {
+            for (uint32_t j = 0; j < n; j++)
+            {
+                uint64_t out = cur.get<uint64_t>();
+                if (i <= out)
+                    throw SyntaxException(TRACE_INFO,
+                        "Snapshot atom %lu refers forward", (unsigned long) i);
+                lvl = std::max(lvl, level[out] + 1);
+            }
+        }
+        level[i] = lvl;
+        if (levels.size() <= lvl) levels.resize(lvl + 1);
+        levels[lvl].push_back(i);
+    }
+
+    // Index the value records.
+    std::vector<ValueRec> vrecs(nvalues);
+    for (uint64_t i = 0; i < nvalues; i++)
+    {
+        uint64_t atom = cur.get<uint64_t>();
+        uint64_t key = cur.get<uint64_t>();
+        if (natoms <= atom or natoms <= key)
+            throw SyntaxException(TRACE_INFO, "Bad atom index in snapshot");
+        vrecs[i] = {atom, key, cur.p};
+        get_type(cur);
+        uint8_t kind = cur.get<uint8_t>();
+        uint32_t n = cur.get<uint32_t>();
+        if (KIND_FLOAT == kind)
+            cur.skip(n * sizeof(double));
+        else if (KIND_SEXPR == kind)
+            cur.skip(n);
+        else if (KIND_STRING == kind)
+            for (uint32_t j = 0; j < n; j++)
+                cur.skip(cur.get<uint32_t>());
+        else
+            throw SyntaxException(TRACE_INFO, "Bad value kind in snapshot");
+    }
+
+    // Create the atoms. Each slot is written by exactly one thread.
+    std::vector<Handle> handles(natoms);
+    for (const std::vector<uint64_t>& lv : levels)
+    {
+        parallel_for(lv.size(), nthreads, [&](size_t j) {
+            uint64_t i = lv[j];
+            Cursor c(recs[i], mf.base + mf.size);
+            Type t = get_type(c);
+            uint8_t kind = c.get<uint8_t>();
+            uint32_t n = c.get<uint32_t>();
+            if (KIND_NODE == kind)
+            {
+                handles[i] = as->add_node(t, std::string(c.skip(n), n));
+                return;
+            }
+            HandleSeq oset;
+            oset.reserve(n);
+            for (uint32_t k = 0; k < n; k++)
+                oset.push_back(handles[c.get<uint64_t>()]);
+            handles[i] = as->add_link(t, std::move(oset));
+        });
+    }
+
+    // Attach the values. A value that cannot be rebuilt, such as a
+    // stream saved by an older version, is skipped, not the whole load.
+    std::atomic_size_t nskipped(0);
+    std::vector<char> loaded(nvalues, false);
+    parallel_for(nvalues, nthreads, [&](size_t i) {
+        const ValueRec& vr = vrecs[i];
+        Cursor c(vr.rec, mf.base + mf.size);
+        Type t = get_type(c);
+        uint8_t kind = c.get<uint8_t>();
+        uint32_t n = c.get<uint32_t>();
+        std::vector<double> dv;
+        std::vector<std::string> sv;
+        std::string sx;
+        if (KIND_FLOAT == kind)
+        {
+            dv.resize(n);
+            memcpy(dv.data(), c.skip(n * sizeof(double)), n * sizeof(double));
+        }
+        else if (KIND_SEXPR == kind)
+            sx.assign(c.skip(n), n);
+        else
+        {
+            sv.reserve(n);
+            for (uint32_t k = 0; k < n; k++)
+            {
+                uint32_t len = c.get<uint32_t>();
+                sv.emplace_back(c.skip(len), len);
+            }
+        }
+
+        ValuePtr v;
+        try
+        {
+            size_t pos = 0;
+            if (KIND_FLOAT == kind)
+                v = valueserver().create(t, std::move(dv));
+            else if (KIND_SEXPR == kind)
+                v = Sexpr::decode_value(sx, pos);
+            else
+                v = valueserver().create(t, std::move(sv));
+        }
+        catch (const std::exception&)
+        {
+            nskipped++;
+            return;
+        }
+        as->set_value(handles[vr.atom], handles[vr.key], v);
+        loaded[i] = true;
+    });
+    if (nskipped)
+        logger().info("[AtomSnapshot] skipped %zu values that could not "
+                      "be rebuilt", nskipped.load());
+
+    // Publish from this thread, in file order, which puts each atom
+    // after its outgoing set.
+    if (feed and feed->active())
+    {
+        feed->begin_batch();
+        try {
+            for (const Handle& h : handles)
+                feed->atom_added(h);
+            for (size_t i = 0; i < nvalues; i++)
+            {
+                if (not loaded[i]) continue;
+                const ValueRec& vr = vrecs[i];
+                const Handle& h = handles[vr.atom];
+                const Handle& key = handles[vr.key];
+                feed->value_changed(h, key, h->getValue(key));
+            }
+        }
+        catch (...) {
+            feed->end_batch();
+            throw;
+        }
+        feed->end_batch();
+    }
+
+    return natoms;
+}
+
+AtomSpacePtr AtomSnapshot::copy(const AtomSpacePtr& as)
+{
+    HandleSeq all;
+    as->get_handles_by_type(all, ATOM, true);
+
+    AtomSpacePtr cp = createAtomSpace();
+    for (const Handle& h : all)
+    {
+        Handle ch(cp->add_atom(h));
+
+        // Values are not changed in place, but replaced; holding on
+        // to the same ones is enough.
+        for (const Handle& key : h->getKeys())
+        {
+            ValuePtr v = h->getValue(key);
+            if (v) cp->set_value(ch, cp->add_atom(key), v);
+        }
+    }
+    cp->set_read_only();
+    return cp;
+}
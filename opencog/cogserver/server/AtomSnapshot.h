@@ -0,0 +1,79 @@
+/*
+ * opencog/cogserver/server/AtomSnapshot.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_ATOM_SNAPSHOT_H
+#define _OPENCOG_ATOM_SNAPSHOT_H
+
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+class ChangeFeed;
+
+/**
+ * Compact binary snapshots of an AtomSpace, for fast restarts.
+ *
+ * The file holds a table of type names, then every atom in the
+ * AtomSpace, and then the values attached to those atoms. Each link
+ * is written after all of the atoms in its outgoing set, and refers
+ * to them by their position in the file. Thus, nothing has to be
+ * parsed or looked up by name during a load. Float and string values
+ * are saved as such; other values as their s-expressions, as in the
+ * deltas and the write-ahead log. Values that have none, such as
+ * streams, are skipped.
+ *
+ * To load, the file is mapped into memory and indexed, and then the
+ * atoms are created in parallel, one level at a time: first all of
+ * the nodes, then all links that hold only nodes, and so on.
+ *
+ * The file is in host byte order; it is meant for restarting a server
+ * on the same machine, not for data exchange.
+ *
+ * copy() makes an in-memory snapshot instead: a separate, read-only
+ * AtomSpace holding copies of the atoms and their values.
+ */
+class AtomSnapshot
+{
+public:
+    /** Write the contents of the AtomSpace to `path`.
+     *  Returns the number of atoms written. Throws on I/O error.
+     *  The number of values skipped is logged, or, if `nskipped` is
+     *  given, stored there instead; a forked child must not log. */
+    static size_t save(const AtomSpacePtr&, const std::string& path,
+                       size_t* nskipped = nullptr);
+
+    /** Load a snapshot written by save() into the AtomSpace, using
+     *  up to `nthreads` threads. Returns the number of atoms loaded.
+     *  Throws if the file can't be read, or is not a snapshot. Values
+     *  that cannot be rebuilt are skipped, and counted in the log. If a
+     *  feed is given, and active, every atom and value loaded is
+     *  published to it, as one batch, once the load is done. */
+    static size_t load(const AtomSpacePtr&, const std::string& path,
+                       unsigned int nthreads, ChangeFeed* = nullptr);
+
+    /** Copy every atom in the AtomSpace, with its values, into a new
+     *  AtomSpace, and make that read-only. Writers are not stopped
+     *  here; changes made during the copy may or may not be in it,
+     *  unless the caller pauses them. It does not change afterwards. */
+    static AtomSpacePtr copy(const AtomSpacePtr&);
+
+    /** Rename the file `tmp` to `path`, after flushing it to disk, and
+     *  then flush the directory, so that after a crash there is either
+     *  the old file or the whole new one. Throws on error. */
+    static void commit_file(const std::string& tmp, const std::string& path);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_ATOM_SNAPSHOT_H
@@ -0,0 +1,369 @@
+/*
+ * opencog/cogserver/server/ChangeFeed.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+
+#include "ChangeFeed.h"
+
+using namespace opencog;
+
+ChangeFeed::Subscriber::Subscriber(size_t max_queue) :
+    _max(max_queue),
+    _dropped(0),
+    _total_dropped(0),
+    _all(false)
+{
+}
+
+void ChangeFeed::Subscriber::add_all(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _all = true;
+}
+
+void ChangeFeed::Subscriber::add_type(Type t, bool subtypes)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _types.push_back({t, subtypes});
+}
+
+void ChangeFeed::Subscriber::add_key(const Handle& key)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _keys.push_back(key);
+}
+
+void ChangeFeed::Subscriber::add_root(const Handle& root)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _roots.push_back(root);
+}
+
+void ChangeFeed::Subscriber::clear_filters(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _all = false;
+    _types.clear();
+    _keys.clear();
+    _roots.clear();
+}
+
+std::string ChangeFeed::Subscriber::describe(void) const
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    std::string rc;
+    if (_all) rc += "all\n";
+    for (const auto& pr : _types)
+        rc += "type " + nameserver().getTypeName(pr.first) +
+              (pr.second ? " subtypes\n" : "\n");
+    for (const Handle& h : _keys)
+        rc += "key " + Sexpr::encode_atom(h) + "\n";
+    for (const Handle& h : _roots)
+        rc += "root " + Sexpr::encode_atom(h) + "\n";
+    if (0 == rc.size()) rc = "no filters\n";
+    return rc;
+}
+
+/// True if `root` is `h`, or appears anywhere in its outgoing tree.
+static bool is_under(const Handle& h, const Handle& root)
+{
+    if (h == root) return true;
+    if (not h->is_link()) return false;
+    for (const Handle& ho : h->getOutgoingSet())
+        if (is_under(ho, root)) return true;
+    return false;
+}
+
+/// Must be called with _mtx held.
+bool ChangeFeed::Subscriber::matches(Kind kind, const Handle& atom,
+                                     const Handle& key) const
+{
+    if (_all) return true;
+
+    Type t = atom->get_type();
+    for (const auto& pr : _types)
+    {
+        if (t == pr.first) return true;
+        if (pr.second and nameserver().isA(t, pr.first)) return true;
+    }
+
+    if (VALUE_CHANGED == kind and
+        std::find(_keys.begin(), _keys.end(), key) != _keys.end())
+        return true;
+
+    for (const Handle& root : _roots)
+        if (is_under(atom, root)) return true;
+
+    return false;
+}
+
+/// Must be called with _mtx held. Returns false if dropped.
+bool ChangeFeed::Subscriber::push(const Line& line)
+{
+    if (_max <= _queue.size())
+    {
+        _dropped++;
+        _total_dropped++;
+        return false;
+    }
+    _queue.push_back(line);
+    return true;
+}
+
+std::string ChangeFeed::Subscriber::drain(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    std::string rc;
+    if (0 < _dropped)
+    {
+        rc = "(dropped " + std::to_string(_dropped) + ")\n";
+        _dropped = 0;
+    }
+    for (const Line& line : _queue)
+        rc += *line;
+    _queue.clear();
+    return rc;
+}
+
+/* ============================================================== */
+
+// The batch that the current thread is publishing, if any, and the
+// last write-ahead log position that it has to wait for.
+static thread_local int batch_depth = 0;
+static thread_local uint64_t batch_pos = 0;
+
+ChangeFeed::ChangeFeed(void) :
+    _nsubscribers(0),
+    _nevents(0),
+    _ndelivered(0),
+    _ndropped(0),
+    _nlisteners(0),
+    _log(nullptr),
+    _wal(nullptr)
+{
+}
+
+ChangeFeed::SubscriberPtr ChangeFeed::subscribe(void)
+{
+    size_t max = config().get_int("SUBSCRIBE_QUEUE_MAX", 10000);
+    SubscriberPtr sub = std::make_shared<Subscriber>(max);
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    _subscribers.push_back(sub);
+    _nsubscribers = _subscribers.size();
+    return sub;
+}
+
+void ChangeFeed::unsubscribe(const SubscriberPtr& sub)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    auto it = std::find(_subscribers.begin(), _subscribers.end(), sub);
+    if (it != _subscribers.end()) _subscribers.erase(it);
+    _nsubscribers = _subscribers.size();
+}
+
+void ChangeFeed::add_listener(const std::string& name, Listener cb)
+{
+    std::lock_guard<std::mutex> lck(_listen_mtx);
+    _listeners[name] = cb;
+    _nlisteners = _listeners.size();
+}
+
+void ChangeFeed::remove_listener(const std::string& name)
+{
+    std::lock_guard<std::mutex> lck(_listen_mtx);
+    _listeners.erase(name);
+    _nlisteners = _listeners.size();
+}
+
+static std::string encode(ChangeFeed::Kind kind, const Handle& atom,
+                          const Handle& key, const ValuePtr& v)
+{
+    switch (kind)
+    {
+        case ChangeFeed::ATOM_ADDED:
+            return "(atom-added " + Sexpr::encode_atom(atom) + ")\n";
+        case ChangeFeed::ATOM_REMOVED:
+            return "(atom-removed " + Sexpr::encode_atom(atom) + ")\n";
+        case ChangeFeed::VALUE_CHANGED:
+            return "(value-changed " + Sexpr::encode_atom(atom) + " " +
+                Sexpr::encode_atom(key) + " " +
+                (v ? Sexpr::encode_value(v) : std::string("#f")) + ")\n";
+    }
+    return "";
+}
+
+void ChangeFeed::publish(Kind kind, const Handle& atom,
+                         const Handle& key, const ValuePtr& v)
+{
+    if (nullptr == atom) return;
+
+    // Encoding is deferred until some subscriber wants the event,
+    // and then done only once, no matter how many want it.
+    Subscriber::Line line;
+    uint64_t wal_pos = 0;
+
+    std::unique_lock<std::mutex> lck(_mtx);
+
+    // The logs are appended to under the same lock, so that they hold
+    // the events in the order in which they were published. A failed
+    // write-ahead log throws; do that before anyone else hears of it.
+    bool logging = _log and _log->enabled();
+    bool wal = _wal and _wal->enabled();
+    if (logging or wal)
+        line = std::make_shared<const std::string>(
+            encode(kind, atom, key, v));
+    if (wal) wal_pos = _wal->append(*line);
+    if (logging) _log->append(*line);
+
+    bool counted = false;
+    for (const SubscriberPtr& sub : _subscribers)
+    {
+        std::lock_guard<std::mutex> slck(sub->_mtx);
+        if (not sub->matches(kind, atom, key)) continue;
+
+        if (nullptr == line)
+            line = std::make_shared<const std::string>(
+                encode(kind, atom, key, v));
+        if (not counted)
+        {
+            counted = true;
+            _nevents++;
+        }
+        if (sub->push(line)) _ndelivered++;
+        else _ndropped++;
+    }
+    lck.unlock();
+
+    if (_nlisteners)
+    {
+        std::lock_guard<std::mutex> llck(_listen_mtx);
+        for (const auto& pr : _listeners)
+            pr.second(kind, atom, key, v);
+    }
+
+    // Wait outside of the lock, so that concurrent writers can share
+    // one commit.
+    if (wal)
+    {
+        if (0 < batch_depth) batch_pos = std::max(batch_pos, wal_pos);
+        else _wal->wait_durable(wal_pos);
+    }
+}
+
+void ChangeFeed::begin_batch(void)
+{
+    batch_depth++;
+}
+
+void ChangeFeed::end_batch(void)
+{
+    if (0 < batch_depth) batch_depth--;
+    if (0 < batch_depth or 0 == batch_pos) return;
+
+    uint64_t pos = batch_pos;
+    batch_pos = 0;
+    _wal->wait_durable(pos);
+}
+
+/* ============================================================== */
+
+std::string ChangeFeed::next_expr(const std::string& s, size_t& pos)
+{
+    pos = s.find_first_not_of(" \t", pos);
+    if (std::string::npos == pos)
+        throw SyntaxException(TRACE_INFO, "Missing argument: %.80s",
+                              s.c_str());
+
+    size_t beg = pos;
+    if ('(' != s[pos])
+    {
+        pos = s.find_first_of(" \t)", pos);
+        if (std::string::npos == pos) pos = s.size();
+        return s.substr(beg, pos - beg);
+    }
+
+    int depth = 0;
+    bool in_string = false;
+    bool escape = false;
+    for (; pos < s.size(); pos++)
+    {
+        char c = s[pos];
+        if (in_string)
+        {
+            if (escape) escape = false;
+            else if ('\\' == c) escape = true;
+            else if ('"' == c) in_string = false;
+            continue;
+        }
+        if ('"' == c) in_string = true;
+        else if ('(' == c) depth++;
+        else if (')' == c and 0 == --depth)
+        {
+            pos++;
+            return s.substr(beg, pos - beg);
+        }
+    }
+    throw SyntaxException(TRACE_INFO, "Unbalanced expression: %.80s",
+                          s.c_str());
+}
+
+void ChangeFeed::apply(const AtomSpacePtr& as, const std::string& ev)
+{
+    size_t pos = ev.find_first_of(" ");
+    if ('(' != ev[0] or std::string::npos == pos)
+        throw SyntaxException(TRACE_INFO, "Not a change: %.80s",
+                              ev.c_str());
+    std::string kind(ev, 1, pos - 1);
+
+    Handle h(Sexpr::decode_atom(next_expr(ev, pos)));
+    if (kind == "atom-removed")
+    {
+        // A recursive extract is published as one event.
+        h = as->get_atom(h);
+        if (h and as->extract_atom(h, true)) atom_removed(h);
+        return;
+    }
+
+    h = as->add_atom(h);
+    if (kind == "atom-added")
+    {
+        atom_added(h);
+    }
+    else if (kind == "value-changed")
+    {
+        Handle key(as->add_atom(Sexpr::decode_atom(next_expr(ev, pos))));
+        std::string vstr(next_expr(ev, pos));
+        ValuePtr v;
+        if (vstr != "#f")
+        {
+            size_t vpos = 0;
+            v = Sexpr::decode_value(vstr, vpos);
+        }
+        as->set_value(h, key, v);
+        value_changed(h, key, v);
+    }
+    else
+        throw SyntaxException(TRACE_INFO, "Unknown change: %.80s",
+                              ev.c_str());
+}
+
+std::string ChangeFeed::display_stats(void)
+{
+    char buff[180];
+    snprintf(buff, sizeof(buff),
+        "subscribers: %zu  events: %zu  delivered: %zu  dropped: %zu\n",
+        _nsubscribers.load(), _nevents.load(), _ndelivered.load(),
+        _ndropped.load());
+    return buff;
+}
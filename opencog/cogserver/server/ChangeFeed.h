@@ -0,0 +1,181 @@
+/*
+ * opencog/cogserver/server/ChangeFeed.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_CHANGE_FEED_H
+#define _OPENCOG_CHANGE_FEED_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/ReplicationLog.h>
+#include <opencog/cogserver/server/WriteAheadLog.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Push notifications of AtomSpace changes to interested clients.
+ *
+ * Code that changes the AtomSpace on behalf of network clients calls
+ * atom_added(), atom_removed() or value_changed(). Each event is
+ * checked against the filters of every subscriber; if any match, the
+ * event is encoded, once, as a single line of s-expression text, and
+ * the same string is queued for each matching subscriber:
+ *
+ *   (atom-added <atom>)
+ *   (atom-removed <atom>)
+ *   (value-changed <atom> <key> <value>)
+ *
+ * Each subscriber has a bounded queue. When it is full, new events
+ * for that subscriber are dropped and counted, and the next time it
+ * is drained, a `(dropped <count>)` line tells the client how many
+ * events it missed.
+ *
+ * If a ReplicationLog or a WriteAheadLog is attached and enabled,
+ * every event is also appended to it, whether or not any subscriber
+ * wants it. In sync mode, publishing waits until the write-ahead log
+ * has the event on disk. If the write-ahead log has failed, publishing
+ * throws an IOException, as does end_batch().
+ *
+ * Modules that need the atoms themselves, rather than text, can add
+ * a listener; it is called, in the publishing thread, for every event.
+ *
+ * When there are no subscribers, listeners or logs, publishing costs
+ * a handful of atomic loads.
+ */
+class ChangeFeed
+{
+public:
+    enum Kind { ATOM_ADDED, ATOM_REMOVED, VALUE_CHANGED };
+
+    class Subscriber
+    {
+        friend class ChangeFeed;
+        typedef std::shared_ptr<const std::string> Line;
+
+        mutable std::mutex _mtx;
+        std::deque<Line> _queue;
+        size_t _max;
+        size_t _dropped;
+        size_t _total_dropped;
+
+        // Filters; an event is delivered if any one of them matches.
+        bool _all;
+        std::vector<std::pair<Type, bool>> _types;
+        HandleSeq _keys;
+        HandleSeq _roots;
+
+        bool matches(Kind, const Handle& atom, const Handle& key) const;
+        bool push(const Line&);
+
+    public:
+        Subscriber(size_t max_queue);
+
+        void add_all(void);
+        void add_type(Type, bool subtypes);
+        void add_key(const Handle&);
+        void add_root(const Handle&);
+        void clear_filters(void);
+        std::string describe(void) const;
+
+        /// Return everything queued so far, oldest first, with a
+        /// drop notice in front, if anything was dropped.
+        std::string drain(void);
+    };
+    typedef std::shared_ptr<Subscriber> SubscriberPtr;
+
+    /// Called with the kind of change, the atom, and, for
+    /// VALUE_CHANGED, the key and the new value.
+    typedef std::function<void(Kind, const Handle&, const Handle&,
+                               const ValuePtr&)> Listener;
+
+private:
+    std::mutex _mtx;
+    std::vector<SubscriberPtr> _subscribers;
+    std::atomic_size_t _nsubscribers;
+
+    std::atomic_size_t _nevents;
+    std::atomic_size_t _ndelivered;
+    std::atomic_size_t _ndropped;
+
+    // Held while listeners run, so that remove_listener() does not
+    // return while the module's code is still in use.
+    std::mutex _listen_mtx;
+    std::map<std::string, Listener> _listeners;
+    std::atomic_size_t _nlisteners;
+
+    ReplicationLog* _log;
+    WriteAheadLog* _wal;
+
+    void publish(Kind, const Handle&, const Handle&, const ValuePtr&);
+
+public:
+    ChangeFeed(void);
+
+    SubscriberPtr subscribe(void);
+    void unsubscribe(const SubscriberPtr&);
+
+    void add_listener(const std::string& name, Listener);
+    void remove_listener(const std::string& name);
+
+    /** True if anyone is listening. Publishers can check this to
+     *  avoid work that only serves to publish an event. */
+    bool active(void) const {
+        return _nsubscribers or _nlisteners or
+            (_log and _log->enabled()) or (_wal and _wal->enabled());
+    }
+
+    /** Publish a batch of changes from this thread. Until the
+     *  matching end_batch(), publishing does not wait for the
+     *  write-ahead log; end_batch() waits once, for all of them.
+     *  Batches may nest. */
+    void begin_batch(void);
+    void end_batch(void);
+
+    /** Split off the next s-expression, or bare token, starting at
+     *  `pos`, and move `pos` past it. Throws on bad syntax. */
+    static std::string next_expr(const std::string&, size_t& pos);
+
+    /** Also append every event to this log, when it is enabled. */
+    void set_log(ReplicationLog* log) { _log = log; }
+    void set_wal(WriteAheadLog* wal) { _wal = wal; }
+
+    /** Apply one event, in the form published here, to the AtomSpace,
+     *  and publish it again. Used to replay logs. Throws on bad
+     *  syntax. */
+    void apply(const AtomSpacePtr&, const std::string&);
+
+    void atom_added(const Handle& h) {
+        if (active()) publish(ATOM_ADDED, h, Handle::UNDEFINED, nullptr);
+    }
+    void atom_removed(const Handle& h) {
+        if (active()) publish(ATOM_REMOVED, h, Handle::UNDEFINED, nullptr);
+    }
+    void value_changed(const Handle& h, const Handle& key, const ValuePtr& v) {
+        if (active()) publish(VALUE_CHANGED, h, key, v);
+    }
+
+    /** One line: subscriber count, events encoded, delivered, dropped. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_CHANGE_FEED_H
@@ -13,6 +13,11 @@
 #include <sys/time.h>
 #include <sys/prctl.h>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <opencog/util/Config.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/misc.h>
 #include <opencog/util/platform.h>
@@ -20,8 +25,10 @@
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/network/NetworkServer.h>
 
+#include <opencog/cogserver/server/AtomIngest.h>
 #include <opencog/cogserver/server/ServerConsole.h>
 #include <opencog/cogserver/server/WebServer.h>
+#include <opencog/cogserver/server/WorkerPool.h>
 
 #include "CogServer.h"
 #include "BaseServer.h"
@@ -33,6 +40,7 @@ CogServer::~CogServer()
     logger().debug("[CogServer] enter destructor");
     disableWebServer();
     disableNetworkServer();
+    WorkerPool::stop_reports();
     logger().debug("[CogServer] exit destructor");
 }
 
@@ -40,18 +48,28 @@ CogServer::CogServer(void) :
     BaseServer(),
     _consoleServer(nullptr),
     _webServer(nullptr),
-    _running(false)
+    _idleCollector(*this),
+    _replica(_changeFeed),
+    _running(false),
+    _nloads(0)
 {
 	set_max_open_sockets();
+	_changeFeed.set_log(&_replicationLog);
+	_changeFeed.set_wal(&_wal);
 }
 
 CogServer::CogServer(AtomSpacePtr as) :
     BaseServer(as),
     _consoleServer(nullptr),
     _webServer(nullptr),
-    _running(false)
+    _idleCollector(*this),
+    _replica(_changeFeed),
+    _running(false),
+    _nloads(0)
 {
 	set_max_open_sockets();
+	_changeFeed.set_log(&_replicationLog);
+	_changeFeed.set_wal(&_wal);
 }
 
 /// Allow at most `max_open_socks` concurrent connections.
@@ -116,11 +134,17 @@ void CogServer::serverLoop()
 {
     prctl(PR_SET_NAME, "cogserv:loop", 0, 0, 0);
     logger().info("Starting CogServer loop.");
+    _idleCollector.start();
+    if (config().has("REPLICATE_FROM"))
+        follow(config().get("REPLICATE_FROM"));
     while (_running)
     {
         while (0 < getRequestQueueSize())
             runLoopStep();
 
+        // Unmap any module libraries left over from a reload.
+        reclaimModules(*this);
+
         // XXX FIXME. terrible terrible hack. What we should be
         // doing is running in our own thread, waiting on a semaphore,
         // until some request is queued. Spinning is .. just wrong.
@@ -138,6 +162,10 @@ void CogServer::serverLoop()
     while (0 < getRequestQueueSize())
         processRequests();
 
+    _idleCollector.stop();
+    _replica.stop();
+    _wal.close();
+
     // We need to clean up in the same thread where we are looping;
     // doing this in other threads, e.g. the thread that calls stop()
     // or the thread that calls disableNetworkServer() will lead to
@@ -158,12 +186,127 @@ void CogServer::runLoopStep(void)
         processRequests();
 }
 
+std::string CogServer::ingest(const std::string& path)
+{
+    int nthreads = config().get_int("INGEST_THREADS",
+        std::max(1u, std::thread::hardware_concurrency()));
+    if (nthreads < 1)
+        throw InvalidParamException(TRACE_INFO,
+            "INGEST_THREADS must be at least 1, not %d", nthreads);
+
+    AtomIngest::Counters cnt;
+    cnt.bytes = 0;
+    cnt.exprs = 0;
+    cnt.values = 0;
+    cnt.errors = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    AtomIngest::load(_atomSpace, path, nthreads, cnt, &_changeFeed);
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+             "Ingested %zu atoms and %zu values (%zu errors) from %s in "
+             "%.3f seconds; %.1f MB/s, %.0f atoms/s (%d threads)\n",
+             cnt.exprs.load(), cnt.values.load(), cnt.errors.load(),
+             path.c_str(),
+             secs.count(), (cnt.bytes / 1048576.0) / secs.count(),
+             cnt.exprs / secs.count(), nthreads);
+    logger().info("%s", buf);
+    return buf;
+}
+
+std::string CogServer::follow(const std::string& leader)
+{
+    if (0 == leader.size())
+    {
+        if (not _replica.running()) return "Not following any leader\n";
+        _replica.stop();
+        return "Stopped following\n";
+    }
+
+    std::string host(leader);
+    int port = 17001;
+    size_t colon = leader.rfind(':');
+    if (std::string::npos != colon)
+    {
+        host = leader.substr(0, colon);
+        port = atoi(leader.c_str() + colon + 1);
+        if (port <= 0 or 65535 < port)
+            throw InvalidParamException(TRACE_INFO,
+                "Invalid port in \"%s\"", leader.c_str());
+    }
+
+    _replica.start(_atomSpace, host, port);
+    return "Following " + host + ":" + std::to_string(port) + "\n";
+}
+
+std::string CogServer::openWAL(void)
+{
+    std::string path = config().get("WAL_FILE", "");
+    if (0 == path.size()) return "";
+
+    std::string report = _wal.recover(path, _atomSpace, _changeFeed);
+    _wal.open(path);
+    return report;
+}
+
+bool CogServer::checkUnpublished(const std::string& shell,
+                                 std::string& msg)
+{
+    msg.clear();
+    if (not _changeFeed.active()) return true;
+
+    std::string policy = config().get("UNPUBLISHED_SHELLS", "warn");
+    if (policy == "allow") return true;
+    if (policy == "refuse")
+    {
+        msg = "Error: the " + shell + " shell is disabled: its changes "
+              "would not reach the write-ahead log, followers, delta "
+              "checkpoints or subscribers\n";
+        logger().warn("Refused to open the %s shell; UNPUBLISHED_SHELLS "
+                      "is \"refuse\"", shell.c_str());
+        return false;
+    }
+
+    msg = "Warning: changes made in the " + shell + " shell do not "
+          "reach the write-ahead log, followers, delta checkpoints or "
+          "subscribers; use the sexpr shell for writes\n";
+    logger().warn("Opened the %s shell; its changes are not published",
+                  shell.c_str());
+    return true;
+}
+
 std::string CogServer::display_stats(void)
 {
-    if (_consoleServer)
-        return _consoleServer->display_stats();
-    else
+    if (not _consoleServer)
         return "Console server is not running";
+
+    std::string rc = _consoleServer->display_stats() +
+               _idleCollector.display_stats() +
+               _changeFeed.display_stats() +
+               _replicationLog.display_stats() +
+               _replica.display_stats() +
+               _wal.display_stats();
+
+    std::lock_guard<std::mutex> lck(_stats_mtx);
+    for (const auto& st : _stats)
+        rc += st.second();
+    return rc + WorkerPool::display_stats();
+}
+
+void CogServer::addStats(const std::string& name,
+                         std::function<std::string()> fn)
+{
+    std::lock_guard<std::mutex> lck(_stats_mtx);
+    _stats[name] = fn;
+}
+
+void CogServer::removeStats(const std::string& name)
+{
+    std::lock_guard<std::mutex> lck(_stats_mtx);
+    _stats.erase(name);
 }
 
 std::string CogServer::display_web_stats(void)
@@ -187,6 +330,38 @@ std::string CogServer::stats_legend(void)
        "  tot-lines: total number of newlines received by all shells.\n"
        "  cpu user sys: number of CPU seconds used by server.\n"
        "  maxrss: resident set size, in KB. Taken from `getrusage`.\n"
+       "  idle-gc: garbage collections run while the server was idle,\n"
+       "      per language runtime, and the total, average and longest\n"
+       "      pause taken by them.\n"
+       "  subscribers: number of open change-feed subscriptions, the\n"
+       "      number of AtomSpace changes sent to at least one of them,\n"
+       "      and the number of deliveries, and drops due to full queues.\n"
+       "  repl-log: on a replication leader, the newest sequence number\n"
+       "      in the change log, the number of entries held, and the\n"
+       "      number of connected followers.\n"
+       "  replica-of: on a follower, the leader, the last sequence number\n"
+       "      applied, the leader's newest one, the lag between the two,\n"
+       "      and the time since anything was heard from the leader.\n"
+       "  wal: the write-ahead log durability and commit window, the\n"
+       "      number of changes logged and the rate since it was opened,\n"
+       "      the number of fsyncs, changes per fsync, and fsync times.\n"
+       "  checkpoint: when the last background checkpoint finished, the\n"
+       "      number of atoms written, how long it took, and how much\n"
+       "      memory was copied-on-write while it ran; how long the\n"
+       "      current one has been running; and how many succeeded and\n"
+       "      failed, with the reason for the last failure.\n"
+       "  deltas: atoms changed and removed since the last checkpoint,\n"
+       "      the number of deltas after the base, the number written,\n"
+       "      and the size of the last one, and the time it took.\n"
+       "      This line and the one before come from libcheckpoint.so.\n"
+       "  workers: when started with --workers, the number of worker\n"
+       "      processes, the one answering, and the supervisor pid;\n"
+       "      then, per worker: pid, seconds up, restarts, open sockets,\n"
+       "      lines received, CPU seconds, maxrss in KB, atoms, and the\n"
+       "      seconds since these were updated; then the totals for the\n"
+       "      pool, kept by the supervisor, which include the lines and\n"
+       "      CPU time of workers since restarted. In a worker, the\n"
+       "      rest of `stats` is for that worker alone.\n"
        "\n"
        "The table shows a list of the currently open connections.\n"
        "The table header has the following form:\n"
@@ -197,12 +372,17 @@ std::string CogServer::stats_legend(void)
        "  STATE -- several states possible; `iwait` means waiting for input.\n"
        "  NLINE -- number of newlines received by the shell.\n"
        "  LAST-ACTIVITY -- the last time anything was received.\n"
-       "  K -- socket kind. `T` for telnet, `W` for WebSocket.\n"
+       "  K -- socket kind. `T` for telnet, `W` for WebSocket,\n"
+       "       `Z` for zstd-compressed telnet.\n"
        "  U -- use count. The number of active handlers for the socket.\n"
        "  SHEL -- the current shell processor for the socket.\n"
        "  QZ -- size of the unprocessed (pending) request queue.\n"
        "  E -- `T` if the shell evaluator is running, else `F`.\n"
        "  PENDG -- number of bytes of output not yet sent.\n"
+       "\n"
+       "Compressed connections get one more line each: the thread, the\n"
+       "zstd level, and the bytes received and sent, before and after\n"
+       "compression, with the ratio.\n"
        "\n";
 }
 
@@ -12,10 +12,24 @@
 #ifndef _OPENCOG_COGSERVER_H
 #define _OPENCOG_COGSERVER_H
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+
 #include <opencog/cogserver/server/Module.h>
 #include <opencog/cogserver/server/ModuleManager.h>
 #include <opencog/network/NetworkServer.h>
 #include <opencog/cogserver/server/BaseServer.h>
+#include <opencog/cogserver/server/AccessSampler.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+#include <opencog/cogserver/server/IdleCollector.h>
+#include <opencog/cogserver/server/ReadSnapshot.h>
+#include <opencog/cogserver/server/ReadThrough.h>
+#include <opencog/cogserver/server/ReplicaClient.h>
+#include <opencog/cogserver/server/ReplicationLog.h>
+#include <opencog/cogserver/server/WriteAheadLog.h>
 #include <opencog/cogserver/server/RequestManager.h>
 
 namespace opencog
@@ -54,8 +68,25 @@ class CogServer :
 protected:
     NetworkServer* _consoleServer;
     NetworkServer* _webServer;
+    IdleCollector _idleCollector;
+    ChangeFeed _changeFeed;
+    ReplicationLog _replicationLog;
+    ReplicaClient _replica;
+    WriteAheadLog _wal;
+    AccessSampler _hot;
     bool _running;
 
+    // Bumped by each snapshot load; see atomSpaceGeneration().
+    std::atomic_size_t _nloads;
+
+    // Lines added to `stats` by modules, by name.
+    std::mutex _stats_mtx;
+    std::map<std::string, std::function<std::string()>> _stats;
+
+    ReadSnapshot _readSnapshot;
+
+    ReadThroughSlot _readThrough;
+
     /** Protected; singleton instance! Bad things happen when there is
      * more than one. Alas. */
     CogServer(void);
@@ -106,6 +137,80 @@ public:
         return ModuleManager::loadModule(filename, *this);
     }
     void loadModules(void) { ModuleManager::loadModules(*this); }
+    bool reloadModule(const std::string& id) {
+        return ModuleManager::reloadModule(id, *this);
+    }
+
+    /**** Snapshot API ****/
+    /** Changes whenever the contents of the AtomSpace are replaced
+     *  wholesale: by a snapshot load, or by a full copy from a leader.
+     *  Anything set up for the old contents, such as a pre-warmed
+     *  evaluator, should be set up again. Replacing the AtomSpace
+     *  itself does not change this; compare getAtomSpace() too. */
+    size_t atomSpaceGeneration(void) const {
+        return _nloads + _replica.full_copies();
+    }
+
+    /** Call before loading a snapshot; see atomSpaceGeneration().
+     *  Snapshots are saved and loaded by the checkpoint module. */
+    void newAtomSpaceGeneration(void) { _nloads++; }
+
+    /** A read-only copy of the AtomSpace, for shells that want a view
+     *  that does not change under them; see ReadSnapshot. */
+    AtomSpacePtr readSnapshot(void) { return _readSnapshot.get(_atomSpace); }
+
+    /** Bulk-load a file of Atomese s-expressions, parsing it in
+     *  INGEST_THREADS threads. Returns a short report. Throws if the
+     *  file can't be read, or INGEST_THREADS is less than one. Safe
+     *  to call off the server loop; the `ingest` command does. */
+    std::string ingest(const std::string& path);
+
+    /** Garbage collection for the language runtimes, done while the
+     *  server is idle. Shell modules register their collectors here. */
+    IdleCollector& idleCollector(void) { return _idleCollector; }
+
+    /** AtomSpace change notifications. Code that changes the AtomSpace
+     *  for network clients publishes here; the `subscribe` shell
+     *  delivers the changes to its clients. */
+    ChangeFeed& changeFeed(void) { return _changeFeed; }
+
+    /** Shells whose writes do not go through the ChangeFeed (scheme,
+     *  python, json, msgpack) call this as they open. While anything
+     *  listens to the feed -- the write-ahead log, followers, delta
+     *  checkpoints, subscribers -- changes made in such a shell are
+     *  lost to it. Then, if UNPUBLISHED_SHELLS is "refuse", this
+     *  returns false, and the shell must not open; otherwise, a warning
+     *  is logged. Either way, `msg` is set to a line for the client,
+     *  or left empty, if there is nothing to say. */
+    bool checkUnpublished(const std::string& shell, std::string& msg);
+
+    /**** Replication API ****/
+    /** The log of changes sent to followers; see the `replicate`
+     *  shell. It is enabled when the first follower connects. */
+    ReplicationLog& replicationLog(void) { return _replicationLog; }
+
+    /** Make this server a follower of the leader at `host[:port]`.
+     *  An empty string stops following. Returns a short report. */
+    std::string follow(const std::string& leader);
+
+    /**** Write-ahead log API ****/
+    /** If WAL_FILE is set, replay it into the AtomSpace, and then
+     *  keep logging changes to it. Call once, at startup, before the
+     *  network servers are enabled. Returns a short report. */
+    std::string openWAL(void);
+
+    /** The log itself; the checkpoint module empties it. */
+    WriteAheadLog& writeAheadLog(void) { return _wal; }
+
+    /**** Read-through API ****/
+    /** The sexpr shell's commands call this before they read, so that
+     *  a read-through proxy, once it has installed itself here, can
+     *  fetch what they are about to read. */
+    ReadThroughSlot& readThrough(void) { return _readThrough; }
+
+    /** Counts of the atoms and keys most used by sexpr commands; see
+     *  the `hot` command. */
+    AccessSampler& accessSampler(void) { return _hot; }
 
     /** Return the logger */
     Logger &logger(void) { return opencog::logger(); }
@@ -113,6 +218,11 @@ public:
 
     /** Print human-readable stats about the cogserver */
     std::string display_stats(void);
+
+    /** Modules add their own lines to display_stats() here. The
+     *  function is called under a lock; removeStats() waits for it. */
+    void addStats(const std::string& name, std::function<std::string()>);
+    void removeStats(const std::string& name);
     std::string display_web_stats(void);
     static std::string stats_legend(void);
 
@@ -44,6 +44,7 @@
 #include <opencog/util/misc.h>
 
 #include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/WorkerPool.h>
 
 using namespace opencog;
 
@@ -65,11 +66,19 @@ static const char* DEFAULT_CONFIG_PATHS[] =
 static void usage(const char* progname)
 {
     std::cerr << "Usage: " << progname
-        << " [-p <console port>] [-w <webserver port>] [-c <config-file>] [-DOPTION=\"VALUE\"]\n\n"
+        << " [-p <console port>] [-w <webserver port>] [-c <config-file>] [-DOPTION=\"VALUE\"]\n"
+        << "    [-s|--snapshot <snapshot-file>] [--workers <N>]\n\n"
         << "If multiple config files are specified, then these are\n"
         << "loaded sequentially, with the values in later files\n"
         << "overwriting the earlier ones. -D Option values override\n"
-        << "the options in config files."
+        << "the options in config files.\n\n"
+        << "A snapshot file, written with the `snapshot` or `checkpoint`\n"
+        << "command, is loaded into the AtomSpace before the network ports\n"
+        << "are opened, followed by any deltas written after it.\n\n"
+        << "With --workers (or WORKERS in the config file), that many\n"
+        << "worker processes are forked, each with its own copy of the\n"
+        << "snapshot, all listening on the same ports. The first process\n"
+        << "only restarts workers that die."
         << std::endl;
 }
 
@@ -104,15 +113,23 @@ int main(int argc, char *argv[])
     int console_port = 17001;
     int webserver_port = 18080;
 
-    static const char *optString = "cp:w:D:h";
+    static const char *optString = "c:p:w:D:hs:";
+    static const struct option longOptions[] = {
+        {"snapshot", required_argument, nullptr, 's'},
+        {"workers",  required_argument, nullptr, 'W'},
+        {"help",     no_argument,       nullptr, 'h'},
+        {nullptr,    0,                 nullptr, 0}
+    };
     int c = 0;
+    std::string snapshotFile;
+    int nworkers = -1;
     std::vector<std::string> configFiles;
     std::vector<std::pair<std::string, std::string>> configPairs;
     std::string progname = argv[0];
 
     // parse command line
     while (true) {
-        c = getopt (argc, argv, optString);
+        c = getopt_long (argc, argv, optString, longOptions, nullptr);
         /* Detect end of options */
         if (c == -1) {
             break;
@@ -141,6 +158,10 @@ int main(int argc, char *argv[])
             console_port = atoi(optarg);
         } else if (c == 'w') {
             webserver_port = atoi(optarg);
+        } else if (c == 's') {
+            snapshotFile = optarg;
+        } else if (c == 'W') {
+            nworkers = atoi(optarg);
         } else {
             // unknown option (or help)
             usage(progname.c_str());
@@ -228,11 +249,56 @@ int main(int argc, char *argv[])
     signal(SIGTRAP, sighand);
     signal(SIGQUIT, sighand);
 
+    // Fork the workers before anything starts any threads; only the
+    // forking thread survives into the child.
+    if (nworkers < 0)
+        nworkers = config().get_int("WORKERS", 0);
+    if (0 < nworkers) {
+        try {
+            WorkerPool::start(nworkers);
+        } catch (const RuntimeException& e) {
+            std::cerr << e.get_message() << std::endl;
+            exit(1);
+        }
+    }
+
     CogServer& cogserve = cogserver();
 
     // Load modules specified in config
     cogserve.loadModules();
 
+    // Restore the AtomSpace before anyone can connect. Snapshots
+    // belong to the checkpoint module; it logs what it loaded.
+    if (0 < snapshotFile.size()) {
+        if (not cogserve.configModule("CheckpointModule",
+                                      "load " + snapshotFile)) {
+            std::cerr << "Unable to load snapshot " << snapshotFile
+                      << "; is libcheckpoint.so in MODULES? "
+                      << "See the log for details." << std::endl;
+            exit(1);
+        }
+    }
+
+    // Workers serve their own copies; changes made in one would not
+    // be seen by the others, and they cannot all append to one log.
+    if (WorkerPool::is_worker()) {
+        if (0 < config().get("WAL_FILE", "").size())
+            std::cerr << "Workers do not use the write-ahead log; "
+                      << "ignoring WAL_FILE" << std::endl;
+        if (config().get_bool("WORKERS_READ_ONLY", true))
+            cogserve.getAtomSpace()->set_read_only();
+        WorkerPool::start_reports(cogserve.getAtomSpace());
+    } else {
+        // Replay changes made since the AtomSpace was last saved.
+        try {
+            std::cerr << cogserve.openWAL();
+        } catch (const RuntimeException& e) {
+            std::cerr << "Unable to open the write-ahead log: "
+                      << e.get_message() << std::endl;
+            exit(1);
+        }
+    }
+
     // Enable the network server and run the server's main loop.
     if (0 < console_port)
         cogserve.enableNetworkServer(console_port);
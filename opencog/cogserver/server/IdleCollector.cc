@@ -0,0 +1,163 @@
+/*
+ * opencog/cogserver/server/IdleCollector.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <sys/prctl.h>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/network/GenericShell.h>
+#include <opencog/network/ServerSocket.h>
+#include <opencog/cogserver/server/RequestManager.h>
+
+#include "IdleCollector.h"
+
+using namespace opencog;
+
+IdleCollector::IdleCollector(RequestManager& rm) :
+    _requests(rm),
+    _thread(nullptr),
+    _stop(false),
+    _delay(500),
+    _full_delay(10000)
+{
+}
+
+IdleCollector::~IdleCollector()
+{
+    stop();
+}
+
+void IdleCollector::add_collector(const std::string& name, Collector fn)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _collectors[name] = GCStats{fn, 0, 0, 0.0, 0.0};
+}
+
+void IdleCollector::remove_collector(const std::string& name)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _collectors.erase(name);
+}
+
+void IdleCollector::start(void)
+{
+    if (_thread) return;
+    if (not config().get_bool("IDLE_GC", true)) return;
+
+    _delay = std::chrono::milliseconds(
+        config().get_int("IDLE_GC_DELAY", 500));
+    _full_delay = std::chrono::milliseconds(
+        config().get_int("IDLE_GC_FULL_DELAY", 10000));
+
+    _stop = false;
+    _thread = new std::thread(&IdleCollector::idle_loop, this);
+}
+
+void IdleCollector::stop(void)
+{
+    if (nullptr == _thread) return;
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _stop = true;
+    }
+    _cv.notify_all();
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+}
+
+/// Must be called with _mtx held.
+void IdleCollector::run_collectors(bool full)
+{
+    for (auto& pr : _collectors)
+    {
+        GCStats& st = pr.second;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            st.collect(full);
+        } catch (const std::exception& ex) {
+            logger().warn("[IdleCollector] %s collector failed: %s",
+                          pr.first.c_str(), ex.what());
+        }
+        std::chrono::duration<double, std::milli> ms =
+            std::chrono::steady_clock::now() - start;
+
+        if (full) st.nfull++; else st.nlight++;
+        st.total_ms += ms.count();
+        if (st.max_ms < ms.count()) st.max_ms = ms.count();
+
+        logger().debug("[IdleCollector] %s %s gc took %.2f ms",
+                       pr.first.c_str(), full ? "full" : "light", ms.count());
+    }
+}
+
+void IdleCollector::idle_loop(void)
+{
+    prctl(PR_SET_NAME, "cogserv:idlegc", 0, 0, 0);
+
+    // Poll often enough to notice the start of an idle period with
+    // reasonable accuracy, but not so often as to be a load.
+    auto tick = std::min(_delay / 4, std::chrono::milliseconds(100));
+    if (tick < std::chrono::milliseconds(10))
+        tick = std::chrono::milliseconds(10);
+
+    auto last_active = std::chrono::steady_clock::now();
+    size_t last_lines = ServerSocket::total_line_count;
+    bool light_done = false;
+    bool full_done = false;
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    while (not _stop)
+    {
+        _cv.wait_for(lck, tick);
+        if (_stop) break;
+
+        auto now = std::chrono::steady_clock::now();
+        size_t lines = ServerSocket::total_line_count;
+        if (lines != last_lines or
+            0 < _requests.getRequestQueueSize() or
+            0 < GenericShell::num_evaluating())
+        {
+            last_lines = lines;
+            last_active = now;
+            light_done = false;
+            full_done = false;
+            continue;
+        }
+
+        if (not full_done and _full_delay <= now - last_active)
+        {
+            run_collectors(true);
+            light_done = true;
+            full_done = true;
+        }
+        else if (not light_done and _delay <= now - last_active)
+        {
+            run_collectors(false);
+            light_done = true;
+        }
+    }
+}
+
+std::string IdleCollector::display_stats(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    std::string rc;
+    for (const auto& pr : _collectors)
+    {
+        const GCStats& st = pr.second;
+        size_t n = st.nlight + st.nfull;
+        char buff[180];
+        snprintf(buff, sizeof(buff),
+            "idle-gc %s: light: %zu  full: %zu  pause-tot: %.1f ms  "
+            "avg: %.2f ms  max: %.2f ms\n",
+            pr.first.c_str(), st.nlight, st.nfull, st.total_ms,
+            0 < n ? st.total_ms / n : 0.0, st.max_ms);
+        rc += buff;
+    }
+    return rc;
+}
@@ -0,0 +1,93 @@
+/*
+ * opencog/cogserver/server/IdleCollector.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_IDLE_COLLECTOR_H
+#define _OPENCOG_IDLE_COLLECTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+class RequestManager;
+
+/**
+ * Run garbage collection in the language runtimes (guile, python)
+ * while the server has nothing else to do, instead of leaving it to
+ * be triggered by allocation in the middle of some user's command.
+ *
+ * A background thread watches for idle periods: no queued requests,
+ * no shell evaluating anything, and no input received from any
+ * socket. After IDLE_GC_DELAY milliseconds of idleness, each
+ * registered collector is asked for a light (young-generation or
+ * incremental) collection; after IDLE_GC_FULL_DELAY milliseconds, for
+ * a full collection. Each is done at most once per idle period.
+ *
+ * Modules that host a language runtime register a collector when
+ * they are loaded, and remove it when they are unloaded.
+ */
+class IdleCollector
+{
+public:
+    /// Called with `full` set for a full collection.
+    typedef std::function<void(bool full)> Collector;
+
+private:
+    struct GCStats
+    {
+        Collector collect;
+        size_t nlight;
+        size_t nfull;
+        double total_ms;
+        double max_ms;
+    };
+
+    RequestManager& _requests;
+
+    // Held while a collector is running, so that remove_collector()
+    // does not return while the module's code is still in use.
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::map<std::string, GCStats> _collectors;
+
+    std::thread* _thread;
+    bool _stop;
+    std::chrono::milliseconds _delay;
+    std::chrono::milliseconds _full_delay;
+
+    void run_collectors(bool full);
+    void idle_loop(void);
+
+public:
+    IdleCollector(RequestManager&);
+    ~IdleCollector();
+
+    void add_collector(const std::string& name, Collector);
+    void remove_collector(const std::string& name);
+
+    /** Start and stop the background thread. Configured with
+     *  IDLE_GC, IDLE_GC_DELAY and IDLE_GC_FULL_DELAY. */
+    void start(void);
+    void stop(void);
+
+    /** Print GC counts and pause times, one line per collector. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_IDLE_COLLECTOR_H
@@ -44,6 +44,24 @@ namespace opencog
         return #MODNAME;                                              \
     }
 
+/**
+ * DECLARE_MODULE_DEPENDS -- Declare the modules that must be fully
+ * constructed before this one is. The argument is a comma-separated
+ * list of module ids or shared-library filenames. This is optional;
+ * modules that do not declare any dependencies may be constructed
+ * concurrently with other modules, when the server starts up.
+ *
+ * Example usage:
+ * @code
+ * DECLARE_MODULE(MyModule);
+ * DECLARE_MODULE_DEPENDS("libscheme-shell.so");
+ * @endcode
+ */
+#define DECLARE_MODULE_DEPENDS(DEPLIST)                               \
+    extern "C" const char* opencog_module_depends(void) {             \
+       return DEPLIST;                                                \
+    }
+
 /**
  * This class defines the base abstract class that should be extended
  * by all opencog modules.
@@ -89,6 +107,13 @@ namespace opencog
  * write a custom constructor and destructor and perhaps overwrite the
  * init() method (which is called by the cogserver) after the module's
  * initialization has finished and the meta-data properly set.
+ *
+ * When the server starts, the constructors of independent modules may
+ * run concurrently, in different threads. The init() methods are
+ * always called one at a time, in the order in which the modules are
+ * listed in the config file. Thus, commands should be registered in
+ * init(), and not in the constructor, so that they are registered in
+ * a deterministic order.
  */
 
 class CogServer;
@@ -116,11 +141,17 @@ public:
         static const char* s = "opencog_module_config";
         return s;
     }
+    static const char* depends_function_name(void)
+    {
+        static const char* s = "opencog_module_depends";
+        return s;
+    }
 
     typedef const char* IdFunction    (void);
     typedef Module*     LoadFunction  (CogServer&);
     typedef void        UnloadFunction(Module*);
     typedef bool        ConfigFunction(Module*, const char*);
+    typedef const char* DependsFunction(void);
 
     Module(CogServer& cs) : _cogserver(cs) {}
     virtual ~Module() {}
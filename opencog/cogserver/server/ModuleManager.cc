@@ -13,8 +13,12 @@
 
 #include <dlfcn.h>
 #include <unistd.h>
+#include <sys/resource.h>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <thread>
 
 #include <opencog/util/Config.h>
 #include <opencog/util/Logger.h>
@@ -23,11 +27,13 @@
 #include <opencog/util/misc.h>
 #include <opencog/util/platform.h>
 
+#include <opencog/cogserver/server/CogServer.h>
 #include "ModuleManager.h"
 
 using namespace opencog;
 
-ModuleManager::ModuleManager(void)
+ModuleManager::ModuleManager(void) :
+    _reloads(0)
 {
     // Give priority search order to the build directories.
     // Do NOT search these, if working from installed path!
@@ -39,6 +45,7 @@ ModuleManager::ModuleManager(void)
         module_paths.push_back(PROJECT_BINARY_DIR "/opencog/cogserver/modules/python");
         module_paths.push_back(PROJECT_BINARY_DIR "/opencog/cogserver/modules/");
         module_paths.push_back(PROJECT_BINARY_DIR "/opencog/cogserver/shell/");
+        module_paths.push_back(PROJECT_BINARY_DIR "/opencog/cogserver/checkpoint/");
     }
     module_paths.push_back(PROJECT_INSTALL_PREFIX "/lib/opencog/modules/");
 }
@@ -74,6 +81,11 @@ ModuleManager::~ModuleManager()
         }
     }
 
+    // Modules replaced by a reload are still alive.
+    for (auto& rpr : _retired)
+        (*rpr.second.unloadFunction)(rpr.second.module);
+    _retired.clear();
+
     logger().debug("[ModuleManager] exit destructor");
 }
 
@@ -99,15 +111,17 @@ static std::string get_filepath(const std::string& fullpath)
     return fullpath;
 }
 
-bool ModuleManager::loadAbsPath(const std::string& path,
-                               CogServer& cs)
+/// Milliseconds elapsed since `start`.
+static double elapsed_ms(const std::chrono::steady_clock::time_point& start)
 {
-    std::string fi = get_filename(path);
-    if (modules.find(fi) !=  modules.end()) {
-        logger().info("Module \"%s\" is already loaded.", fi.c_str());
-        return true;
-    }
+    std::chrono::duration<double, std::milli> ms =
+        std::chrono::steady_clock::now() - start;
+    return ms.count();
+}
 
+bool ModuleManager::openAbsPath(const std::string& path,
+                                ModuleData& mdata, bool deepbind)
+{
     // reset error
     dlerror();
 
@@ -122,7 +136,11 @@ bool ModuleManager::loadAbsPath(const std::string& path,
     }
     void *dynLibrary = dlopen(withRPath.c_str(), RTLD_LAZY | RTLD_GLOBAL);
 #else
-    void *dynLibrary = dlopen(path.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+    int flags = RTLD_LAZY | RTLD_GLOBAL;
+#ifdef RTLD_DEEPBIND
+    if (deepbind) flags = RTLD_LAZY | RTLD_LOCAL | RTLD_DEEPBIND;
+#endif
+    void *dynLibrary = dlopen(path.c_str(), flags);
 #endif
     const char* dlsymError = dlerror();
     if ((dynLibrary == NULL) || (dlsymError)) {
@@ -181,8 +199,22 @@ bool ModuleManager::loadAbsPath(const std::string& path,
         return false;
     }
 
-    // Load and init module
-    Module* module = (Module*) (*load_func)(cs);
+    // The dependency list is optional; most modules don't have one.
+    std::string depends;
+    Module::DependsFunction* depends_func =
+        (Module::DependsFunction*) dlsym(dynLibrary, Module::depends_function_name());
+    dlerror();
+    if (depends_func and (*depends_func)())
+        depends = (*depends_func)();
+
+    mdata = {nullptr, module_id, get_filename(path), get_filepath(path),
+             load_func, unload_func, config_func, dynLibrary, depends, 0.0};
+    return true;
+}
+
+void ModuleManager::registerModule(ModuleData& mdata)
+{
+    std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
 
     // Store two entries in the module map:
     //    1: filename => <struct module data>
@@ -191,16 +223,37 @@ bool ModuleManager::loadAbsPath(const std::string& path,
     // filename of another module (and vice-versa). This is probably
     // reasonable since most module filenames should have a .dll or
     // .dylib or .so suffix.
-    std::string i = module_id;
-    std::string f = get_filename(path);
-    std::string p = get_filepath(path);
-    ModuleData mdata = {module, i, f, p, load_func, unload_func,
-                        config_func, dynLibrary};
-    modules[i] = mdata;
-    modules[f] = mdata;
+    modules[mdata.id] = mdata;
+    modules[mdata.filename] = mdata;
 
     // after registration, call the module's init() method
-    module->init();
+    auto start = std::chrono::steady_clock::now();
+    mdata.module->init();
+
+    // Charge the init time to the module, too.
+    mdata.loadTime += elapsed_ms(start);
+    modules[mdata.id].loadTime = mdata.loadTime;
+    modules[mdata.filename].loadTime = mdata.loadTime;
+}
+
+bool ModuleManager::loadAbsPath(const std::string& path,
+                               CogServer& cs)
+{
+    std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
+    std::string fi = get_filename(path);
+    if (modules.find(fi) !=  modules.end()) {
+        logger().info("Module \"%s\" is already loaded.", fi.c_str());
+        return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ModuleData mdata;
+    if (not openAbsPath(path, mdata)) return false;
+
+    // Load and init module
+    mdata.module = (Module*) (*mdata.loadFunction)(cs);
+    mdata.loadTime = elapsed_ms(start);
+    registerModule(mdata);
 
     return true;
 }
@@ -210,8 +263,9 @@ bool ModuleManager::loadAbsPath(const std::string& path,
 std::string ModuleManager::listModules()
 {
     std::string rv =
-        "   Module Name           Library            Module Directory Path\n"
-        "   -----------           -------            ---------------------\n";
+        "   Module Name           Library            Load ms  Module Directory Path\n"
+        "   -----------           -------            -------  ---------------------\n";
+    std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
     for (const auto& modpr : modules)
     {
         // The list holds both lib.so's, and names.
@@ -229,8 +283,8 @@ std::string ModuleManager::listModules()
             trunc = "..." + trunc.substr(tlen-35);
 
         char buff[120];
-        snprintf(buff, 120, "%-21s %-18s %s\n", mdata.id.c_str(),
-                 mdata.filename.c_str(), trunc.c_str());
+        snprintf(buff, 120, "%-21s %-18s %7.1f  %s\n", mdata.id.c_str(),
+                 mdata.filename.c_str(), mdata.loadTime, trunc.c_str());
         rv += buff;
     }
 
@@ -241,24 +295,30 @@ std::string ModuleManager::listModules()
 
 bool ModuleManager::unloadModule(const std::string& moduleId)
 {
-    ModuleData mdata = getModuleData(moduleId);
+    ModuleData mdata;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
+        mdata = getModuleData(moduleId);
 
-    // Unable to find the module!
-    if (nullptr == mdata.module) return false;
+        // Unable to find the module!
+        if (nullptr == mdata.module) return false;
+
+        // erase the map entries (one with the filename as key,
+        // and one with the module id as key
+        modules.erase(mdata.filename);
+        modules.erase(mdata.id);
+    }
 
-    // Cache filename, id and handle; we'll need these in just a moment.
+    // Cache filename and handle; we'll need these in just a moment.
     std::string filename = mdata.filename;
-    std::string id       = mdata.id;
     void*       handle   = mdata.handle;
 
-    // Invoke the module's unload function.
+    // Invoke the module's unload function. Not under the lock: the
+    // module unregisters its requests, which waits for threads that
+    // are creating requests, and one of those might be loading some
+    // module on demand.
     (*mdata.unloadFunction)(mdata.module);
 
-    // erase the map entries (one with the filename as key,
-    // and one with the module id as key
-    modules.erase(filename);
-    modules.erase(id);
-
     // Unload dynamically loadable library.
     logger().info("Unloading module \"%s\"", filename.c_str());
 
@@ -277,6 +337,122 @@ bool ModuleManager::unloadModule(const std::string& moduleId)
 
 // ====================================================================
 
+bool ModuleManager::reloadModule(const std::string& moduleId,
+                                 CogServer& cs)
+{
+    std::unique_lock<std::recursive_mutex> lck(_modules_mtx);
+    ModuleData old = getModuleData(moduleId);
+
+    // Unable to find the module!
+    if (nullptr == old.module) return false;
+
+    // A dlopen() of a path that is already open just bumps the
+    // reference count on the old copy. Make a private copy of the
+    // library, so that the new version really does get loaded.
+    // The copy can be removed as soon as it's mapped.
+    std::string path = old.dirpath + "/" + old.filename;
+    std::filesystem::path tmp = std::filesystem::temp_directory_path();
+    tmp /= old.filename + "." + std::to_string(getpid()) +
+           ".reload-" + std::to_string(++_reloads);
+
+    std::error_code ec;
+    std::filesystem::copy_file(path, tmp, ec);
+    if (ec) {
+        logger().warn("Unable to copy module \"%s\" for reload: %s",
+                       path.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    // Bind the copy to its own symbols first. Otherwise, everything
+    // that the old copy also defines, which is pretty much everything,
+    // resolves to the old copy, which is already in the global scope.
+    ModuleData mdata;
+    bool ok = openAbsPath(tmp.string(), mdata, true);
+    std::filesystem::remove(tmp, ec);
+    if (not ok) return false;
+
+    if (mdata.id != old.id) {
+        logger().warn("Reloaded module \"%s\" has id %s, expecting %s",
+                       path.c_str(), mdata.id.c_str(), old.id.c_str());
+        dlclose(mdata.handle);
+        return false;
+    }
+    mdata.filename = old.filename;
+    mdata.dirpath = old.dirpath;
+
+    // The new version registers its requests over those of the old
+    // one, so that there is never a moment in which they are missing.
+    // The old module is left alone: requests that it created may still
+    // be running, and its factories may still be in use.
+    logger().info("Reloading module \"%s\"", old.filename.c_str());
+    auto start = std::chrono::steady_clock::now();
+    try {
+        mdata.module = (Module*) (*mdata.loadFunction)(cs);
+    }
+    catch (const std::exception& ex) {
+        logger().warn("Reloaded module \"%s\" failed to construct: %s",
+                       path.c_str(), ex.what());
+        dlclose(mdata.handle);
+        return false;
+    }
+    mdata.loadTime = elapsed_ms(start);
+    cs.replaceRequests(true);
+    try {
+        registerModule(mdata);
+    }
+    catch (...) {
+        cs.replaceRequests(false);
+        throw;
+    }
+    cs.replaceRequests(false);
+
+    // Requests created from here on come from the new version. Wait
+    // for those being created from the old factories right now; they
+    // pin the current epoch. Not under the lock; see unloadModule().
+    lck.unlock();
+    cs.synchronize();
+    lck.lock();
+
+    // The old module is destroyed, and its library unmapped, once
+    // everything created in the epoch that is now ending (or earlier)
+    // is gone.
+    _retired.push_back({cs.advanceEpoch(), old});
+    return true;
+}
+
+void ModuleManager::reclaimModules(CogServer& cs)
+{
+    std::vector<ModuleData> done;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
+        auto it = _retired.begin();
+        while (it != _retired.end())
+        {
+            if (not cs.epochQuiescent(it->first)) { it++; continue; }
+            logger().info("Closing retired module \"%s\" (epoch %lu)",
+                          it->second.filename.c_str(),
+                          (unsigned long) it->first);
+            done.push_back(it->second);
+            it = _retired.erase(it);
+        }
+    }
+
+    // Requests that the new version replaced were taken over already;
+    // the old module only unregisters those that the new one dropped.
+    // Not under the lock; see unloadModule().
+    for (ModuleData& mdata : done)
+    {
+        (*mdata.unloadFunction)(mdata.module);
+        cs.synchronize();
+
+        dlerror(); // Reset error state.
+        if (dlclose(mdata.handle) != 0)
+            logger().warn("Unable to close retired module: %s", dlerror());
+    }
+}
+
+// ====================================================================
+
 bool ModuleManager::configModule(const std::string& moduleId,
                                  const std::string& cfg)
 {
@@ -295,11 +471,12 @@ bool ModuleManager::configModule(const std::string& moduleId,
 
 ModuleManager::ModuleData ModuleManager::getModuleData(const std::string& moduleId)
 {
+    std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
     std::string f = get_filename(moduleId);
     ModuleMap::const_iterator it = modules.find(f);
     if (it == modules.end()) {
         logger().info("[ModuleManager] module \"%s\" was not found.", f.c_str());
-        static ModuleData nulldata = {NULL, "", "", "", NULL, NULL, NULL, NULL};
+        static ModuleData nulldata = {NULL, "", "", "", NULL, NULL, NULL, NULL, "", 0.0};
         return nulldata;
     }
     return it->second;
@@ -332,8 +509,202 @@ bool ModuleManager::loadModule(const std::string& path,
     return rc;
 }
 
+bool ModuleManager::openModule(const std::string& path,
+                               ModuleData& mdata)
+{
+    if (0 == path.size()) return false;
+    if ('/' == path[0])
+        return openAbsPath(path, mdata);
+
+    // Loop over the different possible module paths.
+    for (const std::string& module_path : module_paths) {
+        std::filesystem::path modulePath(module_path);
+        modulePath /= path;
+        if (std::filesystem::exists(modulePath) and
+            openAbsPath(modulePath.string(), mdata))
+            return true;
+    }
+    return false;
+}
+
+bool ModuleManager::loadModulesParallel(const std::vector<std::string>& names,
+                                        CogServer& cs)
+{
+    bool all_ok = true;
+
+    // Open all of the libraries first. The dynamic loader serializes
+    // on its own internal lock, so there is nothing to be gained by
+    // doing this in parallel. The expensive part is usually the module
+    // constructor (e.g. booting up guile or python), and that can run
+    // concurrently.
+    std::vector<ModuleData> pending;
+    for (const std::string& name : names)
+    {
+        std::string fi = get_filename(name);
+        bool dup;
+        {
+            std::lock_guard<std::recursive_mutex> lck(_modules_mtx);
+            dup = (modules.find(fi) != modules.end());
+        }
+        for (const ModuleData& md : pending)
+            if (md.filename == fi) dup = true;
+        if (dup) {
+            logger().info("Module \"%s\" is already loaded.", fi.c_str());
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ModuleData mdata;
+        if (not openModule(name, mdata))
+        {
+            logger().warn("Failed to load module %s", name.c_str());
+            all_ok = false;
+            continue;
+        }
+        mdata.loadTime = elapsed_ms(start);
+        pending.push_back(mdata);
+    }
+
+    // Resolve the declared dependencies into indexes into the pending
+    // list. Dependencies that are already loaded, or are not being
+    // loaded now, place no constraint on the ordering.
+    size_t npend = pending.size();
+    std::vector<std::vector<size_t>> deps(npend);
+    for (size_t i = 0; i < npend; i++)
+    {
+        std::vector<std::string> dnames;
+        tokenize(pending[i].depends, std::back_inserter(dnames), ", ");
+        for (const std::string& dn : dnames)
+        {
+            bool found = false;
+            for (size_t j = 0; j < npend; j++)
+            {
+                if (i == j) continue;
+                if (pending[j].id == dn or pending[j].filename == dn)
+                {
+                    deps[i].push_back(j);
+                    found = true;
+                }
+            }
+            if (not found)
+                logger().debug("[ModuleManager] %s: dependency %s is not "
+                               "in the load list", pending[i].filename.c_str(),
+                               dn.c_str());
+        }
+    }
+
+    // Run the module constructors.
+    auto construct = [&cs](ModuleData& mdata)
+    {
+        auto start = std::chrono::steady_clock::now();
+        try {
+            mdata.module = (Module*) (*mdata.loadFunction)(cs);
+        }
+        catch (const std::exception& ex) {
+            logger().error("Module %s failed to construct: %s",
+                           mdata.filename.c_str(), ex.what());
+            mdata.module = nullptr;
+        }
+        mdata.loadTime += elapsed_ms(start);
+    };
+
+    // Construct the modules in waves: each wave holds every module
+    // whose dependencies were all constructed in earlier waves.
+    std::vector<bool> done(npend, false);
+    size_t ndone = 0;
+    while (ndone < npend)
+    {
+        std::vector<size_t> wave;
+        for (size_t i = 0; i < npend; i++)
+        {
+            if (done[i]) continue;
+            bool ready = true;
+            for (size_t j : deps[i])
+                if (not done[j]) ready = false;
+            if (ready) wave.push_back(i);
+        }
+
+        // A dependency cycle. Break it by taking the first module
+        // that is left, in config-file order.
+        if (wave.empty())
+        {
+            for (size_t i = 0; i < npend; i++)
+            {
+                if (done[i]) continue;
+                logger().warn("Circular module dependency involving %s",
+                              pending[i].filename.c_str());
+                wave.push_back(i);
+                break;
+            }
+        }
+
+        if (1 == wave.size())
+            construct(pending[wave[0]]);
+        else
+        {
+            std::vector<std::thread> loaders;
+            for (size_t i : wave)
+                loaders.push_back(std::thread(construct, std::ref(pending[i])));
+            for (std::thread& t : loaders)
+                t.join();
+        }
+
+        for (size_t i : wave) done[i] = true;
+        ndone += wave.size();
+    }
+
+    // Register the modules and call init(), one at a time, in the
+    // order given in the config file. This keeps request registration
+    // deterministic, no matter which constructor finished first.
+    for (ModuleData& mdata : pending)
+    {
+        if (nullptr == mdata.module)
+        {
+            dlclose(mdata.handle);
+            logger().warn("Failed to load module %s", mdata.filename.c_str());
+            all_ok = false;
+            continue;
+        }
+        registerModule(mdata);
+        logger().info("Loaded module \"%s\" in %.1f ms",
+                      mdata.filename.c_str(), mdata.loadTime);
+    }
+
+    return all_ok;
+}
+
+std::vector<std::string> ModuleManager::registerLazyModules(CogServer& cs)
+{
+    // The manifest is a list of entries of the form
+    //    libfoo-shell.so:cmd1:cmd2
+    // naming a module, and the commands that it provides.
+    std::vector<std::string> lazy;
+    std::string manifest = config().get("LAZY_MODULES", "");
+    std::vector<std::string> entries;
+    tokenize(manifest, std::back_inserter(entries), ", ");
+    for (const std::string& entry : entries)
+    {
+        std::vector<std::string> fields;
+        tokenize(entry, std::back_inserter(fields), ":");
+        if (fields.size() < 2)
+        {
+            logger().warn("Ignoring lazy module \"%s\": no commands listed",
+                          entry.c_str());
+            continue;
+        }
+        for (size_t i = 1; i < fields.size(); i++)
+            cs.registerLazyRequest(fields[i], fields[0]);
+        lazy.push_back(get_filename(fields[0]));
+        logger().info("Module %s will be loaded on first use",
+                      fields[0].c_str());
+    }
+    return lazy;
+}
+
 void ModuleManager::loadModules(CogServer& cs)
 {
+    auto start = std::chrono::steady_clock::now();
+
     // Load modules specified in the config file
     std::string modlist;
     if (config().has("MODULES"))
@@ -342,27 +713,49 @@ void ModuleManager::loadModules(CogServer& cs)
         // Defaults: search the build dirs first, then the install dirs.
         modlist =
             "libbuiltinreqs.so, "
+            "libcheckpoint.so, "
             "libtop-shell.so, "
             "libscheme-shell.so, "
             "libsexpr-shell.so, "
+            "libbinary-shell.so, "
+            "libsubscribe-shell.so, "
+            "libreplicate-shell.so, "
+            "librestore-shell.so, "
             "libjson-shell.so, "
+            "libmsgpack-shell.so, "
             "libpy-shell.so";
 
+    std::vector<std::string> lazy = registerLazyModules(cs);
     std::vector<std::string> modules;
-    tokenize(modlist, std::back_inserter(modules), ", ");
+    std::vector<std::string> allmods;
+    tokenize(modlist, std::back_inserter(allmods), ", ");
+    for (const std::string& m : allmods)
+        if (std::find(lazy.begin(), lazy.end(), get_filename(m)) == lazy.end())
+            modules.push_back(m);
     bool load_failure = false;
-    for (const std::string& module : modules) {
-        bool rc = loadModule(module, cs);
-        if (not rc)
-        {
-            logger().warn("Failed to load module %s", module.c_str());
-            load_failure = true;
+    if (config().get_bool("PARALLEL_MODULE_LOAD", true))
+        load_failure = not loadModulesParallel(modules, cs);
+    else
+    {
+        for (const std::string& module : modules) {
+            bool rc = loadModule(module, cs);
+            if (not rc)
+            {
+                logger().warn("Failed to load module %s", module.c_str());
+                load_failure = true;
+            }
         }
     }
     if (load_failure) {
         for (auto p : module_paths)
             logger().warn("Searched for module at %s", p.c_str());
     }
+
+    struct rusage rus;
+    getrusage(RUSAGE_SELF, &rus);
+    logger().info("Loaded %zu modules (%zu deferred) in %.1f ms; maxrss: %ld KB",
+                  modules.size(), lazy.size(), elapsed_ms(start),
+                  rus.ru_maxrss);
 }
 
 // ========================= END OF FILE ==============================
@@ -13,6 +13,7 @@
 #define _OPENCOG_MODULE_MANAGER_H
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -52,10 +53,23 @@ protected:
         Module::UnloadFunction* unloadFunction;
         Module::ConfigFunction* configFunction;
         void*                   handle;
+        std::string             depends;
+        double                  loadTime;
     } ModuleData;
 
     // Container used to store references to the modules.
     typedef std::map<const std::string, ModuleData> ModuleMap;
+
+    // Modules can be loaded on demand, from any network thread,
+    // so guard the module map. Recursive, because module init()
+    // and config() methods may load other modules.
+    std::recursive_mutex _modules_mtx;
+
+    // Modules replaced by a reload, together with the epoch in which
+    // they were retired. Each is destroyed, and its library closed,
+    // once that epoch is quiescent.
+    std::vector<std::pair<uint64_t, ModuleData>> _retired;
+    unsigned int _reloads;
     ModuleMap modules;
 
     /** Retrieves the module's meta-data (id, filename, load/unload
@@ -67,6 +81,29 @@ protected:
 
     /** filepath must be an absolute path, i.e. start with a slash. */
     bool loadAbsPath(const std::string& filepath, CogServer&);
+
+    /** Open the shared library and look up the module entry points,
+     *  but do not construct the module.  filepath must be an absolute
+     *  path. The module field of the ModuleData is left null. With
+     *  deepbind, the library is opened RTLD_LOCAL, and prefers its own
+     *  symbols to any already loaded (where the platform allows). */
+    bool openAbsPath(const std::string& filepath, ModuleData&,
+                     bool deepbind = false);
+
+    /** Same as above, but search the module paths, if needed. */
+    bool openModule(const std::string& filename, ModuleData&);
+
+    /** Record a freshly-constructed module, and call its init() */
+    void registerModule(ModuleData&);
+
+    /** Load the listed modules, running the module constructors
+     *  concurrently, as far as the declared dependencies allow.
+     *  Returns false if any of the modules failed to load. */
+    bool loadModulesParallel(const std::vector<std::string>&, CogServer&);
+
+    /** Register placeholder requests for the modules listed in the
+     *  LAZY_MODULES manifest. Returns the filenames of those modules. */
+    std::vector<std::string> registerLazyModules(CogServer&);
 public:
 
     /** ModuleManager's constructor. */
@@ -96,10 +133,37 @@ public:
     /** Lists the modules that are currently loaded. */
     std::string listModules(void);
 
+    /** Replace a loaded module by a fresh copy of its shared library.
+     *  Requests created after this returns go to the new version; those
+     *  already in flight, and any open shells, continue to run the old
+     *  code. The old module is destroyed, and its code unmapped, only
+     *  after they have all finished. The new module is initialized from
+     *  scratch; any earlier `config` is not replayed.
+     *
+     *  The copy is opened with RTLD_DEEPBIND, so that its internal calls
+     *  go to the new code, and not to the old copy. Where that is not
+     *  available, a reloadable module should be built with hidden symbol
+     *  visibility. */
+    bool reloadModule(const std::string& moduleId, CogServer&);
+
+    /** Close any retired module libraries that are no longer in use. */
+    void reclaimModules(CogServer&);
+
     /** Retrieves the module's instance. Takes the module's id */
     Module* getModule(const std::string& id);
 
-    /** Load all default modules. */
+    /** Load all default modules. The module constructors are run in
+     *  parallel, unless PARALLEL_MODULE_LOAD is set to false in the
+     *  config file, except that a module waits for those named by its
+     *  DECLARE_MODULE_DEPENDS; the python modules wait for the scheme
+     *  shell, so that the two language runtimes are never initialized
+     *  at the same time. Module init() methods are always run
+     *  serially, in the order in which the modules were listed.
+     *
+     *  Modules that appear in the LAZY_MODULES manifest are not loaded;
+     *  instead, placeholders are registered for the commands that they
+     *  provide, and the module is loaded the first time one of these
+     *  is used. */
     void loadModules(CogServer&);
 
 }; // class
@@ -0,0 +1,45 @@
+/*
+ * opencog/cogserver/server/ReadSnapshot.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <shared_mutex>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/network/GenericShell.h>
+#include <opencog/cogserver/server/AtomSnapshot.h>
+
+#include "ReadSnapshot.h"
+
+using namespace opencog;
+
+AtomSpacePtr ReadSnapshot::get(const AtomSpacePtr& as)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::milliseconds share(config().get_int("SNAPSHOT_SHARE_MS", 1000));
+    AtomSpacePtr snap = _snap.lock();
+    if (snap and start - _taken <= share) return snap;
+
+    int wait = config().get_int("SNAPSHOT_WAIT", 10);
+    {
+        std::unique_lock<std::shared_timed_mutex> quiet(
+            GenericShell::eval_barrier(), std::defer_lock);
+        if (not quiet.try_lock_for(std::chrono::seconds(wait)))
+            logger().warn("[ReadSnapshot] Shells still busy after %d seconds; "
+                          "the read snapshot may be inconsistent", wait);
+        snap = AtomSnapshot::copy(as);
+    }
+    _snap = snap;
+    _taken = start;
+
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+    logger().info("[ReadSnapshot] Copied %zu atoms for a read snapshot "
+                  "in %.3f seconds", snap->get_size(), secs.count());
+    return snap;
+}
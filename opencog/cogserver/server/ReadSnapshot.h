@@ -0,0 +1,53 @@
+/*
+ * opencog/cogserver/server/ReadSnapshot.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_READ_SNAPSHOT_H
+#define _OPENCOG_READ_SNAPSHOT_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Read-only copies of the AtomSpace, for shells that want a view that
+ * does not change under them.
+ *
+ * get() copies the AtomSpace (see AtomSnapshot::copy()) while the
+ * shells, and the other writers, are paused on the eval barrier (see
+ * GenericShell::eval_barrier()), so that the copy is of one moment.
+ * Rather than keep a new shell waiting, it copies anyway if they are
+ * still busy after SNAPSHOT_WAIT seconds, and logs a warning. Callers
+ * within SNAPSHOT_SHARE_MS of one another get the same copy, for as
+ * long as one of them still holds it.
+ */
+class ReadSnapshot
+{
+    // Held while copying, so that shells opened at the same moment
+    // wait for one copy, rather than each making their own.
+    std::mutex _mtx;
+    std::weak_ptr<AtomSpace> _snap;
+    std::chrono::steady_clock::time_point _taken;
+
+public:
+    /** A copy of `as`, made now, or shared with a recent caller. Must
+     *  not be called from within an evaluation, which would hold that
+     *  up. */
+    AtomSpacePtr get(const AtomSpacePtr& as);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_READ_SNAPSHOT_H
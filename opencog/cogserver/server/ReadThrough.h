@@ -0,0 +1,87 @@
+/*
+ * opencog/cogserver/server/ReadThrough.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_READ_THROUGH_H
+#define _OPENCOG_READ_THROUGH_H
+
+#include <mutex>
+#include <shared_mutex>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Fetch what a client is about to read, from wherever it is kept,
+ * into the server AtomSpace. The sexpr shell's command handlers call
+ * these before each read; a read-through proxy module implements
+ * them.
+ */
+class ReadThrough
+{
+public:
+    virtual ~ReadThrough() {}
+
+    /** The atom, and all of its values. */
+    virtual void fetch_atom(const Handle&) = 0;
+
+    /** One value on the atom. */
+    virtual void fetch_value(const Handle& atom, const Handle& key) = 0;
+
+    /** The incoming set of the atom, or, unless the type is NOTYPE,
+     *  just the links of that type. */
+    virtual void fetch_incoming(const Handle&, Type) = 0;
+
+    /** All atoms of the type, and maybe its subtypes. */
+    virtual void fetch_type(Type, bool subtypes) = 0;
+};
+
+/**
+ * The place where a module installs its ReadThrough. Calls are passed
+ * on to it, if there is one, and do nothing if not.
+ */
+class ReadThroughSlot : public ReadThrough
+{
+    std::shared_mutex _mtx;
+    ReadThrough* _rt;
+
+public:
+    ReadThroughSlot(void) : _rt(nullptr) {}
+
+    /** Pass nullptr to remove it; this waits for calls in progress
+     *  to finish. */
+    void set(ReadThrough* rt) {
+        std::unique_lock<std::shared_mutex> lck(_mtx);
+        _rt = rt;
+    }
+
+    virtual void fetch_atom(const Handle& h) {
+        std::shared_lock<std::shared_mutex> lck(_mtx);
+        if (_rt) _rt->fetch_atom(h);
+    }
+    virtual void fetch_value(const Handle& atom, const Handle& key) {
+        std::shared_lock<std::shared_mutex> lck(_mtx);
+        if (_rt) _rt->fetch_value(atom, key);
+    }
+    virtual void fetch_incoming(const Handle& h, Type t) {
+        std::shared_lock<std::shared_mutex> lck(_mtx);
+        if (_rt) _rt->fetch_incoming(h, t);
+    }
+    virtual void fetch_type(Type t, bool subtypes) {
+        std::shared_lock<std::shared_mutex> lck(_mtx);
+        if (_rt) _rt->fetch_type(t, subtypes);
+    }
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_READ_THROUGH_H
@@ -0,0 +1,350 @@
+/*
+ * opencog/cogserver/server/ReplicaClient.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <shared_mutex>
+
+#include <opencog/util/Logger.h>
+#include <opencog/network/GenericShell.h>
+
+#include "ReplicaClient.h"
+
+using namespace opencog;
+
+// The leader sends a heartbeat every second when it has nothing else
+// to send. If nothing arrives for this long, the connection is dead.
+#define LEADER_TIMEOUT_SECS 10
+
+// Longest wait between attempts to reconnect.
+#define MAX_RETRY_SECS 30
+
+ReplicaClient::ReplicaClient(ChangeFeed& feed) :
+    _feed(feed),
+    _thread(nullptr),
+    _stop(false),
+    _fd(-1),
+    _port(0),
+    _epoch(0),
+    _applied(0),
+    _leader_head(0),
+    _connected(false),
+    _syncing(false),
+    _sync_base(0),
+    _nsyncs(0),
+    _nerrors(0),
+    _last_heard(0)
+{
+}
+
+ReplicaClient::~ReplicaClient()
+{
+    stop();
+}
+
+void ReplicaClient::start(const AtomSpacePtr& asp,
+                          const std::string& host, int port)
+{
+    stop();
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    _as = asp;
+    _host = host;
+    _port = port;
+    _epoch = 0;
+    _applied = 0;
+    _leader_head = 0;
+    _stop = false;
+    _thread = new std::thread(&ReplicaClient::follow_loop, this);
+    logger().info("[ReplicaClient] following %s:%d", host.c_str(), port);
+}
+
+void ReplicaClient::stop(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (nullptr == _thread) return;
+
+    _stop = true;
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+    logger().info("[ReplicaClient] stopped following %s:%d",
+                  _host.c_str(), _port);
+}
+
+/* ============================================================== */
+
+void ReplicaClient::follow_loop(void)
+{
+    prctl(PR_SET_NAME, "cogserv:replica", 0, 0, 0);
+
+    int retry = 1;
+    while (not _stop)
+    {
+        if (session()) retry = 1;
+
+        for (int i = 0; i < 10 * retry and not _stop; i++)
+            usleep(100000);
+        retry = std::min(2 * retry, MAX_RETRY_SECS);
+    }
+}
+
+static int connect_to(const std::string& host, int port)
+{
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* res = nullptr;
+    int rc = getaddrinfo(host.c_str(), std::to_string(port).c_str(),
+                         &hints, &res);
+    if (rc)
+    {
+        logger().warn("[ReplicaClient] cannot resolve %s: %s",
+                      host.c_str(), gai_strerror(rc));
+        return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo* ai = res; ai; ai = ai->ai_next)
+    {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (0 == connect(fd, ai->ai_addr, ai->ai_addrlen)) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if (fd < 0)
+        logger().warn("[ReplicaClient] cannot connect to %s:%d: %s",
+                      host.c_str(), port, strerror(errno));
+    return fd;
+}
+
+/// Run one connection to the leader, until it fails or we are told
+/// to stop. Returns true if anything was received.
+bool ReplicaClient::session(void)
+{
+    int fd = connect_to(_host, _port);
+    if (fd < 0) return false;
+
+    std::string cmd = "replicate\nsince " + std::to_string(_epoch) +
+        " " + std::to_string(_applied) + "\n";
+    if (send(fd, cmd.c_str(), cmd.size(), MSG_NOSIGNAL) < 0)
+    {
+        close(fd);
+        return false;
+    }
+    _connected = true;
+
+    bool heard = false;
+    std::string buf;
+    char rd[65536];
+    auto last = std::chrono::steady_clock::now();
+    while (not _stop)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        int rc = poll(&pfd, 1, 200);
+        if (rc < 0 and EINTR == errno) continue;
+        if (rc < 0) break;
+        auto now = std::chrono::steady_clock::now();
+        if (0 == rc)
+        {
+            if (std::chrono::seconds(LEADER_TIMEOUT_SECS) < now - last)
+            {
+                logger().warn("[ReplicaClient] nothing from %s:%d "
+                    "for %d seconds; reconnecting",
+                    _host.c_str(), _port, LEADER_TIMEOUT_SECS);
+                break;
+            }
+            continue;
+        }
+
+        ssize_t got = read(fd, rd, sizeof(rd));
+        if (got < 0 and EINTR == errno) continue;
+        if (got <= 0) break;
+        heard = true;
+        last = now;
+        _last_heard = now.time_since_epoch().count();
+
+        buf.append(rd, got);
+        size_t start = 0;
+        size_t nl;
+        while (std::string::npos != (nl = buf.find('\n', start)))
+        {
+            process(buf.substr(start, nl - start));
+            start = nl + 1;
+        }
+        buf.erase(0, start);
+    }
+
+    close(fd);
+    _connected = false;
+    _syncing = false;
+    if (not _stop)
+        logger().info("[ReplicaClient] lost connection to %s:%d",
+                      _host.c_str(), _port);
+    return heard;
+}
+
+/// Handle one line from the leader. These are either control lines,
+/// or changes, optionally preceded by their sequence number:
+///
+///   (sync <epoch> <seq>)   -- a full copy starts; clear everything
+///   (synced)               -- the full copy is done
+///   (heartbeat <seq>)      -- the leader's newest sequence number
+///   [<seq>] (atom-added ...) etc.
+///
+/// Anything else, such as the console prompt, is ignored.
+void ReplicaClient::process(const std::string& line)
+{
+    if (0 == line.size()) return;
+
+    if (0 == line.compare(0, 6, "(sync "))
+    {
+        unsigned long long epoch = 0, base = 0;
+        sscanf(line.c_str(), "(sync %llu %llu)", &epoch, &base);
+        _epoch = epoch;
+        _sync_base = base;
+        _syncing = true;
+        _nsyncs++;
+        clear();
+        logger().info("[ReplicaClient] copying the AtomSpace of %s:%d",
+                      _host.c_str(), _port);
+        return;
+    }
+    if (0 == line.compare(0, 8, "(synced)"))
+    {
+        _syncing = false;
+        _applied = _sync_base;
+        if (_leader_head < _sync_base) _leader_head = _sync_base;
+        logger().info("[ReplicaClient] copied %zu atoms from %s:%d",
+                      _as->get_size(), _host.c_str(), _port);
+        return;
+    }
+    if (0 == line.compare(0, 11, "(heartbeat "))
+    {
+        _leader_head = strtoull(line.c_str() + 11, nullptr, 10);
+        return;
+    }
+
+    if ('(' == line[0])
+    {
+        apply(line);
+        return;
+    }
+    if (not isdigit(line[0])) return;
+
+    char* end;
+    uint64_t seq = strtoull(line.c_str(), &end, 10);
+    apply(std::string(end + strspn(end, " ")));
+    if (_applied < seq) _applied = seq;
+    if (_leader_head < seq) _leader_head = seq;
+}
+
+void ReplicaClient::apply(const std::string& ev)
+{
+    try
+    {
+        // Like a shell; see BackgroundSave.
+        std::shared_lock<std::shared_timed_mutex> lck(
+            GenericShell::eval_barrier());
+        _feed.apply(_as, ev);
+    }
+    catch (const std::exception& ex)
+    {
+        if (_nerrors++ < 10)
+            logger().warn("[ReplicaClient] cannot apply %.80s: %s",
+                          ev.c_str(), ex.what());
+    }
+}
+
+/// Empty the AtomSpace, for a full copy. The removals are published,
+/// like the changes from the leader, so that the write-ahead log,
+/// checkpoint deltas, subscribers and followers of this server are
+/// emptied too. Removing each atom that has no incoming set, with
+/// everything under it, is one event.
+void ReplicaClient::clear(void)
+{
+    std::shared_lock<std::shared_timed_mutex> lck(
+        GenericShell::eval_barrier());
+
+    HandleSeq roots;
+    if (_feed.active())
+    {
+        HandleSeq all;
+        _as->get_handles_by_type(all, ATOM, true);
+        for (const Handle& h : all)
+            if (0 == h->getIncomingSetSize()) roots.push_back(h);
+    }
+    _as->clear();
+    if (roots.empty()) return;
+
+    try
+    {
+        _feed.begin_batch();
+        try
+        {
+            for (const Handle& h : roots)
+                _feed.atom_removed(h);
+        }
+        catch (...)
+        {
+            _feed.end_batch();
+            throw;
+        }
+        _feed.end_batch();
+    }
+    catch (const std::exception& ex)
+    {
+        logger().warn("[ReplicaClient] cannot publish the clear: %s",
+                      ex.what());
+    }
+}
+
+/* ============================================================== */
+
+std::string ReplicaClient::display_stats(void)
+{
+    // start() and stop() change the leader, and the thread.
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (nullptr == _thread) return "";
+
+    const char* state = "retrying";
+    if (_syncing) state = "copying";
+    else if (_connected) state = "following";
+
+    uint64_t head = _leader_head;
+    uint64_t applied = _applied;
+    double heard = -1.0;
+    if (_last_heard)
+    {
+        std::chrono::steady_clock::duration since =
+            std::chrono::steady_clock::now().time_since_epoch() -
+            std::chrono::steady_clock::duration(_last_heard);
+        heard = std::chrono::duration<double>(since).count();
+    }
+
+    char buff[256];
+    snprintf(buff, sizeof(buff),
+        "replica-of: %s:%d %s  applied: %lu  leader: %lu  lag: %lu  "
+        "heard: %.1fs ago  copies: %zu  errors: %zu\n",
+        _host.c_str(), _port, state, (unsigned long) applied,
+        (unsigned long) head,
+        (unsigned long) (applied < head ? head - applied : 0),
+        heard, _nsyncs.load(), _nerrors.load());
+    return buff;
+}
@@ -0,0 +1,102 @@
+/*
+ * opencog/cogserver/server/ReplicaClient.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_REPLICA_CLIENT_H
+#define _OPENCOG_REPLICA_CLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * The follower side of replication: keep the local AtomSpace a copy
+ * of the AtomSpace of a leader CogServer.
+ *
+ * A background thread connects to the leader's console port and runs
+ * the `replicate` command there. The leader answers with a copy of
+ * its whole AtomSpace, followed by every change made since the copy
+ * was started, and then keeps sending changes as they are made. See
+ * ReplicationLog for the leader side.
+ *
+ * If the connection is lost, the thread reconnects, and asks only
+ * for the changes it has not yet seen. If the leader no longer has
+ * them, or was restarted, the whole AtomSpace is copied again.
+ *
+ * Changes applied here are published to the local ChangeFeed, so
+ * that followers can have subscribers, and followers of their own;
+ * so is the emptying of the AtomSpace before a full copy.
+ * Nothing stops local clients from changing the follower's AtomSpace,
+ * but such changes are not sent to the leader, and may be lost on
+ * the next full copy.
+ */
+class ReplicaClient
+{
+    ChangeFeed& _feed;
+    AtomSpacePtr _as;
+
+    std::mutex _mtx;
+    std::thread* _thread;
+    std::atomic_bool _stop;
+    int _fd;
+    std::string _host;
+    int _port;
+
+    // Position in the leader's log.
+    uint64_t _epoch;
+    std::atomic_uint64_t _applied;
+    std::atomic_uint64_t _leader_head;
+    std::atomic_bool _connected;
+    std::atomic_bool _syncing;
+    uint64_t _sync_base;
+    std::atomic_size_t _nsyncs;
+    std::atomic_size_t _nerrors;
+    std::atomic<std::chrono::steady_clock::rep> _last_heard;
+
+    void follow_loop(void);
+    bool session(void);
+    void process(const std::string&);
+    void apply(const std::string&);
+    void clear(void);
+
+public:
+    ReplicaClient(ChangeFeed&);
+    ~ReplicaClient();
+
+    /** Start following the leader at host:port. Stops following
+     *  any previous leader first. */
+    void start(const AtomSpacePtr&, const std::string& host, int port);
+    void stop(void);
+    bool running(void) {
+        std::lock_guard<std::mutex> lck(_mtx);
+        return nullptr != _thread;
+    }
+
+    /** The number of times the AtomSpace was emptied, and copied
+     *  from the leader afresh. */
+    size_t full_copies(void) const { return _nsyncs; }
+
+    /** One line: the leader, how far along we are in its log, and
+     *  the lag. Empty, if not following. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_REPLICA_CLIENT_H
@@ -0,0 +1,78 @@
+/*
+ * opencog/cogserver/server/ReplicationLog.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <chrono>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+
+#include "ReplicationLog.h"
+
+using namespace opencog;
+
+ReplicationLog::ReplicationLog(void) :
+    _first(1),
+    _head(0),
+    _max(0),
+    _enabled(false),
+    _nfollowers(0)
+{
+    _epoch = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void ReplicationLog::enable(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (_enabled) return;
+    _max = config().get_int("REPLICATION_LOG_MAX", 1000000);
+    if (0 == _max) _max = 1;
+    _enabled = true;
+    logger().info("[ReplicationLog] logging changes; keeping the last %zu",
+                  _max);
+}
+
+void ReplicationLog::append(const std::string& entry)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    _entries.push_back(entry);
+    _head++;
+    if (_max < _entries.size())
+    {
+        _entries.pop_front();
+        _first++;
+    }
+}
+
+uint64_t ReplicationLog::head(void)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    return _head;
+}
+
+bool ReplicationLog::read(uint64_t after, std::vector<Entry>& out,
+                          size_t max)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    if (after + 1 < _first or _head < after) return false;
+
+    for (uint64_t seq = after + 1; seq <= _head and 0 < max; seq++, max--)
+        out.emplace_back(seq, _entries[seq - _first]);
+    return true;
+}
+
+std::string ReplicationLog::display_stats(void)
+{
+    if (not _enabled) return "";
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    char buff[180];
+    snprintf(buff, sizeof(buff),
+        "repl-log head: %lu  held: %zu  followers: %zu\n",
+        (unsigned long) _head, _entries.size(), _nfollowers.load());
+    return buff;
+}
@@ -0,0 +1,90 @@
+/*
+ * opencog/cogserver/server/ReplicationLog.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_REPLICATION_LOG_H
+#define _OPENCOG_REPLICATION_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Ordered log of AtomSpace changes, kept by a replication leader.
+ *
+ * Every change published to the ChangeFeed is appended here, in the
+ * same s-expression form that the feed uses, and given the next
+ * sequence number. Followers copy the AtomSpace once, noting the
+ * sequence number at which the copy began, and then tail the log
+ * from there.
+ *
+ * Only the most recent REPLICATION_LOG_MAX entries are kept. A
+ * follower that falls further behind than that has to copy the
+ * whole AtomSpace again.
+ *
+ * Each log has an epoch, chosen when the server starts. A follower
+ * that reconnects with a sequence number from another epoch, e.g.
+ * after the leader was restarted, is made to copy everything again.
+ *
+ * The log is off until the first follower connects, so that a server
+ * that is not being replicated pays nothing for it.
+ */
+class ReplicationLog
+{
+public:
+    typedef std::pair<uint64_t, std::string> Entry;
+
+private:
+    std::mutex _mtx;
+    std::deque<std::string> _entries;
+    uint64_t _first;    // Sequence number of _entries.front()
+    uint64_t _head;     // Sequence number of the newest entry
+    uint64_t _epoch;    // Distinguishes this log from that of a restart
+    size_t _max;
+    std::atomic_bool _enabled;
+    std::atomic_size_t _nfollowers;
+
+public:
+    ReplicationLog(void);
+
+    /** Start logging, if not already started. */
+    void enable(void);
+    bool enabled(void) const { return _enabled; }
+
+    /** Sequence numbers are only meaningful within one epoch; a
+     *  restarted leader has a new one. */
+    uint64_t epoch(void) const { return _epoch; }
+
+    void append(const std::string&);
+
+    /** Sequence number of the newest entry; zero if none. */
+    uint64_t head(void);
+
+    /** Copy up to `max` entries newer than `after` into `out`.
+     *  Returns false if some of them are no longer held. */
+    bool read(uint64_t after, std::vector<Entry>& out, size_t max);
+
+    void add_follower(void) { _nfollowers++; }
+    void remove_follower(void) { _nfollowers--; }
+
+    /** One line: head, entries held, and connected followers.
+     *  Empty, if the log was never enabled. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_REPLICATION_LOG_H
@@ -10,11 +10,14 @@
  * explore writing guile (scheme) or python modules instead.
  */
 
+#include <thread>
+
 #include <opencog/util/exceptions.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 
 #include <opencog/network/ConsoleSocket.h>
+#include <opencog/cogserver/server/CogServer.h>
 #include <opencog/cogserver/server/ServerConsole.h>
 
 #include "Request.h"
@@ -22,7 +25,7 @@
 using namespace opencog;
 
 Request::Request(CogServer& cs) :
-    _console(nullptr), _cogserver(cs)
+    _console(nullptr), _epoch(cs.pinEpoch()), _cogserver(cs)
 {
 }
 
@@ -40,6 +43,7 @@ Request::~Request()
         }
         _console->put();  // dec use count we are done with it.
     }
+    _cogserver.unpinEpoch(_epoch);
 }
 
 void Request::set_console(ConsoleSocket* con)
@@ -70,6 +74,39 @@ void Request::send(const std::string& msg) const
     if (_console) _console->Send(msg);
 }
 
+void Request::run_detached(const char* fail,
+                           std::function<std::string()> fn)
+{
+    ConsoleSocket* con = _console;
+    if (con)
+    {
+        con->get();
+        set_console(nullptr);
+    }
+    CogServer& cs = _cogserver;
+    uint64_t epoch = _epoch;
+    cs.pinEpoch(epoch);
+    std::string failed(fail);
+    std::thread([con, failed, fn, &cs, epoch]() {
+        std::string reply;
+        try {
+            reply = fn();
+        }
+        catch (const RuntimeException& ex) {
+            reply = failed + ex.what() + "\n";
+            logger().warn("%s", reply.c_str());
+        }
+        if (con)
+        {
+            con->Send(reply);
+            ServerConsole* sc = dynamic_cast<ServerConsole*>(con);
+            if (sc) sc->sendPrompt();
+            con->put();
+        }
+        cs.unpinEpoch(epoch);
+    }).detach();
+}
+
 void Request::setParameters(const std::list<std::string>& params)
 {
     _parameters.assign(params.begin(), params.end());
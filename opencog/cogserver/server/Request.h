@@ -15,6 +15,8 @@
 #ifndef _OPENCOG_REQUEST_H
 #define _OPENCOG_REQUEST_H
 
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <string>
 
@@ -163,7 +165,8 @@ class ConsoleSocket;
                                     & do_cmd##Factory);               \
     }                                                                 \
     void do_cmd##_unregister(void) {                                  \
-        _cogserver.unregisterRequest(do_cmd##Request::info().id);     \
+        _cogserver.unregisterRequest(do_cmd##Request::info().id,      \
+                                      & do_cmd##Factory);             \
     }
 
 
@@ -234,6 +237,10 @@ class Request
 private:
     ConsoleSocket*         _console;
 
+    // Pinned for the lifetime of the request, so that the module
+    // that created it is not unmapped underneath it during a reload.
+    uint64_t               _epoch;
+
 protected:
     CogServer&             _cogserver;
     std::list<std::string> _parameters;
@@ -260,6 +267,17 @@ public:
     void set_console(ConsoleSocket*);
     ConsoleSocket *get_console(void) const { return _console; }
 
+    /** The epoch in which this request was created. */
+    uint64_t get_epoch(void) const { return _epoch; }
+
+    /** Run `fn` in a thread of its own, for commands that take a
+     *  while, so that the server loop can get on with other requests.
+     *  The thread holds on to the socket, and sends the reply that
+     *  `fn` returns, and then the prompt; the request lets go of the
+     *  socket. If `fn` throws, `fail` and the error are sent instead.
+     *  The request's epoch stays pinned until the thread is done. */
+    void run_detached(const char* fail, std::function<std::string()> fn);
+
     /** sets the command's parameter list. */
     virtual void setParameters(const std::list<std::string>&);
 
@@ -30,7 +30,11 @@ RequestManager::~RequestManager()
 {
 }
 
-RequestManager::RequestManager(void)
+RequestManager::RequestManager(void) :
+    _factories(std::make_shared<const FactoryMap>()),
+    _replacing(false),
+    _generation(0),
+    _epoch(0)
 {
 }
 
@@ -49,47 +53,277 @@ void RequestManager::processRequests(void)
 // =============================================================
 // Request registration
 
+RequestManager::FactoryMapPtr RequestManager::getFactories(void) const
+{
+    return std::atomic_load(&_factories);
+}
+
+/// Publish a new factory map, and return the old one.
+/// Caller must hold the _factories_mtx.
+RequestManager::FactoryMapPtr RequestManager::publish(FactoryMap* fmap)
+{
+    FactoryMapPtr old = _factories;
+    std::atomic_store(&_factories, FactoryMapPtr(fmap));
+    return old;
+}
+
 bool RequestManager::registerRequest(const std::string& name,
                                      AbstractFactory<Request> const* factory)
 {
-    return _factories.insert({name, factory}).second;
+    std::lock_guard<std::mutex> lck(_factories_mtx);
+    if (_factories->find(name) != _factories->end() and not _replacing)
+        return false;
+
+    FactoryMap* fmap = new FactoryMap(*_factories);
+    (*fmap)[name] = factory;
+    publish(fmap);
+    return true;
+}
+
+void RequestManager::replaceRequests(bool replace)
+{
+    std::lock_guard<std::mutex> lck(_factories_mtx);
+    _replacing = replace;
 }
 
-bool RequestManager::unregisterRequest(const std::string& name)
+/// Remove the factory for `name` from the table, without waiting
+/// for readers. If `only` is given, the entry is removed only if it
+/// is that factory. Returns the last snapshot that held the factory,
+/// or null, if nothing was removed.
+RequestManager::FactoryMapPtr
+RequestManager::removeFactory(const std::string& name,
+                              AbstractFactory<Request> const* only)
 {
-    return _factories.erase(name) == 1;
+    std::lock_guard<std::mutex> lck(_factories_mtx);
+    const auto it = _factories->find(name);
+    if (it == _factories->end()) return nullptr;
+    if (only and it->second != only) return nullptr;
+
+    FactoryMap* fmap = new FactoryMap(*_factories);
+    fmap->erase(name);
+    return publish(fmap);
+}
+
+bool RequestManager::unregisterRequest(const std::string& name,
+                                       AbstractFactory<Request> const* only)
+{
+    if (nullptr == removeFactory(name, only)) return false;
+
+    // Wait for a grace period: any reader that found the factory in
+    // an older snapshot might still be calling into it. After that,
+    // the caller is free to delete the factory.
+    synchronize();
+    return true;
+}
+
+// =============================================================
+// Read sections
+
+uint64_t RequestManager::beginRead(void) const
+{
+    std::lock_guard<std::mutex> lck(_readers_mtx);
+    _readers[_generation] ++;
+    return _generation;
+}
+
+void RequestManager::endRead(uint64_t gen) const
+{
+    std::lock_guard<std::mutex> lck(_readers_mtx);
+    auto it = _readers.find(gen);
+    if (0 == --it->second) _readers.erase(it);
+    _readers_cv.notify_all();
+}
+
+void RequestManager::synchronize(void)
+{
+    // Readers that arrive from now on are in a later generation, and
+    // are not waited for. Thus, a reader that never leaves holds up
+    // only the writers that overlap it, and not all later ones.
+    std::unique_lock<std::mutex> lck(_readers_mtx);
+    uint64_t gen = _generation++;
+    while (not _readers.empty() and _readers.begin()->first <= gen)
+        _readers_cv.wait(lck);
 }
 
 Request* RequestManager::createRequest(const std::string& name,
                                        CogServer& cs)
 {
-    const auto it = _factories.find(name);
-    if (it == _factories.end()) {
+    // The snapshot is dropped before calling the factory: the call may
+    // load a module, which publishes a new table. Being a reader is
+    // enough to keep the factory alive.
+    uint64_t gen = beginRead();
+    AbstractFactory<Request> const* fact = nullptr;
+    {
+        FactoryMapPtr fmap = getFactories();
+        const auto it = fmap->find(name);
+        if (it != fmap->end()) fact = it->second;
+    }
+    if (nullptr == fact) {
+        endRead(gen);
         // Probably a user typo at the server prompt.
         logger().debug("Cannot create unknown request \"%s\"", name.c_str());
         return nullptr;
     }
-    return it->second->create(cogserver());
+
+    Request* req = nullptr;
+    try {
+        req = fact->create(cogserver());
+    }
+    catch (...) {
+        endRead(gen);
+        throw;
+    }
+    endRead(gen);
+    return req;
 }
 
 const RequestClassInfo& RequestManager::requestInfo(const std::string& name) const
 {
+    // The class info is a static in the request class; it outlives the
+    // factory, but not the module. Look it up in a read section, so that
+    // the module cannot go away while we do.
     static RequestClassInfo emptyClassInfo;
-    const auto it = _factories.find(name);
-    if (it == _factories.end()) {
+    uint64_t gen = beginRead();
+    FactoryMapPtr fmap = getFactories();
+    const auto it = fmap->find(name);
+    if (it == fmap->end()) {
+        endRead(gen);
         // Probably a user typo at the server prompt.
         logger().debug("No info about unknown request \"%s\"", name.c_str());
         return emptyClassInfo;
     }
-    return static_cast<const RequestClassInfo&>(it->second->info());
+    const RequestClassInfo& info =
+        static_cast<const RequestClassInfo&>(it->second->info());
+    endRead(gen);
+    return info;
+}
+
+// =============================================================
+// On-demand module loading
+
+LazyRequestFactory::LazyRequestFactory(const std::string& id,
+                                       const std::string& mod) :
+    _info(id,
+          "Provided by " + mod + " (loaded on first use)",
+          "The module " + mod + " will be loaded the first time this\n"
+          "command is used. Full help is available after that.\n"),
+    module(mod)
+{
+}
+
+Request* LazyRequestFactory::create(CogServer& cs) const
+{
+    return cs.loadLazyRequest(_info.id, cs);
+}
+
+bool RequestManager::registerLazyRequest(const std::string& name,
+                                         const std::string& module)
+{
+    std::lock_guard<std::mutex> lck(_lazy_mtx);
+    if (_lazy_factories.find(name) != _lazy_factories.end())
+        return false;
+
+    LazyRequestFactory* fact = new LazyRequestFactory(name, module);
+    _lazy_factories[name] = std::unique_ptr<LazyRequestFactory>(fact);
+    return registerRequest(name, fact);
+}
+
+Request* RequestManager::loadLazyRequest(const std::string& name,
+                                         CogServer& cs)
+{
+    std::lock_guard<std::mutex> lck(_lazy_mtx);
+    const auto lit = _lazy_factories.find(name);
+    if (lit == _lazy_factories.end()) return nullptr;
+    const std::string module = lit->second->module;
+
+    // Pull all of the placeholders for this module out of the way,
+    // so that the module can register the real requests. If some
+    // other thread loaded the module while we waited on the lock,
+    // there won't be any placeholders left.
+    // The placeholders are never deleted, so there is no need to
+    // wait for readers here. (We are likely one of them.)
+    bool loaded = true;
+    std::vector<LazyRequestFactory*> stubs;
+    for (const auto& lpr : _lazy_factories)
+    {
+        if (lpr.second->module != module) continue;
+        stubs.push_back(lpr.second.get());
+        if (removeFactory(lpr.first, lpr.second.get()))
+            loaded = false;
+    }
+
+    if (not loaded)
+    {
+        logger().info("Loading module %s on first use of \"%s\"",
+                      module.c_str(), name.c_str());
+        if (not cs.loadModule(module))
+        {
+            logger().warn("Unable to load module %s for request \"%s\"",
+                          module.c_str(), name.c_str());
+
+            // Put the placeholders back; maybe the user can fix things.
+            for (LazyRequestFactory* fact : stubs)
+                registerRequest(fact->info().id, fact);
+            return nullptr;
+        }
+    }
+
+    Request* req = createRequest(name, cs);
+    if (nullptr == req)
+        logger().warn("Module %s did not provide request \"%s\"",
+                      module.c_str(), name.c_str());
+    return req;
 }
 
+// =============================================================
+
 std::list<const char*> RequestManager::requestIds() const
 {
+    // The map keys belong to the snapshot, which may be freed as soon
+    // as we return; the ids in the class info are long-lived.
     std::list<const char*> l;
-    for (const auto& fact : _factories)
-        l.push_back(fact.first.c_str());
+    uint64_t gen = beginRead();
+    FactoryMapPtr fmap = getFactories();
+    for (const auto& fact : *fmap)
+        l.push_back(fact.second->info().id.c_str());
+    endRead(gen);
     return l;
 }
 
 // =============================================================
+// Epochs
+
+uint64_t RequestManager::pinEpoch(void)
+{
+    std::lock_guard<std::mutex> lck(_epoch_mtx);
+    _pinned[_epoch] ++;
+    return _epoch;
+}
+
+void RequestManager::pinEpoch(uint64_t epoch)
+{
+    std::lock_guard<std::mutex> lck(_epoch_mtx);
+    _pinned[epoch] ++;
+}
+
+void RequestManager::unpinEpoch(uint64_t epoch)
+{
+    std::lock_guard<std::mutex> lck(_epoch_mtx);
+    auto it = _pinned.find(epoch);
+    if (it == _pinned.end()) return;
+    if (0 == --it->second) _pinned.erase(it);
+}
+
+uint64_t RequestManager::advanceEpoch(void)
+{
+    std::lock_guard<std::mutex> lck(_epoch_mtx);
+    return _epoch++;
+}
+
+bool RequestManager::epochQuiescent(uint64_t epoch)
+{
+    std::lock_guard<std::mutex> lck(_epoch_mtx);
+    return _pinned.empty() or epoch < _pinned.begin()->first;
+}
+
+// =============================================================
@@ -15,6 +15,10 @@
 #ifndef _OPENCOG_REQUEST_MANAGER_H
 #define _OPENCOG_REQUEST_MANAGER_H
 
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -29,6 +33,22 @@ namespace opencog
  *  @{
  */
 
+/**
+ * Placeholder factory for a request provided by a module that has not
+ * been loaded yet. The first attempt to create the request loads the
+ * module, which registers the real factory in place of this one.
+ */
+class LazyRequestFactory : public AbstractFactory<Request>
+{
+    RequestClassInfo _info;
+public:
+    const std::string module;
+
+    LazyRequestFactory(const std::string& id, const std::string& mod);
+    virtual Request* create(CogServer&) const;
+    virtual const ClassInfo& info() const { return _info; }
+};
+
 /**
  * Request management uses the Registry base template, specialized
  * with the Request base class. The functionalities provided are:
@@ -51,8 +71,51 @@ namespace opencog
 class RequestManager
 {
 protected:
-    std::map<const std::string, AbstractFactory<Request> const*>
-        _factories;
+    // The factory table is read-copy-update: readers take a snapshot
+    // of the current map, and never lock. Writers copy the map, modify
+    // the copy, and publish it; the mutex serializes writers. This
+    // allows modules to be unloaded and reloaded while requests are
+    // being created in other threads. Snapshots only protect the map;
+    // the factories in it are protected by the read sections below.
+    typedef std::map<const std::string, AbstractFactory<Request> const*>
+        FactoryMap;
+    typedef std::shared_ptr<const FactoryMap> FactoryMapPtr;
+    mutable std::mutex _factories_mtx;
+    FactoryMapPtr _factories;
+
+    // While a module is being reloaded, the new copy registers its
+    // requests over those of the old one.
+    bool _replacing;
+
+    FactoryMapPtr getFactories(void) const;
+    FactoryMapPtr publish(FactoryMap*);
+    FactoryMapPtr removeFactory(const std::string&,
+                                AbstractFactory<Request> const* only = nullptr);
+
+    // Read sections. Code that calls into a factory marks itself as a
+    // reader in the current generation, for as long as it does so. A
+    // factory that was removed from the table can be deleted once every
+    // reader that began before the removal has left.
+    mutable std::mutex _readers_mtx;
+    mutable std::condition_variable _readers_cv;
+    uint64_t _generation;
+    mutable std::map<uint64_t, size_t> _readers;
+
+    uint64_t beginRead(void) const;
+    void endRead(uint64_t) const;
+
+    // Epoch-based reclamation. Each Request pins the epoch in which
+    // it was created, until it is destroyed. Code and data retired in
+    // some epoch can be released once no earlier epoch is pinned.
+    std::mutex _epoch_mtx;
+    uint64_t _epoch;
+    std::map<uint64_t, size_t> _pinned;
+
+    // Placeholders for requests whose modules are loaded on demand.
+    // Loading is serialized by the mutex.
+    std::mutex _lazy_mtx;
+    std::map<const std::string, std::unique_ptr<LazyRequestFactory>>
+        _lazy_factories;
 
     // Container used to store references to requests
     std::map<const std::string, Request*> requests;
@@ -75,8 +138,48 @@ public:
     bool registerRequest(const std::string& id,
                          AbstractFactory<Request> const* factory);
 
-    /** Unregister a request class/type. Takes the class' id. */
-    bool unregisterRequest(const std::string& id);
+    /** While set, registerRequest() replaces any factory already
+     *  registered under the same id, instead of failing. The old
+     *  factory is not deleted; it belongs to its module. */
+    void replaceRequests(bool);
+
+    /** Unregister a request class/type. Takes the class' id, and,
+     *  optionally, the factory; if given, the request is unregistered
+     *  only if it is still served by that factory. Does not return
+     *  until no other thread can be using the factory, so that the
+     *  caller may then delete it. */
+    bool unregisterRequest(const std::string& id,
+                           AbstractFactory<Request> const* only = nullptr);
+
+    /** Wait until every call into a factory that was in progress when
+     *  this was called has returned. */
+    void synchronize(void);
+
+    /** Register a placeholder for request `id`, which is provided by
+     *  the module `module`. The module is loaded the first time that
+     *  the request is used. */
+    bool registerLazyRequest(const std::string& id,
+                             const std::string& module);
+
+    /** Load the module providing the lazy request `id`, and return an
+     *  instance of the real request. Used by LazyRequestFactory. */
+    Request* loadLazyRequest(const std::string& id, CogServer&);
+
+    /** Pin the current epoch, and return it. */
+    uint64_t pinEpoch(void);
+
+    /** Add another pin to an epoch that is already pinned. */
+    void pinEpoch(uint64_t);
+
+    /** Release a pin obtained from pinEpoch(). */
+    void unpinEpoch(uint64_t);
+
+    /** Start a new epoch. Returns the epoch that was just closed. */
+    uint64_t advanceEpoch(void);
+
+    /** Return true if nothing created during, or before, the given
+     *  epoch is still alive. */
+    bool epochQuiescent(uint64_t);
 
     /** Returns a list with the ids of all the registered request classes. */
     std::list<const char*> requestIds(void) const;
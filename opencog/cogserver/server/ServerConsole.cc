@@ -22,7 +22,9 @@ using namespace opencog;
 
 std::string ServerConsole::_prompt;
 
-ServerConsole::ServerConsole(void)
+ServerConsole::ServerConsole(void) :
+    _shell_pinned(false),
+    _shell_epoch(0)
 {
     if (nullptr == &config()) {
         _prompt = "[0;32mopencog[1;32m> [0m";
@@ -37,6 +39,8 @@ ServerConsole::ServerConsole(void)
 
 ServerConsole::~ServerConsole()
 {
+    if (_shell_pinned)
+        cogserver().unpinEpoch(_shell_epoch);
 }
 
 // Some random RFC 854 characters
@@ -324,6 +328,13 @@ void ServerConsole::OnLine(const std::string& line)
         return;
     }
 
+    // If we get to here, any shell we had has exited.
+    if (_shell_pinned)
+    {
+        cs.unpinEpoch(_shell_epoch);
+        _shell_pinned = false;
+    }
+
     // Look for telnet stuff, and process it.
     if (IAC == (line[0] & 0xff)
         and line.size() < 40
@@ -387,6 +398,14 @@ void ServerConsole::OnLine(const std::string& line)
     request->setParameters(params);
     bool is_shell = request->isShell();
 
+    // The shell will outlive the request; take over its pin.
+    if (is_shell)
+    {
+        _shell_epoch = request->get_epoch();
+        cs.pinEpoch(_shell_epoch);
+        _shell_pinned = true;
+    }
+
     // Add the command to the processing queue.
     // Caution: after the pushRequest, the request might be executed
     // and then deleted in a different thread. It must NOT be accessed
@@ -35,6 +35,11 @@ class ServerConsole : public ConsoleSocket
 private:
     static std::string _prompt;
 
+    // While a shell is open, the epoch of the request that created it
+    // stays pinned, so that a module reload won't unmap the shell code.
+    bool _shell_pinned;
+    uint64_t _shell_epoch;
+
 protected:
     bool handle_telnet_iac(const std::string&);
 
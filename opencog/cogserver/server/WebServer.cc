@@ -20,12 +20,17 @@
 using namespace opencog;
 
 WebServer::WebServer(void) :
-	_request(nullptr)
+	_request(nullptr),
+	_shell_pinned(false),
+	_shell_epoch(0)
 {
 }
 
 WebServer::~WebServer()
 {
+	if (_shell_pinned)
+		cogserver().unpinEpoch(_shell_epoch);
+
 	logger().info("Closed WebSocket Shell");
 }
 
@@ -83,6 +88,9 @@ void WebServer::OnLine(const std::string& line)
 		params.push_back("hush");
 		_request->setParameters(params);
 		_request->set_console(this);
+		_shell_epoch = _request->get_epoch();
+		cogserver().pinEpoch(_shell_epoch);
+		_shell_pinned = true;
 		_request->execute();
 		delete _request;
 		_request = nullptr;
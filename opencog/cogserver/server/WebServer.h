@@ -30,6 +30,10 @@ class WebServer : public ConsoleSocket
 private:
 	Request* _request;
 
+	// Pinned while the shell is open; see ServerConsole.
+	bool _shell_pinned;
+	uint64_t _shell_epoch;
+
 protected:
 	virtual void OnConnection(void);
 	virtual void OnLine (const std::string&);
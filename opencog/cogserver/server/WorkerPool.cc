@@ -0,0 +1,301 @@
+/*
+ * opencog/cogserver/server/WorkerPool.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <new>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/network/NetworkServer.h>
+#include <opencog/network/ServerSocket.h>
+
+#include "WorkerPool.h"
+
+using namespace opencog;
+
+WorkerPool::Slot* WorkerPool::_slots = nullptr;
+size_t WorkerPool::_nworkers = 0;
+size_t WorkerPool::_retired_lines = 0;
+size_t WorkerPool::_retired_cpu_ms = 0;
+int WorkerPool::_self = -1;
+pid_t WorkerPool::_supervisor = 0;
+volatile sig_atomic_t WorkerPool::_stopping = 0;
+AtomSpacePtr WorkerPool::_as;
+std::mutex WorkerPool::_rmtx;
+std::condition_variable WorkerPool::_rcv;
+std::thread* WorkerPool::_reporter = nullptr;
+bool WorkerPool::_reporting = false;
+
+void WorkerPool::start(size_t n)
+{
+    // Anonymous shared memory survives the fork, and is shared with
+    // workers forked later, too.
+    void* mem = mmap(nullptr, (n + 1) * sizeof(Slot), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == mem)
+        throw RuntimeException(TRACE_INFO,
+            "Cannot map memory for %zu workers: %s", n, strerror(errno));
+    _slots = new (mem) Slot[n + 1]();
+    _nworkers = n;
+    _supervisor = getpid();
+    _slots[n].started = time(nullptr);
+
+    NetworkServer::share_port(true);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        pid_t pid = spawn(i);
+        if (0 == pid) return;
+        if (pid < 0)
+            throw RuntimeException(TRACE_INFO,
+                "Cannot fork worker %zu: %s", i, strerror(errno));
+    }
+    supervise();
+}
+
+/// Fork worker `i`. Returns zero in the worker, and its pid, or -1,
+/// in the supervisor.
+pid_t WorkerPool::spawn(size_t i)
+{
+    pid_t pid = fork();
+    if (0 < pid)
+    {
+        _slots[i].pid = pid;
+        _slots[i].started = time(nullptr);
+        return pid;
+    }
+    if (pid < 0) return pid;
+
+    _self = i;
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGINT, SIG_DFL);
+
+    // Don't outlive the supervisor; it would not pass on a stop.
+    prctl(PR_SET_PDEATHSIG, SIGTERM, 0, 0, 0);
+    if (getppid() != _supervisor) _exit(1);
+
+    _slots[i].pid = getpid();
+    _slots[i].started = time(nullptr);
+    _slots[i].updated = 0;
+    return 0;
+}
+
+/// Signal handler in the supervisor. Only async-signal-safe calls.
+void WorkerPool::stop(int sig)
+{
+    _stopping = 1;
+    for (size_t i = 0; i < _nworkers; i++)
+    {
+        pid_t pid = _slots[i].pid;
+        if (0 < pid) kill(pid, sig);
+    }
+}
+
+/// Add up the workers' numbers into the last slot. Runs in the
+/// supervisor, which is the only one that sees every restart.
+void WorkerPool::tally(void)
+{
+    Slot& total = _slots[_nworkers];
+    size_t socks = 0, lines = _retired_lines, cpu_ms = _retired_cpu_ms;
+    size_t rss = 0, restarts = 0;
+    for (size_t i = 0; i < _nworkers; i++)
+    {
+        const Slot& slot = _slots[i];
+        restarts += slot.restarts;
+        if (0 == slot.pid) continue;
+        socks += slot.open_socks;
+        lines += slot.lines;
+        cpu_ms += slot.cpu_ms;
+        rss += slot.maxrss_kb;
+    }
+    total.open_socks = socks;
+    total.lines = lines;
+    total.cpu_ms = cpu_ms;
+    total.maxrss_kb = rss;
+    total.restarts = restarts;
+    total.updated = time(nullptr);
+}
+
+/// Wait for workers to die, and start them again, until told to stop.
+/// Returns only in a worker that was started again.
+void WorkerPool::supervise(void)
+{
+    prctl(PR_SET_NAME, "cogserv:super", 0, 0, 0);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = stop;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGTERM, &sa, nullptr);
+    sigaction(SIGINT, &sa, nullptr);
+
+    fprintf(stderr, "Supervisor %d started %zu workers\n",
+            _supervisor, _nworkers);
+
+    size_t alive = _nworkers;
+    while (0 < alive)
+    {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, WNOHANG);
+        if (0 == pid)
+        {
+            tally();
+            sleep(1);
+            continue;
+        }
+        if (pid < 0)
+        {
+            if (EINTR == errno) continue;
+            break;
+        }
+
+        size_t i = 0;
+        while (i < _nworkers and _slots[i].pid != pid) i++;
+        if (_nworkers == i) continue;
+
+        // Keep what the dead worker did in the totals.
+        _retired_lines += _slots[i].lines;
+        _retired_cpu_ms += _slots[i].cpu_ms;
+        _slots[i].lines = 0;
+        _slots[i].cpu_ms = 0;
+        _slots[i].open_socks = 0;
+        _slots[i].pid = 0;
+        alive--;
+        if (_stopping) continue;
+
+        if (WIFSIGNALED(status))
+            fprintf(stderr, "Worker %zu (pid %d) killed by signal %d (%s)\n",
+                    i, pid, WTERMSIG(status), strsignal(WTERMSIG(status)));
+        else
+            fprintf(stderr, "Worker %zu (pid %d) exited with status %d\n",
+                    i, pid, WEXITSTATUS(status));
+
+        // A worker that dies while starting up would die again;
+        // don't spin on it.
+        if (time(nullptr) < _slots[i].started + 5) sleep(1);
+        if (_stopping) continue;
+
+        _slots[i].restarts++;
+        pid = spawn(i);
+        if (0 == pid) return;
+        if (0 < pid)
+            alive++;
+        else
+            fprintf(stderr, "Cannot restart worker %zu: %s\n",
+                    i, strerror(errno));
+    }
+    exit(_stopping ? 0 : 1);
+}
+
+/* ============================================================== */
+
+void WorkerPool::update(void)
+{
+    Slot& slot = _slots[_self];
+    struct rusage rus;
+    getrusage(RUSAGE_SELF, &rus);
+
+    slot.open_socks = ServerSocket::get_num_open_sockets();
+    slot.lines = ServerSocket::total_line_count.load();
+    slot.cpu_ms =
+        (rus.ru_utime.tv_sec + rus.ru_stime.tv_sec) * 1000 +
+        (rus.ru_utime.tv_usec + rus.ru_stime.tv_usec) / 1000;
+    slot.maxrss_kb = rus.ru_maxrss;
+    slot.atoms = _as ? _as->get_size() : 0;
+    slot.updated = time(nullptr);
+}
+
+void WorkerPool::report_loop(void)
+{
+    prctl(PR_SET_NAME, "cogserv:report", 0, 0, 0);
+    std::unique_lock<std::mutex> lck(_rmtx);
+    while (_reporting)
+    {
+        _rcv.wait_for(lck, std::chrono::seconds(1));
+        if (_reporting) update();
+    }
+}
+
+void WorkerPool::start_reports(const AtomSpacePtr& as)
+{
+    if (not is_worker() or _reporter) return;
+    _as = as;
+    update();
+    _reporting = true;
+    _reporter = new std::thread(report_loop);
+}
+
+void WorkerPool::stop_reports(void)
+{
+    if (nullptr == _reporter) return;
+    {
+        std::lock_guard<std::mutex> lck(_rmtx);
+        _reporting = false;
+        _rcv.notify_all();
+    }
+    _reporter->join();
+    delete _reporter;
+    _reporter = nullptr;
+    _as = nullptr;
+}
+
+std::string WorkerPool::display_stats(void)
+{
+    if (not is_worker()) return "";
+    update();
+
+    time_t now = time(nullptr);
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "workers: %zu  this: %d  supervisor: %d\n"
+             "  WRK    PID  UP-SECS RESTRT SOCKS      LINES   CPU-SECS"
+             "  MAXRSS-KB      ATOMS  AGE\n",
+             _nworkers, _self, _supervisor);
+    std::string rc = buf;
+
+    for (size_t i = 0; i < _nworkers; i++)
+    {
+        const Slot& slot = _slots[i];
+        pid_t pid = slot.pid;
+        if (0 == pid)
+        {
+            snprintf(buf, sizeof(buf), "  %3zu   down  restrt: %zu\n",
+                     i, slot.restarts.load());
+            rc += buf;
+            continue;
+        }
+        time_t updated = slot.updated;
+        snprintf(buf, sizeof(buf),
+                 "  %3zu %6d %8ld %6zu %5zu %10zu %10.1f %10zu %10zu %4ld\n",
+                 i, pid, (long) (now - slot.started), slot.restarts.load(),
+                 slot.open_socks.load(), slot.lines.load(),
+                 slot.cpu_ms / 1000.0, slot.maxrss_kb.load(),
+                 slot.atoms.load(), updated ? (long) (now - updated) : -1L);
+        rc += buf;
+    }
+
+    // Kept by the supervisor; these include restarted workers.
+    const Slot& total = _slots[_nworkers];
+    time_t updated = total.updated;
+    snprintf(buf, sizeof(buf),
+             "  all %6d %8ld %6zu %5zu %10zu %10.1f %10zu %10s %4ld\n\n",
+             _supervisor, (long) (now - total.started),
+             total.restarts.load(), total.open_socks.load(),
+             total.lines.load(), total.cpu_ms / 1000.0,
+             total.maxrss_kb.load(), "",
+             updated ? (long) (now - updated) : -1L);
+    return rc + buf;
+}
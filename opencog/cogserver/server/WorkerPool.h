@@ -0,0 +1,114 @@
+/*
+ * opencog/cogserver/server/WorkerPool.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_WORKER_POOL_H
+#define _OPENCOG_WORKER_POOL_H
+
+#include <signal.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Pre-forked worker processes, sharing the listening ports.
+ *
+ * A single server process is limited by the locks inside the
+ * AtomSpace, and by the language runtimes, which do not scale well
+ * past a handful of threads. For read-mostly loads, it is better to
+ * run several processes. start() forks that many workers, before the
+ * server is created; each worker then goes on to build its own
+ * server, load its own snapshot, and open the ports with SO_REUSEPORT,
+ * so that the kernel spreads new connections across them. A client
+ * stays with the worker it landed on, for as long as it is connected.
+ *
+ * The process that called start() becomes the supervisor. It does
+ * nothing but wait: a worker that dies is started again, and SIGTERM
+ * or SIGINT is passed on to all of them. It does not create a server,
+ * or any threads, and so does not log; it reports to stderr.
+ *
+ * Each worker keeps a few numbers in memory shared with the others,
+ * updated every second. Once a second, the supervisor adds them up,
+ * together with the last numbers of workers that have since been
+ * restarted, so that the totals cover the life of the pool, and not
+ * only of the workers now running. display_stats() shows every worker
+ * and the totals, so the `stats` command, in any worker, covers the
+ * whole pool.
+ */
+class WorkerPool
+{
+    struct Slot
+    {
+        std::atomic<pid_t> pid;
+        std::atomic<time_t> started;
+        std::atomic<time_t> updated;
+        std::atomic<size_t> restarts;
+        std::atomic<size_t> open_socks;
+        std::atomic<size_t> lines;
+        std::atomic<size_t> cpu_ms;
+        std::atomic<size_t> maxrss_kb;
+        std::atomic<size_t> atoms;
+    };
+
+    // One slot per worker, then the totals, kept by the supervisor.
+    static Slot* _slots;
+    static size_t _nworkers;
+    static size_t _retired_lines;
+    static size_t _retired_cpu_ms;
+    static int _self;
+    static pid_t _supervisor;
+    static volatile sig_atomic_t _stopping;
+    static AtomSpacePtr _as;
+
+    static std::mutex _rmtx;
+    static std::condition_variable _rcv;
+    static std::thread* _reporter;
+    static bool _reporting;
+
+    static pid_t spawn(size_t);
+    static void supervise(void);
+    static void stop(int);
+    static void tally(void);
+    static void update(void);
+    static void report_loop(void);
+
+public:
+    /** Fork `n` workers. Returns only in the workers; the calling
+     *  process supervises them, and exits when they are stopped.
+     *  Throws if the shared memory cannot be had. */
+    static void start(size_t n);
+
+    /** True in a worker process. */
+    static bool is_worker(void) { return 0 <= _self; }
+
+    /** Start updating this worker's numbers, once a second. */
+    static void start_reports(const AtomSpacePtr&);
+
+    /** Stop updating, and wait for the thread doing it to exit.
+     *  Called by the server, before it goes away. */
+    static void stop_reports(void);
+
+    /** One line per worker, and the totals. Empty if not a worker. */
+    static std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_WORKER_POOL_H
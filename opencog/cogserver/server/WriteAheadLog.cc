@@ -0,0 +1,314 @@
+/*
+ * opencog/cogserver/server/WriteAheadLog.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include <fstream>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+
+#include "ChangeFeed.h"
+#include "WriteAheadLog.h"
+
+using namespace opencog;
+
+WriteAheadLog::WriteAheadLog(void) :
+    _fd(-1),
+    _sync(true),
+    _window(5),
+    _max_bytes(1024*1024),
+    _enabled(false),
+    _thread(nullptr),
+    _stop(false),
+    _flush_now(false),
+    _appended(0),
+    _durable(0),
+    _nrecords(0),
+    _nsyncs(0),
+    _sync_ms(0.0),
+    _max_sync_ms(0.0),
+    _write_errno(0)
+{
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    close();
+}
+
+/* ============================================================== */
+
+std::string WriteAheadLog::recover(const std::string& path,
+                                   const AtomSpacePtr& asp,
+                                   ChangeFeed& feed)
+{
+    std::ifstream in(path);
+    if (not in.is_open())
+        return "No write-ahead log at " + path + "\n";
+
+    auto start = std::chrono::steady_clock::now();
+    size_t nchanges = 0;
+    size_t nerrors = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        // A crash in the middle of a write leaves a partial last
+        // line; that change was never reported as done.
+        if (in.eof()) break;
+        if (0 == line.size()) continue;
+        try
+        {
+            feed.apply(asp, line);
+            nchanges++;
+        }
+        catch (const std::exception& ex)
+        {
+            if (nerrors++ < 10)
+                logger().warn("[WriteAheadLog] cannot replay %.80s: %s",
+                              line.c_str(), ex.what());
+        }
+    }
+    std::chrono::duration<double> secs =
+        std::chrono::steady_clock::now() - start;
+
+    char buf[512];
+    snprintf(buf, sizeof(buf),
+             "Replayed %zu changes (%zu errors) from %s in %.3f seconds\n",
+             nchanges, nerrors, path.c_str(), secs.count());
+    logger().info("%s", buf);
+    return buf;
+}
+
+void WriteAheadLog::open(const std::string& path)
+{
+    close();
+
+    _fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (_fd < 0)
+        throw IOException(TRACE_INFO, "Cannot open %s: %s",
+                          path.c_str(), strerror(errno));
+
+    std::string mode = config().get("WAL_DURABILITY", "sync");
+    if (mode != "sync" and mode != "async")
+        logger().warn("[WriteAheadLog] unknown WAL_DURABILITY \"%s\"; "
+                      "using sync", mode.c_str());
+    _sync = (mode != "async");
+    _window = std::chrono::milliseconds(
+        config().get_int("WAL_COMMIT_MS", 5));
+    _max_bytes = config().get_int("WAL_COMMIT_BYTES", 1024*1024);
+
+    _path = path;
+    _stop = false;
+    _opened = std::chrono::steady_clock::now();
+    _nrecords = 0;
+    _nsyncs = 0;
+    _sync_ms = 0.0;
+    _max_sync_ms = 0.0;
+    _thread = new std::thread(&WriteAheadLog::commit_loop, this);
+    _enabled = true;
+
+    logger().info("[WriteAheadLog] logging to %s; %s, commit every "
+                  "%ld ms or %zu bytes", path.c_str(),
+                  _sync ? "sync" : "async", (long) _window.count(),
+                  _max_bytes);
+}
+
+void WriteAheadLog::close(void)
+{
+    if (nullptr == _thread) return;
+
+    _enabled = false;
+    {
+        std::lock_guard<std::mutex> lck(_mtx);
+        _stop = true;
+        _flush_cv.notify_all();
+    }
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+
+    ::close(_fd);
+    _fd = -1;
+}
+
+/* ============================================================== */
+
+/// Throw, if the log cannot be written. Caller must hold the lock.
+void WriteAheadLog::check_failed(void)
+{
+    if (0 == _write_errno) return;
+    throw IOException(TRACE_INFO,
+        "Write-ahead log %s failed (%s); the change is not durable",
+        _path.c_str(), strerror(_write_errno));
+}
+
+uint64_t WriteAheadLog::append(const std::string& rec)
+{
+    std::lock_guard<std::mutex> lck(_mtx);
+    check_failed();
+    if (_pending.empty())
+    {
+        _pending_since = std::chrono::steady_clock::now();
+        _flush_cv.notify_all();
+    }
+    _pending += rec;
+    _appended += rec.size();
+    _nrecords++;
+    if (_max_bytes <= _pending.size())
+        _flush_cv.notify_all();
+    return _appended;
+}
+
+void WriteAheadLog::wait_durable(uint64_t pos)
+{
+    if (not _sync) return;
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    while (_durable < pos and not _stop and 0 == _write_errno)
+        _durable_cv.wait(lck);
+    if (_durable < pos) check_failed();
+}
+
+void WriteAheadLog::checkpoint(void)
+{
+    if (not _enabled) return;
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    _flush_now = true;
+    _flush_cv.notify_all();
+    while (_durable < _appended and not _stop and 0 == _write_errno)
+        _durable_cv.wait(lck);
+    _flush_now = false;
+
+    // Appends are blocked by the lock, and nothing is in flight,
+    // so nothing can land between the flush and the truncate. After
+    // a failure, whatever was not written is in the saved AtomSpace.
+    if (ftruncate(_fd, 0) or fdatasync(_fd))
+        throw IOException(TRACE_INFO, "Cannot truncate %s: %s",
+                          _path.c_str(), strerror(errno));
+    if (_write_errno)
+    {
+        logger().info("[WriteAheadLog] logging to %s again",
+                      _path.c_str());
+        _write_errno = 0;
+        _pending.clear();
+        _durable = _appended;
+    }
+    logger().info("[WriteAheadLog] checkpoint; %s emptied", _path.c_str());
+}
+
+/* ============================================================== */
+
+/// Write out one batch, and fsync it. Called without the lock.
+/// Returns zero, or the errno of the failure.
+int WriteAheadLog::write_out(const std::string& batch)
+{
+    const char* p = batch.data();
+    size_t left = batch.size();
+    while (0 < left)
+    {
+        ssize_t n = write(_fd, p, left);
+        if (n < 0 and EINTR == errno) continue;
+        if (n < 0)
+        {
+            int err = errno;
+            logger().error("[WriteAheadLog] write to %s failed: %s",
+                           _path.c_str(), strerror(err));
+            return err;
+        }
+        p += n;
+        left -= n;
+    }
+    if (fdatasync(_fd))
+    {
+        int err = errno;
+        logger().error("[WriteAheadLog] fsync of %s failed: %s",
+                       _path.c_str(), strerror(err));
+        return err;
+    }
+    return 0;
+}
+
+void WriteAheadLog::commit_loop(void)
+{
+    prctl(PR_SET_NAME, "cogserv:wal", 0, 0, 0);
+
+    std::unique_lock<std::mutex> lck(_mtx);
+    while (true)
+    {
+        while (_pending.empty() and not _stop)
+            _flush_cv.wait(lck);
+        if (_pending.empty()) break;
+
+        // Let the commit window fill up, so that one fsync covers
+        // as many changes as possible.
+        auto deadline = _pending_since + _window;
+        while (not _stop and not _flush_now and
+               _pending.size() < _max_bytes and
+               std::chrono::steady_clock::now() < deadline)
+            _flush_cv.wait_until(lck, deadline);
+
+        std::string batch;
+        batch.swap(_pending);
+        uint64_t upto = _appended;
+
+        // After a failure, the file may end in a partial record; more
+        // records after it would be misread. Wait for a checkpoint.
+        if (_write_errno) continue;
+        lck.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        int err = write_out(batch);
+        std::chrono::duration<double, std::milli> ms =
+            std::chrono::steady_clock::now() - start;
+
+        lck.lock();
+
+        // On an error, the waiters are woken, to find that their
+        // changes never made it to disk.
+        if (err) _write_errno = err;
+        else _durable = upto;
+        _nsyncs++;
+        _sync_ms += ms.count();
+        if (_max_sync_ms < ms.count()) _max_sync_ms = ms.count();
+        _durable_cv.notify_all();
+    }
+
+    // Release anyone still waiting; on the way out, all that was
+    // appended has been written, unless there was an error.
+    if (0 == _write_errno) _durable = _appended;
+    _durable_cv.notify_all();
+}
+
+/* ============================================================== */
+
+std::string WriteAheadLog::display_stats(void)
+{
+    if (not _enabled) return "";
+
+    std::lock_guard<std::mutex> lck(_mtx);
+    std::chrono::duration<double> up =
+        std::chrono::steady_clock::now() - _opened;
+
+    char buff[256];
+    snprintf(buff, sizeof(buff),
+        "wal: %s %ldms  records: %zu (%.0f/s)  fsyncs: %zu  "
+        "per-fsync: %.1f  avg: %.2fms  max: %.2fms%s%s\n",
+        _sync ? "sync" : "async", (long) _window.count(),
+        _nrecords, _nrecords / up.count(), _nsyncs,
+        _nsyncs ? ((double) _nrecords) / _nsyncs : 0.0,
+        _nsyncs ? _sync_ms / _nsyncs : 0.0, _max_sync_ms,
+        _write_errno ? "  FAILED: " : "",
+        _write_errno ? strerror(_write_errno) : "");
+    return buff;
+}
@@ -0,0 +1,128 @@
+/*
+ * opencog/cogserver/server/WriteAheadLog.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_WRITE_AHEAD_LOG_H
+#define _OPENCOG_WRITE_AHEAD_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_server
+ *  @{
+ */
+
+class ChangeFeed;
+
+/**
+ * Append-only log of AtomSpace changes, kept on disk, so that changes
+ * made since the AtomSpace was last saved survive a crash.
+ *
+ * Every change published to the ChangeFeed is appended to WAL_FILE,
+ * one s-expression per line, in the same form as the change feed.
+ * Writes are batched: a background thread writes out and fsyncs
+ * whatever has accumulated once WAL_COMMIT_MS milliseconds have
+ * passed since the first pending change, or as soon as
+ * WAL_COMMIT_BYTES bytes are pending, whichever comes first.
+ *
+ * WAL_DURABILITY picks what the client waits for:
+ *   sync  -- a command does not return until its changes are on
+ *            disk. Concurrent commands share one fsync ("group
+ *            commit"), so the cost is at most one commit window.
+ *   async -- commands do not wait; a crash loses at most the last
+ *            commit window of changes.
+ *
+ * If a write or an fsync fails, nothing more is written: the log may
+ * end in a partial record. From then on, append() and wait_durable()
+ * throw, so that clients are told that their changes are not durable.
+ * A checkpoint() empties the log, and starts logging again.
+ *
+ * At startup, recover() replays the log into the AtomSpace. Once the
+ * AtomSpace has been saved elsewhere, e.g. with a StorageNode or a
+ * snapshot, checkpoint() empties the log.
+ */
+class WriteAheadLog
+{
+    std::string _path;
+    int _fd;
+    bool _sync;
+    std::chrono::milliseconds _window;
+    size_t _max_bytes;
+    std::atomic_bool _enabled;
+
+    std::mutex _mtx;
+    std::condition_variable _flush_cv;
+    std::condition_variable _durable_cv;
+    std::thread* _thread;
+    bool _stop;
+    bool _flush_now;
+
+    // Changes not yet handed to the writer thread. Positions are
+    // counted in bytes, from the time the server started.
+    std::string _pending;
+    std::chrono::steady_clock::time_point _pending_since;
+    uint64_t _appended;
+    uint64_t _durable;
+
+    // Statistics
+    std::chrono::steady_clock::time_point _opened;
+    size_t _nrecords;
+    size_t _nsyncs;
+    double _sync_ms;
+    double _max_sync_ms;
+    int _write_errno;
+
+    void commit_loop(void);
+    int write_out(const std::string&);
+    void check_failed(void);
+
+public:
+    WriteAheadLog(void);
+    ~WriteAheadLog();
+
+    bool enabled(void) const { return _enabled; }
+
+    /** Replay `path` into the AtomSpace, publishing each change to
+     *  the feed. Returns a short report. Call before open(). Any
+     *  file of changes in this form can be replayed this way. */
+    static std::string recover(const std::string& path,
+                               const AtomSpacePtr&, ChangeFeed&);
+
+    /** Start logging to `path`, as configured by WAL_DURABILITY,
+     *  WAL_COMMIT_MS and WAL_COMMIT_BYTES. Throws on error. */
+    void open(const std::string& path);
+    void close(void);
+
+    /** Queue a change; return its position in the log. Throws if
+     *  the log has failed. */
+    uint64_t append(const std::string&);
+
+    /** In sync mode, wait until everything up to `pos` is on disk.
+     *  Throws if it never will be. */
+    void wait_durable(uint64_t pos);
+
+    /** Write out everything pending, and then empty the log file.
+     *  Clears an earlier write failure. */
+    void checkpoint(void);
+
+    /** One line: durability, records/s, fsyncs and their cost.
+     *  Empty, if the log is not open. */
+    std::string display_stats(void);
+};
+
+/** @}*/
+}  // namespace
+
+#endif // _OPENCOG_WRITE_AHEAD_LOG_H
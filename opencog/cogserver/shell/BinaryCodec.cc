@@ -0,0 +1,321 @@
+/*
+ * opencog/cogserver/shell/BinaryCodec.cc
+ *
+ * Binary encoding of Atoms and Values.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <string.h>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+#include <opencog/atoms/value/ValueFactory.h>
+
+#include "BinaryCodec.h"
+
+using namespace opencog;
+
+// Deep nesting would overflow the stack; frames can be large enough
+// to hold millions of levels.
+#define BINARY_MAX_DEPTH 512
+
+/* ============================================================== */
+// Encoder. Integers are written a byte at a time, so that the byte
+// order on the wire does not depend on the host.
+
+void BinaryEncoder::put_u8(uint8_t v)
+{
+	_buf.push_back((char) v);
+}
+
+void BinaryEncoder::put_u16(uint16_t v)
+{
+	_buf.push_back((char) (v & 0xff));
+	_buf.push_back((char) (v >> 8));
+}
+
+void BinaryEncoder::put_u32(uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+		_buf.push_back((char) ((v >> (8*i)) & 0xff));
+}
+
+void BinaryEncoder::put_double(double d)
+{
+	uint64_t v;
+	memcpy(&v, &d, sizeof(v));
+	for (int i = 0; i < 8; i++)
+		_buf.push_back((char) ((v >> (8*i)) & 0xff));
+}
+
+void BinaryEncoder::put_string(const std::string& s)
+{
+	put_u32(s.size());
+	_buf.append(s);
+}
+
+void BinaryEncoder::put_atom(const Handle& h)
+{
+	if (nullptr == h)
+	{
+		put_type(NOTYPE);
+		return;
+	}
+
+	put_type(h->get_type());
+	if (h->is_node())
+	{
+		put_string(h->get_name());
+		return;
+	}
+
+	const HandleSeq& oset = h->getOutgoingSet();
+	put_u32(oset.size());
+	for (const Handle& ho : oset)
+		put_atom(ho);
+}
+
+void BinaryEncoder::put_atoms(const HandleSeq& hs)
+{
+	put_u32(hs.size());
+	for (const Handle& h : hs)
+		put_atom(h);
+}
+
+void BinaryEncoder::put_value(const ValuePtr& v)
+{
+	if (nullptr == v)
+	{
+		put_type(NOTYPE);
+		return;
+	}
+
+	if (v->is_atom())
+	{
+		put_atom(HandleCast(v));
+		return;
+	}
+
+	Type t = v->get_type();
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		const std::vector<double>& dv = FloatValueCast(v)->value();
+		put_type(t);
+		put_u32(dv.size());
+		for (double d : dv) put_double(d);
+		return;
+	}
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		const std::vector<std::string>& sv = StringValueCast(v)->value();
+		put_type(t);
+		put_u32(sv.size());
+		for (const std::string& s : sv) put_string(s);
+		return;
+	}
+
+	if (nameserver().isA(t, LINK_VALUE))
+	{
+		const ValueSeq& vs = LinkValueCast(v)->value();
+		put_type(t);
+		put_u32(vs.size());
+		for (const ValuePtr& vp : vs) put_value(vp);
+		return;
+	}
+
+	throw RuntimeException(TRACE_INFO,
+		"Cannot encode value of type %s",
+		nameserver().getTypeName(t).c_str());
+}
+
+/* ============================================================== */
+
+BinaryDecoder::BinaryDecoder(const std::string& buf, AtomSpace* as) :
+	_p(buf.data()),
+	_end(buf.data() + buf.size()),
+	_as(as),
+	_depth(0)
+{
+}
+
+namespace {
+/// Counts one level of nesting, for as long as it is in scope.
+struct Nest
+{
+	int& _d;
+	Nest(int& d) : _d(d)
+	{
+		if (BINARY_MAX_DEPTH < ++_d)
+		{
+			_d--;
+			throw SyntaxException(TRACE_INFO,
+				"Nested more than %d deep", BINARY_MAX_DEPTH);
+		}
+	}
+	~Nest() { _d--; }
+};
+}
+
+void BinaryDecoder::need(size_t n) const
+{
+	if ((size_t) (_end - _p) < n)
+		throw SyntaxException(TRACE_INFO,
+			"Truncated data: need %zu bytes, have %zu", n,
+			(size_t) (_end - _p));
+}
+
+uint8_t BinaryDecoder::get_u8(void)
+{
+	need(1);
+	return (uint8_t) *_p++;
+}
+
+uint16_t BinaryDecoder::get_u16(void)
+{
+	need(2);
+	const unsigned char* u = (const unsigned char*) _p;
+	_p += 2;
+	return u[0] | (u[1] << 8);
+}
+
+uint32_t BinaryDecoder::get_u32(void)
+{
+	need(4);
+	const unsigned char* u = (const unsigned char*) _p;
+	_p += 4;
+	return u[0] | (u[1] << 8) | (u[2] << 16) | ((uint32_t) u[3] << 24);
+}
+
+double BinaryDecoder::get_double(void)
+{
+	need(8);
+	const unsigned char* u = (const unsigned char*) _p;
+	_p += 8;
+	uint64_t v = 0;
+	for (int i = 7; 0 <= i; i--)
+		v = (v << 8) | u[i];
+	double d;
+	memcpy(&d, &v, sizeof(d));
+	return d;
+}
+
+std::string BinaryDecoder::get_string(void)
+{
+	uint32_t len = get_u32();
+	need(len);
+	std::string s(_p, len);
+	_p += len;
+	return s;
+}
+
+Type BinaryDecoder::get_type(void)
+{
+	Type t = get_u16();
+	if (NOTYPE != t and nameserver().getNumberOfClasses() <= t)
+		throw SyntaxException(TRACE_INFO, "Unknown type %u", t);
+	return t;
+}
+
+Handle BinaryDecoder::get_atom_body(Type t, bool lookup)
+{
+	Nest nest(_depth);
+	if (nameserver().isNode(t))
+	{
+		std::string name(get_string());
+		if (lookup) return _as->get_node(t, std::move(name));
+		return _as->add_node(t, std::move(name));
+	}
+
+	if (not nameserver().isLink(t))
+		throw SyntaxException(TRACE_INFO, "Expecting an Atom type, got %s",
+			nameserver().getTypeName(t).c_str());
+
+	// Each outgoing atom takes at least two bytes; this bounds the
+	// reservation below against a bogus arity.
+	uint32_t arity = get_u32();
+	need(2 * (size_t) arity);
+
+	// When looking up, a missing outgoing atom means the link is
+	// missing too; but the rest of it must still be read.
+	bool missing = false;
+	HandleSeq oset;
+	oset.reserve(arity);
+	for (uint32_t i = 0; i < arity; i++)
+	{
+		Handle ho(get_atom(lookup));
+		if (nullptr == ho)
+		{
+			if (not lookup)
+				throw SyntaxException(TRACE_INFO, "Link holds an empty atom");
+			missing = true;
+			continue;
+		}
+		oset.emplace_back(ho);
+	}
+
+	if (missing) return Handle::UNDEFINED;
+	if (lookup) return _as->get_link(t, std::move(oset));
+	return _as->add_link(t, std::move(oset));
+}
+
+Handle BinaryDecoder::get_atom(bool lookup)
+{
+	Type t = get_type();
+	if (NOTYPE == t) return Handle::UNDEFINED;
+	return get_atom_body(t, lookup);
+}
+
+ValuePtr BinaryDecoder::get_value(void)
+{
+	Nest nest(_depth);
+	Type t = get_type();
+	if (NOTYPE == t) return nullptr;
+
+	if (nameserver().isA(t, ATOM))
+		return get_atom_body(t, false);
+
+	if (nameserver().isA(t, FLOAT_VALUE))
+	{
+		uint32_t n = get_u32();
+		need(8 * (size_t) n);
+		std::vector<double> dv;
+		dv.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			dv.push_back(get_double());
+		return valueserver().create(t, std::move(dv));
+	}
+
+	if (nameserver().isA(t, STRING_VALUE))
+	{
+		uint32_t n = get_u32();
+		need(4 * (size_t) n);
+		std::vector<std::string> sv;
+		sv.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			sv.emplace_back(get_string());
+		return valueserver().create(t, std::move(sv));
+	}
+
+	if (nameserver().isA(t, LINK_VALUE))
+	{
+		uint32_t n = get_u32();
+		need(2 * (size_t) n);
+		ValueSeq vs;
+		vs.reserve(n);
+		for (uint32_t i = 0; i < n; i++)
+			vs.emplace_back(get_value());
+		return valueserver().create(t, std::move(vs));
+	}
+
+	throw SyntaxException(TRACE_INFO, "Cannot decode value of type %s",
+		nameserver().getTypeName(t).c_str());
+}
+
+/* ===================== END OF FILE ============================ */
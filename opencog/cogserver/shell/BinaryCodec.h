@@ -0,0 +1,105 @@
+/*
+ * opencog/cogserver/shell/BinaryCodec.h
+ *
+ * Binary encoding of Atoms and Values.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_BINARY_CODEC_H
+#define _OPENCOG_BINARY_CODEC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Binary wire format for Atoms and Values, used by the BinaryShell.
+ *
+ * All integers are little-endian. Types are sent as the uint16 type
+ * numbers of the server; a client obtains the name of each type once,
+ * at the start of a session, and does not need to send names after
+ * that. Strings are a uint32 byte count followed by the bytes.
+ *
+ *   Atom   := Type Node-or-Link
+ *   Node   := String                        (the node name)
+ *   Link   := uint32 arity, Atom * arity    (the outgoing set)
+ *   Value  := Type (nothing, if the type is NOTYPE)
+ *           | Type Node-or-Link             (if the type is an Atom)
+ *           | Type uint32 n, double * n     (FloatValue and subtypes)
+ *           | Type uint32 n, String * n     (StringValue and subtypes)
+ *           | Type uint32 n, Value * n      (LinkValue and subtypes)
+ *
+ * Doubles are raw IEEE-754, little-endian. A NOTYPE value stands in
+ * for "no such atom" or "no such value".
+ */
+class BinaryEncoder
+{
+	private:
+		std::string _buf;
+
+	public:
+		void put_u8(uint8_t);
+		void put_u16(uint16_t);
+		void put_u32(uint32_t);
+		void put_double(double);
+		void put_string(const std::string&);
+		void put_type(Type t) { put_u16(t); }
+
+		void put_atom(const Handle&);
+		void put_value(const ValuePtr&);
+		void put_atoms(const HandleSeq&);
+
+		const std::string& str(void) const { return _buf; }
+		void clear(void) { _buf.clear(); }
+};
+
+/**
+ * Decoder for the format described in BinaryEncoder. Atoms are either
+ * added to the given AtomSpace, or, if `lookup` is set, only looked
+ * up in it; in that case, get_atom() returns Handle::UNDEFINED for an
+ * atom that is not there. Throws a SyntaxException on truncated or
+ * malformed data, and on Links or LinkValues nested more than
+ * BINARY_MAX_DEPTH deep.
+ */
+class BinaryDecoder
+{
+	private:
+		const char* _p;
+		const char* _end;
+		AtomSpace* _as;
+		int _depth;
+
+		void need(size_t) const;
+		Handle get_atom_body(Type, bool lookup);
+
+	public:
+		BinaryDecoder(const std::string&, AtomSpace*);
+
+		uint8_t get_u8(void);
+		uint16_t get_u16(void);
+		uint32_t get_u32(void);
+		double get_double(void);
+		std::string get_string(void);
+		Type get_type(void);
+
+		Handle get_atom(bool lookup = false);
+		ValuePtr get_value(void);
+
+		bool at_end(void) const { return _p == _end; }
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_BINARY_CODEC_H
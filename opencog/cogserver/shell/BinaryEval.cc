@@ -0,0 +1,264 @@
+/*
+ * opencog/cogserver/shell/BinaryEval.cc
+ *
+ * Evaluator for the binary Atomese protocol.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "BinaryEval.h"
+
+using namespace opencog;
+
+BinaryEval::BinaryEval(const AtomSpacePtr& asp) :
+	GenericEval(),
+	_atomspace(asp),
+	_running(false)
+{
+}
+
+BinaryEval::~BinaryEval()
+{
+}
+
+/* ============================================================== */
+
+static void put_alist(BinaryEncoder& enc, const Handle& h)
+{
+	HandleSet keys(h->getKeys());
+	enc.put_u32(keys.size());
+	for (const Handle& key : keys)
+	{
+		enc.put_atom(key);
+		enc.put_value(h->getValue(key));
+	}
+}
+
+static Handle need_atom(const Handle& h)
+{
+	if (nullptr == h)
+		throw InvalidParamException(TRACE_INFO, "No such atom");
+	return h;
+}
+
+/// Decode one command, run it, and encode the reply body.
+void BinaryEval::dispatch(BinaryDecoder& dec, BinaryEncoder& enc)
+{
+	AtomSpace* as = _atomspace.get();
+	ChangeFeed& feed = cogserver().changeFeed();
+	uint8_t op = dec.get_u8();
+	switch (op)
+	{
+		case TYPES:
+		{
+			Type nt = nameserver().getNumberOfClasses();
+			enc.put_u16(nt);
+			for (Type t = 0; t < nt; t++)
+				enc.put_string(nameserver().getTypeName(t));
+			break;
+		}
+		case NODE:
+		{
+			Type t = dec.get_type();
+			std::string name(dec.get_string());
+			enc.put_atom(as->get_node(t, std::move(name)));
+			break;
+		}
+		case LINK:
+		{
+			Type t = dec.get_type();
+			uint32_t arity = dec.get_u32();
+			HandleSeq oset;
+			bool missing = false;
+			for (uint32_t i = 0; i < arity; i++)
+			{
+				Handle h(dec.get_atom(true));
+				if (nullptr == h) missing = true;
+				else oset.emplace_back(h);
+			}
+			if (missing) enc.put_atom(Handle::UNDEFINED);
+			else enc.put_atom(as->get_link(t, std::move(oset)));
+			break;
+		}
+		case STORE_ATOM:
+		case SET_VALUES:
+		{
+			Handle h(need_atom(STORE_ATOM == op ? dec.get_atom() :
+			                   dec.get_atom(true)));
+			if (STORE_ATOM == op) feed.atom_added(h);
+			uint32_t n = dec.get_u32();
+			for (uint32_t i = 0; i < n; i++)
+			{
+				Handle key(need_atom(dec.get_atom()));
+				ValuePtr v(dec.get_value());
+				as->set_value(h, key, v);
+				feed.value_changed(h, key, v);
+			}
+			break;
+		}
+		case EXTRACT:
+		case EXTRACT_RECURSIVE:
+		{
+			Handle h(dec.get_atom(true));
+			bool ok = true;
+			if (h) ok = as->extract_atom(h, EXTRACT_RECURSIVE == op);
+			if (h and ok) feed.atom_removed(h);
+			enc.put_u8(ok);
+			break;
+		}
+		case GET_ATOMS:
+		{
+			Type t = dec.get_type();
+			bool subtypes = dec.get_u8();
+			HandleSeq hs;
+			as->get_handles_by_type(hs, t, subtypes);
+			enc.put_atoms(hs);
+			break;
+		}
+		case INCOMING_SET:
+		{
+			Handle h(dec.get_atom(true));
+			if (h) enc.put_atoms(h->getIncomingSet(as));
+			else enc.put_u32(0);
+			break;
+		}
+		case INCOMING_BY_TYPE:
+		{
+			Handle h(dec.get_atom(true));
+			Type t = dec.get_type();
+			if (h) enc.put_atoms(h->getIncomingSetByType(t));
+			else enc.put_u32(0);
+			break;
+		}
+		case KEYS_ALIST:
+		{
+			Handle h(dec.get_atom(true));
+			if (h) put_alist(enc, h);
+			else enc.put_u32(0);
+			break;
+		}
+		case VALUE:
+		{
+			Handle h(dec.get_atom(true));
+			Handle key(dec.get_atom(true));
+			if (h and key) enc.put_value(h->getValue(key));
+			else enc.put_value(nullptr);
+			break;
+		}
+		case SET_VALUE:
+		{
+			Handle h(need_atom(dec.get_atom()));
+			Handle key(need_atom(dec.get_atom()));
+			ValuePtr v(dec.get_value());
+			as->set_value(h, key, v);
+			feed.value_changed(h, key, v);
+			break;
+		}
+		case UPDATE_VALUE:
+		{
+			Handle h(need_atom(dec.get_atom()));
+			Handle key(need_atom(dec.get_atom()));
+			FloatValuePtr delta(FloatValueCast(dec.get_value()));
+			if (nullptr == delta)
+				throw InvalidParamException(TRACE_INFO,
+					"Expecting a FloatValue for the update");
+			as->increment_count(h, key, delta->value());
+			feed.value_changed(h, key, h->getValue(key));
+			break;
+		}
+		default:
+			throw InvalidParamException(TRACE_INFO,
+				"Unknown opcode 0x%x", op);
+	}
+
+	if (not dec.at_end())
+		logger().debug("[BinaryEval] trailing bytes after opcode 0x%x", op);
+}
+
+/// Prepend the length, as the socket does for incoming frames.
+void BinaryEval::frame(const std::string& body)
+{
+	BinaryEncoder hdr;
+	hdr.put_u32(body.size());
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_result += hdr.str();
+	_result += body;
+}
+
+/* ============================================================== */
+
+void BinaryEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void BinaryEval::eval_expr(const std::string& expr)
+{
+	BinaryEncoder enc;
+	enc.put_u8(OK);
+	try
+	{
+		BinaryDecoder dec(expr, _atomspace.get());
+		dispatch(dec, enc);
+	}
+	catch (const std::exception& ex)
+	{
+		enc.clear();
+		enc.put_u8(ERR);
+		enc.put_string(ex.what());
+		_caught_error = true;
+	}
+	frame(enc.str());
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = false;
+	_cv.notify_all();
+}
+
+/// Return the complete reply. The shell sends whatever this returns
+/// straight to the socket, so a reply must never be handed over in
+/// pieces.
+std::string BinaryEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_result);
+	return rv;
+}
+
+void BinaryEval::interrupt(void)
+{
+	// Commands are short, and run to completion.
+	_caught_error = true;
+}
+
+// One evaluator per thread.  This allows multiple users to each
+// have thier own evaluator.
+BinaryEval* BinaryEval::get_evaluator(const AtomSpacePtr& asp)
+{
+	static thread_local BinaryEval* evaluator = new BinaryEval(asp);
+
+	// The eval_dtor runs when this thread is destroyed.
+	class eval_dtor {
+		public:
+		~eval_dtor() { delete evaluator; }
+	};
+	static thread_local eval_dtor killer;
+
+	return evaluator;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,91 @@
+/*
+ * opencog/cogserver/shell/BinaryEval.h
+ *
+ * Evaluator for the binary Atomese protocol.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_BINARY_EVAL_H
+#define _OPENCOG_BINARY_EVAL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/eval/GenericEval.h>
+
+#include "BinaryCodec.h"
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the BinaryShell. It provides the same commands as the
+ * s-expression shell, but each command arrives as one binary frame,
+ * and each reply is sent back as one binary frame.
+ *
+ * A request frame is one opcode byte, followed by the arguments,
+ * encoded as described in BinaryEncoder. A reply frame is a status
+ * byte (OK or ERR), followed by the result, or, for ERR, by a String
+ * holding the error message. On the wire, every frame is preceded by
+ * its length, as a four-byte little-endian integer. An empty frame
+ * leaves the shell.
+ */
+class BinaryEval : public GenericEval
+{
+	public:
+		enum Status : uint8_t { OK = 0, ERR = 1 };
+
+		enum Opcode : uint8_t
+		{
+			TYPES = 0x01,             // -> uint16 n, String * n
+			NODE = 0x10,              // Type, String -> Atom or NOTYPE
+			LINK = 0x11,              // Type, uint32 n, Atom * n -> Atom
+			STORE_ATOM = 0x12,        // Atom, uint32 n, (Atom, Value) * n
+			EXTRACT = 0x13,           // Atom -> uint8 ok
+			EXTRACT_RECURSIVE = 0x14, // Atom -> uint8 ok
+			GET_ATOMS = 0x15,         // Type, uint8 subtypes -> Atoms
+			INCOMING_SET = 0x16,      // Atom -> Atoms
+			INCOMING_BY_TYPE = 0x17,  // Atom, Type -> Atoms
+			KEYS_ALIST = 0x18,        // Atom -> uint32 n, (Atom, Value) * n
+			VALUE = 0x19,             // Atom, Atom -> Value
+			SET_VALUE = 0x1a,         // Atom, Atom, Value
+			SET_VALUES = 0x1b,        // Atom, uint32 n, (Atom, Value) * n
+			UPDATE_VALUE = 0x1c,      // Atom, Atom, FloatValue (delta)
+		};
+
+	private:
+		AtomSpacePtr _atomspace;
+
+		// The reply is built in the eval thread, and collected by
+		// the shell's poll thread.
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _result;
+
+		void dispatch(BinaryDecoder&, BinaryEncoder&);
+		void frame(const std::string&);
+
+		BinaryEval(const AtomSpacePtr&);
+
+	public:
+		virtual ~BinaryEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+
+		static BinaryEval* get_evaluator(const AtomSpacePtr&);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_BINARY_EVAL_H
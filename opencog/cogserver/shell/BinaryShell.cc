@@ -0,0 +1,52 @@
+/*
+ * opencog/cogserver/shell/BinaryShell.cc
+ *
+ * Shell for the binary Atomese protocol.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "BinaryEval.h"
+#include "BinaryShell.h"
+
+using namespace opencog;
+
+BinaryShell::BinaryShell(void)
+{
+	normal_prompt = "";
+	abort_prompt = "";
+	pending_prompt = "";
+
+	show_prompt = false;
+	binary_frames = true;
+	_name = " bin";
+}
+
+BinaryShell::~BinaryShell()
+{
+}
+
+GenericEval* BinaryShell::get_evaluator(void)
+{
+	return BinaryEval::get_evaluator(cogserver().getAtomSpace());
+}
+
+/// Frames are opaque; there are no telnet escapes or control
+/// characters to look for. An empty frame means "leave the shell".
+void BinaryShell::line_discipline(const std::string& frame)
+{
+	if (0 == frame.size())
+	{
+		logger().debug("[BinaryShell] got empty frame; exiting shell");
+		self_destruct = true;
+		evalque.cancel();
+		return;
+	}
+	evalque.push(frame);
+}
+
+/* ===================== END OF FILE ============================ */
@@ -0,0 +1,39 @@
+/*
+ * opencog/cogserver/shell/BinaryShell.h
+ *
+ * Shell for the binary Atomese protocol.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_BINARY_SHELL_H
+#define _OPENCOG_BINARY_SHELL_H
+
+#include <opencog/network/GenericShell.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * A shell that exchanges Atoms and Values as length-prefixed binary
+ * frames, instead of as lines of s-expression text. See BinaryEval
+ * for the commands, and BinaryEncoder for the encoding.
+ */
+class BinaryShell : public GenericShell
+{
+	protected:
+		virtual void line_discipline(const std::string&);
+
+	public:
+		BinaryShell(void);
+		virtual ~BinaryShell();
+		virtual GenericEval* get_evaluator(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_BINARY_SHELL_H
@@ -0,0 +1,90 @@
+/*
+ * opencog/cogserver/shell/BinaryShellModule.cc
+ *
+ * Shell for the binary Atomese protocol.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_assert.h>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "BinaryShell.h"
+#include "ShellModule.h"
+
+using namespace opencog;
+
+DEFINE_SHELL_MODULE(BinaryShellModule);
+DECLARE_MODULE(BinaryShellModule);
+
+BinaryShellModule::BinaryShellModule(CogServer& cs) : Module(cs)
+{
+}
+
+void BinaryShellModule::init(void)
+{
+	_cogserver.registerRequest(shelloutRequest::info().id,
+	                           &shelloutFactory);
+}
+
+BinaryShellModule::~BinaryShellModule()
+{
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+}
+
+bool BinaryShellModule::config(const char*)
+{
+	return false;
+}
+
+const RequestClassInfo&
+BinaryShellModule::shelloutRequest::info(void)
+{
+	static const RequestClassInfo _cci("binary",
+		"Enter the binary Atomese shell",
+		"Usage: binary\n\n"
+		"Enter the binary Atomese shell. This shell provides the same\n"
+		"commands as the `sexpr` shell, but Atoms and Values are sent\n"
+		"and received in a compact, length-prefixed binary encoding,\n"
+		"instead of as s-expression text. This avoids the cost of\n"
+		"printing and parsing text on both ends of the connection.\n\n"
+		"It is meant for use by programs, such as StorageNodes, and\n"
+		"not by people. The encoding is documented in\n"
+		"opencog/cogserver/shell/BinaryCodec.h and BinaryEval.h.\n\n"
+		"Send an empty frame (four zero bytes) to exit the shell.\n"
+		"Not available over WebSockets.\n",
+		true, false);
+	return _cci;
+}
+
+/**
+ * Register this shell with the console.
+ */
+bool
+BinaryShellModule::shelloutRequest::execute(void)
+{
+	ConsoleSocket *con = this->get_console();
+	OC_ASSERT(con, "Invalid Request object");
+
+	// WebSockets carry their own framing, and would need a
+	// different set of changes.
+	if (con->is_websocket())
+	{
+		send("The binary shell is not available over WebSockets\n");
+		return true;
+	}
+
+	BinaryShell *sh = new BinaryShell();
+	sh->set_socket(con);
+	send("");
+	return true;
+}
+
+/* ===================== END OF FILE ============================ */
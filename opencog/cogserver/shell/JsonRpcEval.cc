@@ -0,0 +1,376 @@
+/*
+ * opencog/cogserver/shell/JsonRpcEval.cc
+ *
+ * JSON-RPC 2.0 front end to the JSON evaluator.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/persist/json/JsonEval.h>
+
+#include "JsonRpcEval.h"
+
+using namespace opencog;
+
+// Deep nesting would overflow the stack.
+#define JSONRPC_MAX_DEPTH 512
+
+JsonRpcEval::JsonRpcEval(GenericEval* json, const AtomSpacePtr& as) :
+	GenericEval(),
+	_json(json),
+	_as(as),
+	_running(false),
+	_passed(false)
+{
+	_nthreads = config().get_int("JSONRPC_THREADS", 4);
+	if (0 == _nthreads) _nthreads = 1;
+}
+
+JsonRpcEval::~JsonRpcEval()
+{
+}
+
+/* ============================================================== */
+// Just enough JSON to pick requests apart. Values are kept as the
+// text they came in as; the JsonEval reads the params.
+
+static void skip_ws(const std::string& s, size_t& pos)
+{
+	while (pos < s.size() and
+	       (' ' == s[pos] or '\t' == s[pos] or '\n' == s[pos] or '\r' == s[pos]))
+		pos++;
+}
+
+/// Move past one JSON value. Return false if it is malformed.
+static bool skip_value(const std::string& s, size_t& pos, int depth = 0)
+{
+	if (JSONRPC_MAX_DEPTH < depth) return false;
+	skip_ws(s, pos);
+	if (s.size() <= pos) return false;
+
+	char c = s[pos];
+	if ('"' == c)
+	{
+		for (pos++; pos < s.size(); pos++)
+		{
+			if ('\\' == s[pos]) pos++;
+			else if ('"' == s[pos]) { pos++; return true; }
+		}
+		return false;
+	}
+
+	if ('[' == c or '{' == c)
+	{
+		char close = ('[' == c) ? ']' : '}';
+		pos++;
+		skip_ws(s, pos);
+		if (pos < s.size() and close == s[pos]) { pos++; return true; }
+		while (true)
+		{
+			if ('{' == c)
+			{
+				skip_ws(s, pos);
+				if (s.size() <= pos or '"' != s[pos]) return false;
+				if (not skip_value(s, pos, depth + 1)) return false;
+				skip_ws(s, pos);
+				if (s.size() <= pos or ':' != s[pos]) return false;
+				pos++;
+			}
+			if (not skip_value(s, pos, depth + 1)) return false;
+			skip_ws(s, pos);
+			if (s.size() <= pos) return false;
+			if (close == s[pos]) { pos++; return true; }
+			if (',' != s[pos]) return false;
+			pos++;
+		}
+	}
+
+	// Numbers, true, false and null.
+	size_t start = pos;
+	while (pos < s.size() and
+	       (isalnum((unsigned char) s[pos]) or
+	        (s[pos] and strchr("+-.", s[pos]))))
+		pos++;
+	return start < pos;
+}
+
+/// True if the text is exactly one JSON value.
+static bool is_json(const std::string& s)
+{
+	size_t pos = 0;
+	if (not skip_value(s, pos)) return false;
+	skip_ws(s, pos);
+	return pos == s.size();
+}
+
+/// The elements of an array, as text.
+static bool elements(const std::string& s, std::vector<std::string>& out)
+{
+	size_t pos = 0;
+	skip_ws(s, pos);
+	if (s.size() <= pos or '[' != s[pos]) return false;
+	pos++;
+	skip_ws(s, pos);
+	if (pos < s.size() and ']' == s[pos]) return true;
+	while (true)
+	{
+		skip_ws(s, pos);
+		size_t start = pos;
+		if (not skip_value(s, pos)) return false;
+		out.emplace_back(s, start, pos - start);
+		skip_ws(s, pos);
+		if (s.size() <= pos) return false;
+		if (']' == s[pos++]) return true;
+		if (',' != s[pos-1]) return false;
+	}
+}
+
+/// The members of an object, as text. Keys are taken as they are,
+/// without undoing escapes; none of the keys looked at have any.
+static bool members(const std::string& s,
+                    std::map<std::string, std::string>& out)
+{
+	size_t pos = 0;
+	skip_ws(s, pos);
+	if (s.size() <= pos or '{' != s[pos]) return false;
+	pos++;
+	skip_ws(s, pos);
+	if (pos < s.size() and '}' == s[pos]) return true;
+	while (true)
+	{
+		skip_ws(s, pos);
+		size_t kstart = pos;
+		if (s.size() <= pos or '"' != s[pos]) return false;
+		if (not skip_value(s, pos)) return false;
+		std::string key(s, kstart + 1, pos - kstart - 2);
+		skip_ws(s, pos);
+		if (s.size() <= pos or ':' != s[pos]) return false;
+		pos++;
+		skip_ws(s, pos);
+		size_t vstart = pos;
+		if (not skip_value(s, pos)) return false;
+		out[key] = s.substr(vstart, pos - vstart);
+		skip_ws(s, pos);
+		if (s.size() <= pos) return false;
+		if ('}' == s[pos++]) return true;
+		if (',' != s[pos-1]) return false;
+	}
+}
+
+static std::string quote(const std::string& s)
+{
+	std::string out("\"");
+	for (unsigned char c : s)
+	{
+		if ('"' == c) out += "\\\"";
+		else if ('\\' == c) out += "\\\\";
+		else if ('\n' == c) out += "\\n";
+		else if ('\r' == c) out += "\\r";
+		else if ('\t' == c) out += "\\t";
+		else if (c < 0x20)
+		{
+			char esc[8];
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			out += esc;
+		}
+		else out.push_back(c);
+	}
+	return out + "\"";
+}
+
+static std::string error(const std::string& id, int code,
+                         const std::string& msg)
+{
+	return "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":" +
+		std::to_string(code) + ",\"message\":" + quote(msg) +
+		"},\"id\":" + id + "}";
+}
+
+/* ============================================================== */
+
+/// Run one request on the given evaluator. Return the response, or
+/// nothing, for a notification.
+std::string JsonRpcEval::call(GenericEval* ev, const std::string& req)
+{
+	std::map<std::string, std::string> m;
+	if (not members(req, m))
+		return is_json(req) ?
+			error("null", -32600, "Invalid Request") :
+			error("null", -32700, "Parse error");
+
+	auto idit = m.find("id");
+	bool notify = (m.end() == idit);
+	std::string id = notify ? "null" : idit->second;
+
+	if (m["jsonrpc"] != "\"2.0\"")
+		return error(id, -32600, "Invalid Request");
+
+	const std::string& mth = m["method"];
+	if (mth.size() < 3 or '"' != mth[0])
+		return error(id, -32600, "Invalid Request");
+	std::string method(mth, 1, mth.size() - 2);
+	for (char c : method)
+		if (not isalnum((unsigned char) c) and '_' != c)
+			return notify ? "" : error(id, -32601, "Method not found");
+
+	std::string args;
+	auto pit = m.find("params");
+	if (m.end() != pit)
+	{
+		const std::string& params = pit->second;
+		std::vector<std::string> items;
+		if ('{' == params[0])
+			args = params;
+		else if (elements(params, items))
+		{
+			for (size_t i = 0; i < items.size(); i++)
+			{
+				if (i) args += ", ";
+				args += items[i];
+			}
+		}
+		else
+			return notify ? "" : error(id, -32602, "Invalid params");
+	}
+
+	ev->begin_eval();
+	ev->eval_expr("AtomSpace." + method + "(" + args + ")\n");
+	std::string text(ev->poll_result());
+	if (notify) return "";
+
+	size_t end = text.find_last_not_of(" \t\r\n");
+	text.resize(std::string::npos == end ? 0 : end + 1);
+	if (ev->eval_error())
+		return error(id, -32000, text);
+
+	// Replies that are not JSON are sent as strings.
+	if (not is_json(text)) text = quote(text);
+	return "{\"jsonrpc\":\"2.0\",\"result\":" + text + ",\"id\":" + id + "}";
+}
+
+/// Run the calls of a batch at the same time; each thread has an
+/// evaluator of its own. Responses are collected as they finish.
+std::string JsonRpcEval::batch(const std::string& text)
+{
+	std::vector<std::string> reqs;
+	if (not elements(text, reqs))
+		return error("null", -32700, "Parse error");
+	if (reqs.empty())
+		return error("null", -32600, "Invalid Request");
+
+	std::mutex mtx;
+	std::vector<std::string> replies;
+	std::atomic<size_t> next(0);
+	auto work = [&](GenericEval* ev)
+	{
+		for (size_t i = next++; i < reqs.size(); i = next++)
+		{
+			std::string rep(call(ev, reqs[i]));
+			if (rep.empty()) continue;
+			std::lock_guard<std::mutex> lck(mtx);
+			replies.emplace_back(std::move(rep));
+		}
+	};
+
+	size_t nthr = std::min(_nthreads, reqs.size());
+	std::vector<std::thread> pool;
+	for (size_t t = 1; t < nthr; t++)
+		pool.emplace_back([&]() { work(JsonEval::get_evaluator(_as)); });
+	work(_json);
+	for (std::thread& thr : pool) thr.join();
+
+	// A batch of notifications gets no reply at all.
+	if (replies.empty()) return "";
+
+	std::string rv("[");
+	for (size_t i = 0; i < replies.size(); i++)
+	{
+		if (i) rv += ",";
+		rv += replies[i];
+	}
+	return rv + "]";
+}
+
+/* ============================================================== */
+
+void JsonRpcEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_passed = false;
+	_caught_error = false;
+}
+
+void JsonRpcEval::eval_expr(const std::string& expr)
+{
+	size_t pos = expr.find_first_not_of(" \t\r\n");
+	bool is_batch = (std::string::npos != pos and '[' == expr[pos]);
+	bool is_rpc = is_batch or (std::string::npos != pos and
+		'{' == expr[pos] and
+		std::string::npos != expr.find("\"jsonrpc\"", pos));
+
+	std::string reply;
+	if (is_batch)
+		reply = batch(expr);
+	else if (is_rpc)
+		reply = call(_json, expr);
+	else
+	{
+		_json->begin_eval();
+		_json->eval_expr(expr);
+	}
+	if (not reply.empty()) reply += "\n";
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_reply = reply;
+	_passed = not is_rpc;
+	_running = false;
+	_cv.notify_all();
+}
+
+/// Wait for the command to be done, like the JsonEval would.
+std::string JsonRpcEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	if (_passed)
+	{
+		lck.unlock();
+		std::string rv(_json->poll_result());
+		_caught_error = _json->eval_error();
+		_pending_input = _json->input_pending();
+		return rv;
+	}
+
+	std::string rv;
+	rv.swap(_reply);
+	return rv;
+}
+
+void JsonRpcEval::interrupt(void)
+{
+	_json->interrupt();
+	_caught_error = true;
+}
+
+void JsonRpcEval::clear_pending(void)
+{
+	_json->clear_pending();
+	_pending_input = false;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,78 @@
+/*
+ * opencog/cogserver/shell/JsonRpcEval.h
+ *
+ * JSON-RPC 2.0 front end to the JSON evaluator.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_JSON_RPC_EVAL_H
+#define _OPENCOG_JSON_RPC_EVAL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/eval/GenericEval.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the JsonShell, that passes everything on to the
+ * JsonEval, except for JSON-RPC 2.0 requests. A request is an object
+ * such as
+ *
+ *   {"jsonrpc": "2.0", "method": "getIncoming", "params": [...], "id": 7}
+ *
+ * and runs `AtomSpace.getIncoming(...)`, with the params as the
+ * arguments. The reply is `{"jsonrpc": "2.0", "result": ..., "id": 7}`,
+ * with the JSON shell's reply as the result, or an `error` object,
+ * with code -32000 and the JSON shell's message, if the call failed.
+ * Requests without an id are notifications, and get no reply.
+ *
+ * A batch is an array of requests, on one line (or in one WebSocket
+ * frame). Its calls are run at the same time, on up to JSONRPC_THREADS
+ * threads, and the reply is one array, holding the responses in the
+ * order that the calls finished, which need not be the order in which
+ * they were asked; clients match them up by id. A batch of 200 calls
+ * thus costs one round trip, instead of 200.
+ *
+ * Lines that begin with `[`, or with `{` and mention "jsonrpc", are
+ * taken to be JSON-RPC; anything else goes to the JsonEval as before.
+ */
+class JsonRpcEval : public GenericEval
+{
+	private:
+		GenericEval* _json;
+		AtomSpacePtr _as;
+		size_t _nthreads;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		bool _passed;
+		std::string _reply;
+
+		std::string call(GenericEval*, const std::string&);
+		std::string batch(const std::string&);
+
+	public:
+		JsonRpcEval(GenericEval*, const AtomSpacePtr&);
+		virtual ~JsonRpcEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+		virtual void clear_pending(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_JSON_RPC_EVAL_H
@@ -40,11 +40,19 @@ JsonShell::JsonShell(void)
 
 JsonShell::~JsonShell()
 {
+	// The RPC evaluator is ours; the eval thread must be done
+	// with it before it goes.
+	while_not_done();
+	join_eval();
 }
 
+/// The thread's JsonEval, wrapped so that the client can send
+/// JSON-RPC requests and batches.
 GenericEval* JsonShell::get_evaluator(void)
 {
-	return JsonEval::get_evaluator(cogserver().getAtomSpace());
+	AtomSpacePtr as = cogserver().getAtomSpace();
+	_rpc.reset(new JsonRpcEval(JsonEval::get_evaluator(as), as));
+	return _rpc.get();
 }
 
 /* ===================== END OF FILE ============================ */
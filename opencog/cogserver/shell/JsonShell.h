@@ -23,8 +23,12 @@
 #ifndef _OPENCOG_JSON_SHELL_H
 #define _OPENCOG_JSON_SHELL_H
 
+#include <memory>
+
 #include <opencog/network/GenericShell.h>
 
+#include "JsonRpcEval.h"
+
 namespace opencog {
 /** \addtogroup grp_server
  *  @{
@@ -32,6 +36,10 @@ namespace opencog {
 
 class JsonShell : public GenericShell
 {
+	private:
+		// Created in the eval thread; see get_evaluator().
+		std::unique_ptr<JsonRpcEval> _rpc;
+
 	public:
 		JsonShell(void);
 		virtual ~JsonShell();
@@ -47,7 +47,8 @@ void JsonShellModule::init(void)
 
 JsonShellModule::~JsonShellModule()
 {
-	_cogserver.unregisterRequest(shelloutRequest::info().id);
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
 }
 
 bool JsonShellModule::config(const char*)
@@ -68,6 +69,11 @@ JsonShellModule::shelloutRequest::info(void)
 		"Example usage: `AtomSpace.getAtoms(\"Node\", true)` will return all\n"
 		"Nodes in the AtomSpace. For more info, see the README.md file at\n"
 		"https://github.com/opencog/atomspace/tree/master/opencog/persist/json\n\n"
+		"JSON-RPC 2.0 requests are accepted too, one per line, such as\n"
+		"{\"jsonrpc\": \"2.0\", \"method\": \"getIncoming\", \"params\": [...], \"id\": 1}\n"
+		"A batch (an array of requests) is run in parallel, and answered\n"
+		"with one array, in the order the calls finished; match the\n"
+		"responses to the requests by id.\n\n"
 		"By default, this prints a prompt. To get a shell without a prompt,\n"
 		"say `json hush` or `json quiet`\n"
 		"To exit the shell, send a ^D (ctrl-D) or a single . on a line by itself.\n",
@@ -84,6 +90,13 @@ JsonShellModule::shelloutRequest::execute(void)
 	ConsoleSocket *con = this->get_console();
 	OC_ASSERT(con, "Invalid Request object");
 
+	std::string warn;
+	if (not _cogserver.checkUnpublished("json", warn))
+	{
+		send(warn);
+		return true;
+	}
+
 	JsonShell *sh = new JsonShell();
 	sh->set_socket(con);
 
@@ -97,7 +110,7 @@ JsonShellModule::shelloutRequest::execute(void)
 		if (hush) { send(""); return true; }
 	}
 
-	std::string rv =
+	std::string rv = warn +
 		"Entering JSON shell; use ^D or a single . on a "
 		"line by itself to exit.\n" + sh->get_prompt();
 	send(rv);
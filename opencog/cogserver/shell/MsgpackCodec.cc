@@ -0,0 +1,558 @@
+/*
+ * opencog/cogserver/shell/MsgpackCodec.cc
+ *
+ * Conversion between JSON text and MessagePack.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cstdint>
+
+#include <opencog/util/exceptions.h>
+
+#include "MsgpackCodec.h"
+
+using namespace opencog;
+
+// Deep nesting would overflow the stack; no reply from the JSON
+// shell comes anywhere near this.
+#define MSGPACK_MAX_DEPTH 512
+
+/* ============================================================== */
+// MessagePack output.
+
+static void put_be(std::string& out, uint64_t v, int nbytes)
+{
+	for (int i = nbytes - 1; 0 <= i; i--)
+		out.push_back((char) ((v >> (8*i)) & 0xff));
+}
+
+static void put_uint(std::string& out, uint64_t v)
+{
+	if (v < 0x80) out.push_back((char) v);
+	else if (v <= 0xff) { out.push_back((char) 0xcc); put_be(out, v, 1); }
+	else if (v <= 0xffff) { out.push_back((char) 0xcd); put_be(out, v, 2); }
+	else if (v <= 0xffffffff) { out.push_back((char) 0xce); put_be(out, v, 4); }
+	else { out.push_back((char) 0xcf); put_be(out, v, 8); }
+}
+
+static void put_int(std::string& out, int64_t v)
+{
+	if (0 <= v) { put_uint(out, v); return; }
+	if (-32 <= v) out.push_back((char) v);
+	else if (INT8_MIN <= v) { out.push_back((char) 0xd0); put_be(out, v, 1); }
+	else if (INT16_MIN <= v) { out.push_back((char) 0xd1); put_be(out, v, 2); }
+	else if (INT32_MIN <= v) { out.push_back((char) 0xd2); put_be(out, v, 4); }
+	else { out.push_back((char) 0xd3); put_be(out, v, 8); }
+}
+
+static void put_double(std::string& out, double d)
+{
+	uint64_t bits;
+	memcpy(&bits, &d, 8);
+	out.push_back((char) 0xcb);
+	put_be(out, bits, 8);
+}
+
+/// The header of a str, array or map; `fix` is the fixed-size tag,
+/// holding up to `fixmax` items, and `tag16` the tag of the 16-bit
+/// form, which is followed by the 32-bit form.
+static void put_head(std::string& out, size_t n,
+                     uint8_t fix, size_t fixmax, uint8_t tag16)
+{
+	if (n <= fixmax) out.push_back((char) (fix | n));
+	else if (n <= 0xffff) { out.push_back((char) tag16); put_be(out, n, 2); }
+	else { out.push_back((char) (tag16 + 1)); put_be(out, n, 4); }
+}
+
+static void put_str(std::string& out, const std::string& s)
+{
+	// str8 has no counterpart for arrays and maps.
+	if (32 <= s.size() and s.size() <= 0xff)
+	{
+		out.push_back((char) 0xd9);
+		put_be(out, s.size(), 1);
+	}
+	else
+		put_head(out, s.size(), 0xa0, 31, 0xda);
+	out += s;
+}
+
+/* ============================================================== */
+// JSON input.
+
+namespace {
+
+class JsonReader
+{
+	private:
+		const char* _begin;
+		const char* _p;
+		const char* _end;
+		std::string& _out;
+
+		[[noreturn]] void fail(const char* what) const
+		{
+			throw SyntaxException(TRACE_INFO,
+				"Bad JSON: %s at offset %zu", what, (size_t) (_p - _begin));
+		}
+
+		void ws(void)
+		{
+			while (_p < _end and
+			       (' ' == *_p or '\t' == *_p or '\n' == *_p or '\r' == *_p))
+				_p++;
+		}
+
+		void literal(const char* word)
+		{
+			size_t len = strlen(word);
+			if ((size_t) (_end - _p) < len or strncmp(_p, word, len))
+				fail("unknown literal");
+			_p += len;
+		}
+
+		unsigned hex4(void);
+		void utf8(std::string&, unsigned);
+		std::string string(void);
+		void number(void);
+
+		// Items of an array or map are counted only as they are read;
+		// the header goes in front of them when the count is known.
+		template<typename F>
+		void items(char close, uint8_t fix, size_t fixmax,
+		           uint8_t tag16, F item)
+		{
+			_p++;
+			std::string body;
+			body.swap(_out);
+			size_t n = 0;
+			ws();
+			if (_p < _end and close == *_p)
+				_p++;
+			else while (true)
+			{
+				item();
+				n++;
+				ws();
+				if (_end <= _p) fail("unterminated container");
+				if (close == *_p) { _p++; break; }
+				if (',' != *_p) fail("expecting a comma");
+				_p++;
+				ws();
+			}
+			body.swap(_out);
+			put_head(_out, n, fix, fixmax, tag16);
+			_out += body;
+		}
+
+	public:
+		JsonReader(const std::string& in, std::string& out) :
+			_begin(in.data()), _p(in.data()), _end(in.data() + in.size()),
+			_out(out) {}
+
+		void value(int depth);
+		bool at_end(void) { ws(); return _p == _end; }
+};
+
+unsigned JsonReader::hex4(void)
+{
+	if (_end - _p < 4) fail("short \\u escape");
+	unsigned v = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		char c = *_p++;
+		v <<= 4;
+		if ('0' <= c and c <= '9') v |= c - '0';
+		else if ('a' <= c and c <= 'f') v |= c - 'a' + 10;
+		else if ('A' <= c and c <= 'F') v |= c - 'A' + 10;
+		else fail("bad \\u escape");
+	}
+	return v;
+}
+
+void JsonReader::utf8(std::string& s, unsigned cp)
+{
+	if (cp < 0x80) s.push_back((char) cp);
+	else if (cp < 0x800)
+	{
+		s.push_back((char) (0xc0 | (cp >> 6)));
+		s.push_back((char) (0x80 | (cp & 0x3f)));
+	}
+	else if (cp < 0x10000)
+	{
+		s.push_back((char) (0xe0 | (cp >> 12)));
+		s.push_back((char) (0x80 | ((cp >> 6) & 0x3f)));
+		s.push_back((char) (0x80 | (cp & 0x3f)));
+	}
+	else
+	{
+		s.push_back((char) (0xf0 | (cp >> 18)));
+		s.push_back((char) (0x80 | ((cp >> 12) & 0x3f)));
+		s.push_back((char) (0x80 | ((cp >> 6) & 0x3f)));
+		s.push_back((char) (0x80 | (cp & 0x3f)));
+	}
+}
+
+std::string JsonReader::string(void)
+{
+	_p++;
+	std::string s;
+	while (true)
+	{
+		// Copy runs of plain characters in one go.
+		const char* run = _p;
+		while (_p < _end and '"' != *_p and '\\' != *_p) _p++;
+		s.append(run, _p - run);
+		if (_end <= _p) fail("unterminated string");
+		if ('"' == *_p++) return s;
+
+		if (_end <= _p) fail("unterminated string");
+		char c = *_p++;
+		switch (c)
+		{
+			case '"': case '\\': case '/': s.push_back(c); break;
+			case 'b': s.push_back('\b'); break;
+			case 'f': s.push_back('\f'); break;
+			case 'n': s.push_back('\n'); break;
+			case 'r': s.push_back('\r'); break;
+			case 't': s.push_back('\t'); break;
+			case 'u':
+			{
+				unsigned cp = hex4();
+				if (0xd800 <= cp and cp < 0xdc00 and
+				    2 <= _end - _p and '\\' == _p[0] and 'u' == _p[1])
+				{
+					_p += 2;
+					unsigned lo = hex4();
+					if (lo < 0xdc00 or 0xe000 <= lo)
+						fail("bad surrogate pair");
+					cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+				}
+				utf8(s, cp);
+				break;
+			}
+			default: fail("bad escape");
+		}
+	}
+}
+
+void JsonReader::number(void)
+{
+	const char* start = _p;
+	bool integral = true;
+	if ('-' == *_p) _p++;
+	while (_p < _end)
+	{
+		char c = *_p;
+		if ('.' == c or 'e' == c or 'E' == c or '+' == c or '-' == c)
+			integral = false;
+		else if (c < '0' or '9' < c)
+			break;
+		_p++;
+	}
+
+	std::string num(start, _p - start);
+	char* stop;
+	errno = 0;
+	if (integral)
+	{
+		if ('-' == num[0])
+		{
+			long long v = strtoll(num.c_str(), &stop, 10);
+			if (0 == errno and '\0' == *stop) { put_int(_out, v); return; }
+		}
+		else
+		{
+			unsigned long long v = strtoull(num.c_str(), &stop, 10);
+			if (0 == errno and '\0' == *stop) { put_uint(_out, v); return; }
+		}
+		// Too big for 64 bits; send it as a double.
+		errno = 0;
+	}
+	double d = strtod(num.c_str(), &stop);
+	if ('\0' != *stop or stop == num.c_str()) fail("bad number");
+	put_double(_out, d);
+}
+
+void JsonReader::value(int depth)
+{
+	if (MSGPACK_MAX_DEPTH < depth) fail("nested too deeply");
+	ws();
+	if (_end <= _p) fail("unexpected end");
+	switch (*_p)
+	{
+		case '{':
+			items('}', 0x80, 15, 0xde, [&]() {
+				if (_end <= _p or '"' != *_p) fail("expecting a key");
+				put_str(_out, string());
+				ws();
+				if (_end <= _p or ':' != *_p) fail("expecting a colon");
+				_p++;
+				value(depth + 1);
+			});
+			return;
+		case '[':
+			items(']', 0x90, 15, 0xdc, [&]() { value(depth + 1); });
+			return;
+		case '"': put_str(_out, string()); return;
+		case 't': literal("true"); _out.push_back((char) 0xc3); return;
+		case 'f': literal("false"); _out.push_back((char) 0xc2); return;
+		case 'n': literal("null"); _out.push_back((char) 0xc0); return;
+		default:
+			if ('-' == *_p or ('0' <= *_p and *_p <= '9'))
+			{
+				number();
+				return;
+			}
+			fail("unexpected character");
+	}
+}
+
+/* ============================================================== */
+// MessagePack input.
+
+class MsgpackReader
+{
+	private:
+		const unsigned char* _p;
+		const unsigned char* _end;
+		std::string& _out;
+
+		void need(size_t n) const
+		{
+			if ((size_t) (_end - _p) < n)
+				throw SyntaxException(TRACE_INFO,
+					"Truncated MessagePack: need %zu more bytes, have %zu",
+					n, (size_t) (_end - _p));
+		}
+
+		uint64_t be(int nbytes)
+		{
+			need(nbytes);
+			uint64_t v = 0;
+			for (int i = 0; i < nbytes; i++) v = (v << 8) | *_p++;
+			return v;
+		}
+
+		void str(size_t);
+		void array(size_t, int);
+		void map(size_t, int);
+		void number(const char*, ...);
+		void real(double, const char*);
+
+	public:
+		MsgpackReader(const std::string& in, std::string& out) :
+			_p((const unsigned char*) in.data()),
+			_end((const unsigned char*) in.data() + in.size()),
+			_out(out) {}
+
+		void value(int depth);
+		size_t array_head(void);
+		bool at_end(void) const { return _p == _end; }
+};
+
+void MsgpackReader::number(const char* fmt, ...)
+{
+	char buf[40];
+	va_list ap;
+	va_start(ap, fmt);
+	vsnprintf(buf, sizeof(buf), fmt, ap);
+	va_end(ap);
+	_out += buf;
+}
+
+/// A float stays a float when read back: `2.0`, not `2`.
+void MsgpackReader::real(double d, const char* fmt)
+{
+	// JSON has no infinities, nor NaN.
+	if (not isfinite(d)) { _out += "null"; return; }
+	size_t start = _out.size();
+	number(fmt, d);
+	if (std::string::npos == _out.find_first_of(".e", start))
+		_out += ".0";
+}
+
+void MsgpackReader::str(size_t len)
+{
+	need(len);
+	_out.push_back('"');
+	for (const unsigned char* e = _p + len; _p < e; _p++)
+	{
+		unsigned char c = *_p;
+		if ('"' == c) _out += "\\\"";
+		else if ('\\' == c) _out += "\\\\";
+		else if ('\n' == c) _out += "\\n";
+		else if ('\r' == c) _out += "\\r";
+		else if ('\t' == c) _out += "\\t";
+		else if (c < 0x20)
+		{
+			char esc[8];
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			_out += esc;
+		}
+		else _out.push_back((char) c);
+	}
+	_out.push_back('"');
+}
+
+void MsgpackReader::array(size_t n, int depth)
+{
+	_out.push_back('[');
+	for (size_t i = 0; i < n; i++)
+	{
+		if (i) _out.push_back(',');
+		value(depth + 1);
+	}
+	_out.push_back(']');
+}
+
+void MsgpackReader::map(size_t n, int depth)
+{
+	_out.push_back('{');
+	for (size_t i = 0; i < n; i++)
+	{
+		if (i) _out.push_back(',');
+		need(1);
+		uint8_t c = *_p;
+		if ((c & 0xe0) != 0xa0 and (c < 0xd9 or 0xdb < c))
+			throw SyntaxException(TRACE_INFO,
+				"MessagePack map keys must be strings, got 0x%x", c);
+		value(depth + 1);
+		_out.push_back(':');
+		value(depth + 1);
+	}
+	_out.push_back('}');
+}
+
+void MsgpackReader::value(int depth)
+{
+	if (MSGPACK_MAX_DEPTH < depth)
+		throw SyntaxException(TRACE_INFO, "MessagePack nested too deeply");
+	need(1);
+	uint8_t c = *_p++;
+
+	if (c < 0x80) { number("%u", c); return; }
+	if (0xe0 <= c) { number("%d", (int8_t) c); return; }
+	if ((c & 0xf0) == 0x80) { map(c & 0x0f, depth); return; }
+	if ((c & 0xf0) == 0x90) { array(c & 0x0f, depth); return; }
+	if ((c & 0xe0) == 0xa0) { str(c & 0x1f); return; }
+
+	switch (c)
+	{
+		case 0xc0: _out += "null"; return;
+		case 0xc2: _out += "false"; return;
+		case 0xc3: _out += "true"; return;
+		case 0xc4: case 0xd9: str(be(1)); return;
+		case 0xc5: case 0xda: str(be(2)); return;
+		case 0xc6: case 0xdb: str(be(4)); return;
+		case 0xca:
+		{
+			uint32_t bits = be(4);
+			float f;
+			memcpy(&f, &bits, 4);
+			real(f, "%.9g");
+			return;
+		}
+		case 0xcb:
+		{
+			uint64_t bits = be(8);
+			double d;
+			memcpy(&d, &bits, 8);
+			real(d, "%.17g");
+			return;
+		}
+		case 0xcc: number("%llu", (unsigned long long) be(1)); return;
+		case 0xcd: number("%llu", (unsigned long long) be(2)); return;
+		case 0xce: number("%llu", (unsigned long long) be(4)); return;
+		case 0xcf: number("%llu", (unsigned long long) be(8)); return;
+		case 0xd0: number("%d", (int8_t) be(1)); return;
+		case 0xd1: number("%d", (int16_t) be(2)); return;
+		case 0xd2: number("%d", (int32_t) be(4)); return;
+		case 0xd3: number("%lld", (long long) (int64_t) be(8)); return;
+		case 0xdc: array(be(2), depth); return;
+		case 0xdd: array(be(4), depth); return;
+		case 0xde: map(be(2), depth); return;
+		case 0xdf: map(be(4), depth); return;
+	}
+	throw SyntaxException(TRACE_INFO,
+		"MessagePack type 0x%x has no JSON counterpart", c);
+}
+
+size_t MsgpackReader::array_head(void)
+{
+	need(1);
+	uint8_t c = *_p++;
+	if ((c & 0xf0) == 0x90) return c & 0x0f;
+	if (0xdc == c) return be(2);
+	if (0xdd == c) return be(4);
+	throw SyntaxException(TRACE_INFO,
+		"Expecting a MessagePack array, got 0x%x", c);
+}
+
+} // anonymous namespace
+
+/* ============================================================== */
+
+std::string MsgpackCodec::from_json(const std::string& json)
+{
+	std::string out;
+	JsonReader rd(json, out);
+	rd.value(0);
+	if (not rd.at_end())
+		throw SyntaxException(TRACE_INFO, "Bad JSON: trailing characters");
+	return out;
+}
+
+std::string MsgpackCodec::to_json(const std::string& mp)
+{
+	std::string out;
+	MsgpackReader rd(mp, out);
+	rd.value(0);
+	if (not rd.at_end())
+		throw SyntaxException(TRACE_INFO, "Trailing bytes after MessagePack");
+	return out;
+}
+
+std::vector<std::string> MsgpackCodec::to_json_list(const std::string& mp)
+{
+	std::string out;
+	MsgpackReader rd(mp, out);
+	size_t n = rd.array_head();
+	std::vector<std::string> items;
+	for (size_t i = 0; i < n; i++)
+	{
+		rd.value(1);
+		items.emplace_back(std::move(out));
+		out.clear();
+	}
+	if (not rd.at_end())
+		throw SyntaxException(TRACE_INFO, "Trailing bytes after MessagePack");
+	return items;
+}
+
+std::string MsgpackCodec::from_string(const std::string& str)
+{
+	std::string out;
+	put_str(out, str);
+	return out;
+}
+
+std::string MsgpackCodec::error(const std::string& msg)
+{
+	std::string out;
+	put_head(out, 1, 0x80, 15, 0xde);
+	put_str(out, "error");
+	put_str(out, msg);
+	return out;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,58 @@
+/*
+ * opencog/cogserver/shell/MsgpackCodec.h
+ *
+ * Conversion between JSON text and MessagePack.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_MSGPACK_CODEC_H
+#define _OPENCOG_MSGPACK_CODEC_H
+
+#include <string>
+#include <vector>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Convert JSON text to MessagePack, and back, without building a
+ * tree in between.
+ *
+ * Only the MessagePack types that have a JSON counterpart are used:
+ * nil, booleans, integers, float64, str, array and map. Integers
+ * without a fraction or an exponent are sent as MessagePack integers;
+ * all other numbers as float64. When decoding, float32 is accepted,
+ * and bin is treated as str. Map keys must be strings. Anything else,
+ * and truncated or malformed input of either kind, throws a
+ * SyntaxException. Nesting deeper than MSGPACK_MAX_DEPTH is refused.
+ */
+class MsgpackCodec
+{
+	public:
+		/** Encode one JSON value. Trailing white space is allowed;
+		 *  anything else after the value is an error. */
+		static std::string from_json(const std::string&);
+
+		/** Decode one MessagePack value to compact JSON text. */
+		static std::string to_json(const std::string&);
+
+		/** Decode a MessagePack array to the JSON text of each of its
+		 *  elements. Throws if the value is not an array. */
+		static std::vector<std::string> to_json_list(const std::string&);
+
+		/** A MessagePack str holding the given bytes. */
+		static std::string from_string(const std::string&);
+
+		/** A MessagePack map with one entry, `error`, holding
+		 *  the message. */
+		static std::string error(const std::string&);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_MSGPACK_CODEC_H
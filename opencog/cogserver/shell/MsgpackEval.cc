@@ -0,0 +1,173 @@
+/*
+ * opencog/cogserver/shell/MsgpackEval.cc
+ *
+ * MessagePack front end to the JSON evaluator.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <ctype.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+
+#include "MsgpackCodec.h"
+#include "MsgpackEval.h"
+
+using namespace opencog;
+
+MsgpackEval::MsgpackEval(GenericEval* json, bool framed) :
+	GenericEval(),
+	_json(json),
+	_framed(framed),
+	_running(false),
+	_nreqs(0),
+	_mpack_bytes(0),
+	_json_bytes(0),
+	_transcode_secs(0.0)
+{
+}
+
+MsgpackEval::~MsgpackEval()
+{
+	if (0 == _nreqs) return;
+	logger().info("[MsgpackShell] %zu requests: %zu bytes as MessagePack, "
+	              "%zu as JSON (%.0f%%); %.3f ms transcoding",
+	              _nreqs, _mpack_bytes, _json_bytes,
+	              100.0 * _mpack_bytes / std::max(_json_bytes, (size_t) 1),
+	              1000.0 * _transcode_secs);
+}
+
+/* ============================================================== */
+
+/// The JSON shell command for the request.
+std::string MsgpackEval::command(const std::string& frame)
+{
+	if (frame.empty())
+		throw SyntaxException(TRACE_INFO, "Empty request");
+
+	// Maps are passed on whole.
+	uint8_t tag = frame[0];
+	if ((tag & 0xf0) == 0x80 or 0xde == tag or 0xdf == tag)
+		return MsgpackCodec::to_json(frame) + "\n";
+
+	std::vector<std::string> items(MsgpackCodec::to_json_list(frame));
+	if (items.empty() or items[0].size() < 3 or '"' != items[0][0])
+		throw SyntaxException(TRACE_INFO,
+			"Expecting [method, arg, ...] or a map");
+
+	std::string method(items[0], 1, items[0].size() - 2);
+	for (char c : method)
+		if (not isalnum((unsigned char) c) and '_' != c)
+			throw SyntaxException(TRACE_INFO,
+				"Bad method name %s", items[0].c_str());
+
+	std::string cmd("AtomSpace." + method + "(");
+	for (size_t i = 1; i < items.size(); i++)
+	{
+		if (1 < i) cmd += ", ";
+		cmd += items[i];
+	}
+	return cmd + ")\n";
+}
+
+/// The JSON reply, as MessagePack.
+std::string MsgpackEval::reply(const std::string& text)
+{
+	try
+	{
+		return MsgpackCodec::from_json(text);
+	}
+	catch (const SyntaxException&)
+	{
+		return MsgpackCodec::from_string(text);
+	}
+}
+
+/* ============================================================== */
+
+void MsgpackEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void MsgpackEval::eval_expr(const std::string& frame)
+{
+	typedef std::chrono::steady_clock clock;
+	std::chrono::duration<double> secs(0);
+	std::string out;
+	try
+	{
+		auto start = clock::now();
+		std::string cmd(command(frame));
+		secs += clock::now() - start;
+
+		_json->begin_eval();
+		_json->eval_expr(cmd);
+		std::string text(_json->poll_result());
+		_json_bytes += cmd.size() + text.size();
+
+		start = clock::now();
+		if (_json->eval_error())
+		{
+			_caught_error = true;
+			size_t end = text.find_last_not_of(" \t\r\n");
+			out = MsgpackCodec::error(text.substr(0, end + 1));
+		}
+		else
+			out = reply(text);
+		secs += clock::now() - start;
+	}
+	catch (const std::exception& ex)
+	{
+		_caught_error = true;
+		out = MsgpackCodec::error(ex.what());
+	}
+
+	_nreqs++;
+	_mpack_bytes += frame.size() + out.size();
+	_transcode_secs += secs.count();
+
+	// Over telnet, prepend the length, as the socket does for
+	// incoming frames.
+	if (_framed)
+	{
+		uint32_t len = out.size();
+		char hdr[4];
+		for (int i = 0; i < 4; i++) hdr[i] = (len >> (8*i)) & 0xff;
+		out.insert(0, hdr, 4);
+	}
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_result += out;
+	_running = false;
+	_cv.notify_all();
+}
+
+/// Return the complete reply. The shell sends whatever this returns
+/// straight to the socket, so a reply must never be handed over in
+/// pieces.
+std::string MsgpackEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_result);
+	return rv;
+}
+
+void MsgpackEval::interrupt(void)
+{
+	_json->interrupt();
+	_caught_error = true;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,84 @@
+/*
+ * opencog/cogserver/shell/MsgpackEval.h
+ *
+ * MessagePack front end to the JSON evaluator.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_MSGPACK_EVAL_H
+#define _OPENCOG_MSGPACK_EVAL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include <opencog/eval/GenericEval.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the MsgpackShell. It provides the same commands as
+ * the JSON shell, by passing them on to the JsonEval, but requests
+ * and replies are MessagePack, instead of JSON text.
+ *
+ * A request is one MessagePack value:
+ *
+ *   [method, arg, ...]  -- calls `AtomSpace.method(arg, ...)`, with
+ *                          each argument given as the JSON value
+ *                          that it encodes; for example,
+ *                          ["getAtoms", "Node", true]
+ *   {...}               -- a map is passed on, as a JSON object, for
+ *                          JSON shells that take object requests
+ *
+ * The reply is the JSON reply, as MessagePack. If the JSON shell
+ * reports an error, or the request cannot be decoded, the reply is a
+ * map with one entry, `error`, holding the message. A reply that is
+ * not JSON is sent as a MessagePack str.
+ *
+ * Over a WebSocket, each request and reply is one binary frame. Over
+ * telnet, each is preceded by its length, as a four-byte little-endian
+ * integer, as in the binary shell.
+ *
+ * Sizes and transcoding time are counted, and logged when the shell
+ * closes, to compare with what the JSON text would have cost.
+ */
+class MsgpackEval : public GenericEval
+{
+	private:
+		GenericEval* _json;
+		bool _framed;
+
+		// The reply is built in the eval thread, and collected by
+		// the shell's poll thread.
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _result;
+
+		size_t _nreqs;
+		size_t _mpack_bytes;
+		size_t _json_bytes;
+		double _transcode_secs;
+
+		std::string command(const std::string&);
+		std::string reply(const std::string&);
+
+	public:
+		MsgpackEval(GenericEval*, bool framed);
+		virtual ~MsgpackEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_MSGPACK_EVAL_H
@@ -0,0 +1,68 @@
+/*
+ * opencog/cogserver/shell/MsgpackShell.cc
+ *
+ * MessagePack version of the JSON shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/persist/json/JsonEval.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "MsgpackShell.h"
+
+using namespace opencog;
+
+MsgpackShell::MsgpackShell(void) :
+	_framed(true)
+{
+	normal_prompt = "";
+	abort_prompt = "";
+	pending_prompt = "";
+
+	show_prompt = false;
+	binary_frames = true;
+	_name = "mpak";
+}
+
+MsgpackShell::~MsgpackShell()
+{
+	// The evaluator is ours; the eval thread must be done with it
+	// before it goes.
+	while_not_done();
+	join_eval();
+}
+
+/// WebSockets frame the replies themselves.
+void MsgpackShell::set_socket(ConsoleSocket* s)
+{
+	_framed = not s->is_websocket();
+	GenericShell::set_socket(s);
+}
+
+/// The thread's JsonEval, behind a MessagePack front end.
+GenericEval* MsgpackShell::get_evaluator(void)
+{
+	GenericEval* jev = JsonEval::get_evaluator(cogserver().getAtomSpace());
+	_mpack.reset(new MsgpackEval(jev, _framed));
+	return _mpack.get();
+}
+
+/// Frames are opaque; there are no telnet escapes or control
+/// characters to look for. An empty frame means "leave the shell".
+void MsgpackShell::line_discipline(const std::string& frame)
+{
+	if (0 == frame.size())
+	{
+		logger().debug("[MsgpackShell] got empty frame; exiting shell");
+		self_destruct = true;
+		evalque.cancel();
+		return;
+	}
+	evalque.push(frame);
+}
+
+/* ===================== END OF FILE ============================ */
@@ -0,0 +1,52 @@
+/*
+ * opencog/cogserver/shell/MsgpackShell.h
+ *
+ * MessagePack version of the JSON shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_MSGPACK_SHELL_H
+#define _OPENCOG_MSGPACK_SHELL_H
+
+#include <memory>
+
+#include <opencog/network/GenericShell.h>
+
+#include "MsgpackEval.h"
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * The JSON shell, speaking MessagePack instead of JSON text. Clients
+ * that decode replies into typed structures skip the JSON parse. See
+ * MsgpackEval for the requests and replies.
+ *
+ * Over a WebSocket (at the URL /msgpack), requests and replies are
+ * binary frames. Over telnet, they are length-prefixed frames; an
+ * empty frame leaves the shell.
+ */
+class MsgpackShell : public GenericShell
+{
+	private:
+		std::unique_ptr<MsgpackEval> _mpack;
+		bool _framed;
+
+	protected:
+		virtual void line_discipline(const std::string&);
+
+	public:
+		MsgpackShell(void);
+		virtual ~MsgpackShell();
+		virtual GenericEval* get_evaluator(void);
+		virtual void set_socket(ConsoleSocket*);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_MSGPACK_SHELL_H
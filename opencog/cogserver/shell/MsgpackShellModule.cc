@@ -0,0 +1,91 @@
+/*
+ * opencog/cogserver/shell/MsgpackShellModule.cc
+ *
+ * MessagePack version of the JSON shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_assert.h>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "MsgpackShell.h"
+#include "ShellModule.h"
+
+using namespace opencog;
+
+DEFINE_SHELL_MODULE(MsgpackShellModule);
+DECLARE_MODULE(MsgpackShellModule);
+
+MsgpackShellModule::MsgpackShellModule(CogServer& cs) : Module(cs)
+{
+}
+
+void MsgpackShellModule::init(void)
+{
+	_cogserver.registerRequest(shelloutRequest::info().id,
+	                           &shelloutFactory);
+}
+
+MsgpackShellModule::~MsgpackShellModule()
+{
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+}
+
+bool MsgpackShellModule::config(const char*)
+{
+	return false;
+}
+
+const RequestClassInfo&
+MsgpackShellModule::shelloutRequest::info(void)
+{
+	static const RequestClassInfo _cci("msgpack",
+		"Enter the MessagePack JSON shell",
+		"Usage: msgpack\n\n"
+		"Enter the MessagePack shell. This shell provides the same\n"
+		"AtomSpace API calls as the `json` shell, but requests and replies\n"
+		"are MessagePack, instead of JSON text, so that clients can decode\n"
+		"them without parsing JSON. A request is a MessagePack array,\n"
+		"holding the method name and its arguments; for example,\n"
+		"[\"getAtoms\", \"Node\", true]. The reply is the JSON reply,\n"
+		"as MessagePack, or a map holding an `error` string.\n\n"
+		"Over WebSockets, connect to /msgpack; each request and reply is\n"
+		"one binary frame. Over telnet, each is preceded by its length,\n"
+		"as a four-byte little-endian integer; send an empty frame (four\n"
+		"zero bytes) to exit the shell. See MsgpackEval.h for details.\n",
+		true, false);
+	return _cci;
+}
+
+/**
+ * Register this shell with the console.
+ */
+bool
+MsgpackShellModule::shelloutRequest::execute(void)
+{
+	ConsoleSocket *con = this->get_console();
+	OC_ASSERT(con, "Invalid Request object");
+
+	// Replies are binary; a warning goes to the log only.
+	std::string warn;
+	if (not _cogserver.checkUnpublished("msgpack", warn))
+	{
+		send(warn);
+		return true;
+	}
+
+	MsgpackShell *sh = new MsgpackShell();
+	sh->set_socket(con);
+	send("");
+	return true;
+}
+
+/* ===================== END OF FILE ============================ */
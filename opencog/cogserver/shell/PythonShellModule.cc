@@ -31,6 +31,9 @@
  */
 #ifdef HAVE_CYTHON
 
+// Python.h must come first; it defines feature-test macros.
+#include <Python.h>
+
 #include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/util/platform.h>
@@ -44,6 +47,9 @@ namespace opencog
 
 DECLARE_MODULE(PythonShellModule);
 
+// Python and Guile must not be started up at the same time.
+DECLARE_MODULE_DEPENDS("SchemeShellModule");
+
 PythonShellModule::PythonShellModule(CogServer& cs) : Module(cs)
 {
 	// Initialize Python.
@@ -51,10 +57,32 @@ PythonShellModule::PythonShellModule(CogServer& cs) : Module(cs)
 
 	// Tell the python evaluator to create its singleton instance
 	PythonEval::create_singleton_instance();
+
+	// Collect garbage while the server is idle. A light pass
+	// collects only the youngest generation.
+	cs.idleCollector().add_collector("py", [](bool full)
+	{
+		PyGILState_STATE gstate = PyGILState_Ensure();
+		if (full)
+			PyGC_Collect();
+		else
+		{
+			PyObject* gc = PyImport_ImportModule("gc");
+			if (gc)
+			{
+				PyObject* rc = PyObject_CallMethod(gc, "collect", "i", 0);
+				Py_XDECREF(rc);
+				Py_DECREF(gc);
+			}
+			PyErr_Clear();
+		}
+		PyGILState_Release(gstate);
+	});
 }
 
 PythonShellModule::~PythonShellModule()
 {
+    _cogserver.idleCollector().remove_collector("py");
     shellout_unregister();
     do_eval_unregister();
 }
@@ -70,6 +98,10 @@ std::string PythonShellModule::shellout(Request *req, std::list<std::string> arg
     ConsoleSocket *con = req->get_console();
     OC_ASSERT(con, "Invalid Request object");
 
+    std::string warn;
+    if (not _cogserver.checkUnpublished("python", warn))
+        return warn;
+
     PythonShell *sh = new PythonShell();
     sh->set_socket(con);
 
@@ -83,7 +115,7 @@ std::string PythonShellModule::shellout(Request *req, std::list<std::string> arg
 
     if (hush) return "";
 
-    std::string rv =
+    std::string rv = warn +
         "Entering python shell; use ^D or a single . on a "
         "line by itself to exit.\n" + sh->get_prompt();
     return rv;
@@ -0,0 +1,195 @@
+/*
+ * opencog/cogserver/shell/ReplicateEval.cc
+ *
+ * Evaluator for the leader side of replication.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "ReplicateEval.h"
+
+using namespace opencog;
+
+// Atoms sent per poll while copying the AtomSpace, and log entries
+// sent per poll while tailing the log. The shell polls about a
+// hundred times a second.
+#define COPY_BATCH 2000
+#define TAIL_BATCH 10000
+
+ReplicateEval::ReplicateEval(const AtomSpacePtr& asp) :
+	GenericEval(),
+	_atomspace(asp),
+	_log(cogserver().replicationLog()),
+	_running(false),
+	_following(false),
+	_after(0),
+	_next(0)
+{
+}
+
+ReplicateEval::~ReplicateEval()
+{
+	if (_following) _log.remove_follower();
+}
+
+/* ============================================================== */
+
+/// Begin sending a full copy. Everything logged after `_after` is
+/// sent once the copy is done. Some of those changes may already be
+/// in the copy; applying them a second time does no harm.
+void ReplicateEval::start_sync(void)
+{
+	_after = _log.head();
+	_pending.clear();
+	_atomspace->get_handles_by_type(_pending, ATOM, true);
+	_next = 0;
+	_reply += "(sync " + std::to_string(_log.epoch()) + " " +
+		std::to_string(_after) + ")\n";
+	logger().info("[ReplicateEval] sending %zu atoms to a follower",
+	              _pending.size());
+}
+
+std::string ReplicateEval::copy_some(void)
+{
+	std::string out;
+	size_t end = std::min(_next + COPY_BATCH, _pending.size());
+	for (; _next < end; _next++)
+	{
+		const Handle& h = _pending[_next];
+		std::string atom(Sexpr::encode_atom(h));
+		out += "(atom-added " + atom + ")\n";
+		for (const Handle& key : h->getKeys())
+			out += "(value-changed " + atom + " " +
+				Sexpr::encode_atom(key) + " " +
+				Sexpr::encode_value(h->getValue(key)) + ")\n";
+	}
+
+	if (_pending.size() <= _next)
+	{
+		_pending.clear();
+		_next = 0;
+		out += "(synced)\n";
+	}
+	return out;
+}
+
+std::string ReplicateEval::tail(void)
+{
+	std::vector<ReplicationLog::Entry> entries;
+	if (not _log.read(_after, entries, TAIL_BATCH))
+	{
+		logger().info("[ReplicateEval] follower fell behind the log");
+		start_sync();
+		std::string rv;
+		rv.swap(_reply);
+		return rv;
+	}
+
+	std::string out;
+	for (const ReplicationLog::Entry& e : entries)
+	{
+		out += std::to_string(e.first) + " " + e.second;
+		_after = e.first;
+	}
+	return out;
+}
+
+/* ============================================================== */
+
+void ReplicateEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void ReplicateEval::eval_expr(const std::string& expr)
+{
+	unsigned long long epoch = 0, after = 0;
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (2 != sscanf(expr.c_str(), " since %llu %llu", &epoch, &after))
+	{
+		if (expr.find_first_not_of(" \t\r\n") != std::string::npos)
+		{
+			_reply += "Expecting: since <epoch> <seq>\n";
+			_caught_error = true;
+		}
+	}
+	else
+	{
+		// End the line holding the console prompt, so that the
+		// follower sees each of our lines by itself.
+		if (not _following)
+		{
+			_log.add_follower();
+			_reply += "\n";
+		}
+		_following = true;
+		_log.enable();
+
+		// Check that the log still has everything the follower is
+		// missing. An empty read does that without copying anything.
+		std::vector<ReplicationLog::Entry> none;
+		_after = after;
+		if (0 == after or epoch != _log.epoch() or
+		    not _log.read(after, none, 0))
+			start_sync();
+		_last_sent = std::chrono::steady_clock::now();
+	}
+
+	_running = false;
+	_cv.notify_all();
+}
+
+std::string ReplicateEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_reply);
+	if (not _following) return rv;
+
+	if (0 < _pending.size()) rv += copy_some();
+	else rv += tail();
+
+	auto now = std::chrono::steady_clock::now();
+	if (0 < rv.size())
+		_last_sent = now;
+	else if (std::chrono::seconds(1) <= now - _last_sent)
+	{
+		_last_sent = now;
+		rv = "(heartbeat " + std::to_string(_log.head()) + ")\n";
+	}
+	return rv;
+}
+
+void ReplicateEval::interrupt(void)
+{
+	_caught_error = true;
+}
+
+// One evaluator per thread, and so one per follower.
+ReplicateEval* ReplicateEval::get_evaluator(const AtomSpacePtr& asp)
+{
+	static thread_local ReplicateEval* evaluator = new ReplicateEval(asp);
+
+	// The eval_dtor runs when this thread is destroyed.
+	class eval_dtor {
+		public:
+		~eval_dtor() { delete evaluator; }
+	};
+	static thread_local eval_dtor killer;
+
+	return evaluator;
+}
+
+/* ===================== END OF FILE ======================== */
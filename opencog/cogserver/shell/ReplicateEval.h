@@ -0,0 +1,79 @@
+/*
+ * opencog/cogserver/shell/ReplicateEval.h
+ *
+ * Evaluator for the leader side of replication.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_REPLICATE_EVAL_H
+#define _OPENCOG_REPLICATE_EVAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/eval/GenericEval.h>
+#include <opencog/cogserver/server/ReplicationLog.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the ReplicateShell, which feeds one follower. The
+ * follower sends a single command:
+ *
+ *   since <epoch> <seq>
+ *
+ * naming the last change it has applied. If the log still holds
+ * everything after that, the changes are sent from there on.
+ * Otherwise, the whole AtomSpace is sent first, between a
+ * `(sync <epoch> <seq>)` and a `(synced)` line. After that, each
+ * change is sent as it is logged, preceded by its sequence number.
+ * When there is nothing to send, a `(heartbeat <seq>)` line is sent
+ * once a second. See ReplicaClient for the follower side.
+ */
+class ReplicateEval : public GenericEval
+{
+	private:
+		AtomSpacePtr _atomspace;
+		ReplicationLog& _log;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _reply;
+
+		bool _following;
+		uint64_t _after;
+		HandleSeq _pending;
+		size_t _next;
+		std::chrono::steady_clock::time_point _last_sent;
+
+		void start_sync(void);
+		std::string copy_some(void);
+		std::string tail(void);
+
+		ReplicateEval(const AtomSpacePtr&);
+
+	public:
+		virtual ~ReplicateEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+
+		static ReplicateEval* get_evaluator(const AtomSpacePtr&);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_REPLICATE_EVAL_H
@@ -0,0 +1,37 @@
+/*
+ * opencog/cogserver/shell/ReplicateShell.cc
+ *
+ * Shell for the leader side of replication.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "ReplicateEval.h"
+#include "ReplicateShell.h"
+
+using namespace opencog;
+
+ReplicateShell::ReplicateShell(void)
+{
+	// No prompts; the follower is a program.
+	normal_prompt = "";
+	abort_prompt = "";
+	pending_prompt = "";
+
+	show_prompt = false;
+	_name = "repl";
+}
+
+ReplicateShell::~ReplicateShell()
+{
+}
+
+GenericEval* ReplicateShell::get_evaluator(void)
+{
+	return ReplicateEval::get_evaluator(cogserver().getAtomSpace());
+}
+
+/* ===================== END OF FILE ============================ */
@@ -0,0 +1,35 @@
+/*
+ * opencog/cogserver/shell/ReplicateShell.h
+ *
+ * Shell for the leader side of replication.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_REPLICATE_SHELL_H
+#define _OPENCOG_REPLICATE_SHELL_H
+
+#include <opencog/network/GenericShell.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * A shell that sends the AtomSpace, and then the replication log,
+ * to a follower. See ReplicateEval for the protocol.
+ */
+class ReplicateShell : public GenericShell
+{
+	public:
+		ReplicateShell(void);
+		virtual ~ReplicateShell();
+		virtual GenericEval* get_evaluator(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_REPLICATE_SHELL_H
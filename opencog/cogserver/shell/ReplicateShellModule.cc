@@ -0,0 +1,79 @@
+/*
+ * opencog/cogserver/shell/ReplicateShellModule.cc
+ *
+ * Shell for the leader side of replication.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_assert.h>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "ReplicateShell.h"
+#include "ShellModule.h"
+
+using namespace opencog;
+
+DEFINE_SHELL_MODULE(ReplicateShellModule);
+DECLARE_MODULE(ReplicateShellModule);
+
+ReplicateShellModule::ReplicateShellModule(CogServer& cs) : Module(cs)
+{
+}
+
+void ReplicateShellModule::init(void)
+{
+	_cogserver.registerRequest(shelloutRequest::info().id,
+	                           &shelloutFactory);
+}
+
+ReplicateShellModule::~ReplicateShellModule()
+{
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+}
+
+bool ReplicateShellModule::config(const char*)
+{
+	return false;
+}
+
+const RequestClassInfo&
+ReplicateShellModule::shelloutRequest::info(void)
+{
+	static const RequestClassInfo _cci("replicate",
+		"Send the AtomSpace and its changes to a follower",
+		"Usage: replicate\n\n"
+		"Enter the replication shell. This is used by a follower server,\n"
+		"started with the `follow` command, to copy the AtomSpace of this\n"
+		"server and then keep up with its changes. It is not meant to be\n"
+		"used by hand. The first use turns on the replication log; the\n"
+		"number of changes it keeps is set by REPLICATION_LOG_MAX.\n\n"
+		"Changes made through the binary shell and the `ingest` command\n"
+		"are replicated.\n",
+		true, false);
+	return _cci;
+}
+
+/**
+ * Register this shell with the console.
+ */
+bool
+ReplicateShellModule::shelloutRequest::execute(void)
+{
+	ConsoleSocket *con = this->get_console();
+	OC_ASSERT(con, "Invalid Request object");
+
+	ReplicateShell *sh = new ReplicateShell();
+	sh->set_socket(con);
+	send("");
+	return true;
+}
+
+/* ===================== END OF FILE ============================ */
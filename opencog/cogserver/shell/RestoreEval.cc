@@ -0,0 +1,167 @@
+/*
+ * opencog/cogserver/shell/RestoreEval.cc
+ *
+ * Load a streamed AtomSpace dump.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/cogserver/server/AtomSnapshot.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "RestoreEval.h"
+
+using namespace opencog;
+
+RestoreEval::RestoreEval(const AtomSpacePtr& as) :
+	GenericEval(),
+	_as(as),
+	_fd(-1),
+	_nbytes(0),
+	_running(false)
+{
+}
+
+RestoreEval::~RestoreEval()
+{
+	discard();
+}
+
+/// Throw away a dump that was not finished.
+void RestoreEval::discard(void)
+{
+	if (_fd < 0) return;
+	close(_fd);
+	unlink(_path.c_str());
+	_fd = -1;
+	_nbytes = 0;
+}
+
+void RestoreEval::append(const std::string& frame)
+{
+	if (_fd < 0)
+	{
+		_path = opencog::config().get("DUMP_DIR", "/tmp");
+		_path += "/cogserver-restore-XXXXXX";
+		_fd = mkstemp(&_path[0]);
+		if (_fd < 0)
+			throw IOException(TRACE_INFO, "Cannot create %s: %s",
+			                  _path.c_str(), strerror(errno));
+		_start = std::chrono::steady_clock::now();
+	}
+
+	size_t off = 0;
+	while (off < frame.size())
+	{
+		ssize_t wrote = write(_fd, frame.c_str() + off, frame.size() - off);
+		if (wrote < 0 and EINTR == errno) continue;
+		if (wrote < 0)
+		{
+			int err = errno;
+			discard();
+			throw IOException(TRACE_INFO, "Cannot write %s: %s",
+			                  _path.c_str(), strerror(err));
+		}
+		off += wrote;
+	}
+	_nbytes += frame.size();
+}
+
+/// Load the dump, and return the reply.
+std::string RestoreEval::finish(void)
+{
+	if (_fd < 0)
+		throw RuntimeException(TRACE_INFO, "Nothing to restore");
+
+	auto received = std::chrono::steady_clock::now();
+	int nthreads = opencog::config().get_int("SNAPSHOT_LOAD_THREADS",
+		std::thread::hardware_concurrency());
+
+	size_t natoms = 0;
+	size_t nbytes = _nbytes;
+	try
+	{
+		natoms = AtomSnapshot::load(_as, _path, nthreads,
+			&cogserver().changeFeed());
+	}
+	catch (...)
+	{
+		discard();
+		throw;
+	}
+	discard();
+
+	auto loaded = std::chrono::steady_clock::now();
+	std::chrono::duration<double> recv_secs = received - _start;
+	std::chrono::duration<double> load_secs = loaded - received;
+	std::chrono::duration<double> secs = loaded - _start;
+	logger().info("[RestoreShell] restored %zu atoms, %zu bytes: "
+	              "%.3f seconds to receive (%.1f MB/s), %.3f to load "
+	              "(%d threads)",
+	              natoms, nbytes, recv_secs.count(),
+	              nbytes / 1048576.0 / std::max(recv_secs.count(), 1e-6),
+	              load_secs.count(), nthreads);
+
+	char buf[128];
+	snprintf(buf, sizeof(buf), "(restore %zu %zu %.3f)\n",
+	         natoms, nbytes, secs.count());
+	return buf;
+}
+
+void RestoreEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void RestoreEval::eval_expr(const std::string& frame)
+{
+	std::string reply;
+	try
+	{
+		if (0 < frame.size())
+			append(frame);
+		else
+			reply = finish();
+	}
+	catch (const std::exception& ex)
+	{
+		reply = std::string("Error: ") + ex.what() + "\n";
+		_caught_error = true;
+	}
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_reply += reply;
+	_running = false;
+	_cv.notify_all();
+}
+
+std::string RestoreEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_reply);
+	return rv;
+}
+
+void RestoreEval::interrupt(void)
+{
+	// A load cannot be stopped part way.
+	_caught_error = true;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,65 @@
+/*
+ * opencog/cogserver/shell/RestoreEval.h
+ *
+ * Load a streamed AtomSpace dump.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_RESTORE_EVAL_H
+#define _OPENCOG_RESTORE_EVAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/eval/GenericEval.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the RestoreShell. Each frame that it is given is a
+ * piece of a dump, as sent by the `dump` command; the pieces are
+ * appended to a file in DUMP_DIR. An empty frame ends the dump: the
+ * file is loaded into the AtomSpace, in SNAPSHOT_LOAD_THREADS threads
+ * (see AtomSnapshot), and removed. The reply is
+ * `(restore <atoms> <bytes> <seconds>)`, or an error message.
+ */
+class RestoreEval : public GenericEval
+{
+	private:
+		AtomSpacePtr _as;
+		std::string _path;
+		int _fd;
+		size_t _nbytes;
+		std::chrono::steady_clock::time_point _start;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _reply;
+
+		void append(const std::string&);
+		std::string finish(void);
+		void discard(void);
+
+	public:
+		RestoreEval(const AtomSpacePtr&);
+		virtual ~RestoreEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_RESTORE_EVAL_H
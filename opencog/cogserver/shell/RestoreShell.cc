@@ -0,0 +1,58 @@
+/*
+ * opencog/cogserver/shell/RestoreShell.cc
+ *
+ * Shell that takes a streamed AtomSpace dump.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "RestoreShell.h"
+
+using namespace opencog;
+
+RestoreShell::RestoreShell(void) :
+	_have_data(false)
+{
+	normal_prompt = "";
+	abort_prompt = "";
+	pending_prompt = "";
+
+	show_prompt = false;
+	binary_frames = true;
+	_name = "rstr";
+}
+
+RestoreShell::~RestoreShell()
+{
+	// The evaluator is ours; the eval thread must be done with it
+	// before it goes.
+	while_not_done();
+	join_eval();
+}
+
+GenericEval* RestoreShell::get_evaluator(void)
+{
+	_restore.reset(new RestoreEval(cogserver().getAtomSpace()));
+	return _restore.get();
+}
+
+/// Frames are opaque. An empty frame ends the dump; an empty frame
+/// right after that, or before any data, leaves the shell.
+void RestoreShell::line_discipline(const std::string& frame)
+{
+	if (0 == frame.size() and not _have_data)
+	{
+		logger().debug("[RestoreShell] got empty frame; exiting shell");
+		self_destruct = true;
+		evalque.cancel();
+		return;
+	}
+	_have_data = (0 < frame.size());
+	evalque.push(frame);
+}
+
+/* ===================== END OF FILE ============================ */
@@ -0,0 +1,51 @@
+/*
+ * opencog/cogserver/shell/RestoreShell.h
+ *
+ * Shell that takes a streamed AtomSpace dump.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_RESTORE_SHELL_H
+#define _OPENCOG_RESTORE_SHELL_H
+
+#include <memory>
+
+#include <opencog/network/GenericShell.h>
+
+#include "RestoreEval.h"
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * A shell that reads the output of the `dump` command, from another
+ * server, as length-prefixed binary frames, and loads it into this
+ * server's AtomSpace. The frames are written out by the evaluator
+ * thread while the socket thread reads the next ones.
+ *
+ * The first empty frame ends a dump, and gets a reply; a second one,
+ * with no data in between, leaves the shell.
+ */
+class RestoreShell : public GenericShell
+{
+	private:
+		std::unique_ptr<RestoreEval> _restore;
+		bool _have_data;
+
+	protected:
+		virtual void line_discipline(const std::string&);
+
+	public:
+		RestoreShell(void);
+		virtual ~RestoreShell();
+		virtual GenericEval* get_evaluator(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_RESTORE_SHELL_H
@@ -0,0 +1,91 @@
+/*
+ * opencog/cogserver/shell/RestoreShellModule.cc
+ *
+ * Shell that takes a streamed AtomSpace dump.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_assert.h>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "RestoreShell.h"
+#include "ShellModule.h"
+
+using namespace opencog;
+
+DEFINE_SHELL_MODULE(RestoreShellModule);
+DECLARE_MODULE(RestoreShellModule);
+
+RestoreShellModule::RestoreShellModule(CogServer& cs) : Module(cs)
+{
+}
+
+void RestoreShellModule::init(void)
+{
+	_cogserver.registerRequest(shelloutRequest::info().id,
+	                           &shelloutFactory);
+}
+
+RestoreShellModule::~RestoreShellModule()
+{
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+}
+
+bool RestoreShellModule::config(const char*)
+{
+	return false;
+}
+
+const RequestClassInfo&
+RestoreShellModule::shelloutRequest::info(void)
+{
+	static const RequestClassInfo _cci("restore",
+		"Load an AtomSpace dump sent over this connection",
+		"Usage: restore\n\n"
+		"Load the output of the `dump` command, as sent by another\n"
+		"server, into the AtomSpace. After `restore`, send the dump as\n"
+		"it came: length-prefixed binary frames (a four-byte little-\n"
+		"endian length, then the bytes), ended by an empty frame. The\n"
+		"dump is written to a file in DUMP_DIR as it arrives, and then\n"
+		"loaded in SNAPSHOT_LOAD_THREADS threads. The reply is\n"
+		"`(restore <atoms> <bytes> <seconds>)`. Atoms already in the\n"
+		"AtomSpace are kept. Restored atoms are not sent to subscribers,\n"
+		"followers or the write-ahead log.\n\n"
+		"Another dump may follow. Send a second empty frame to exit the\n"
+		"shell. Not available over WebSockets.\n",
+		true, false);
+	return _cci;
+}
+
+/**
+ * Register this shell with the console.
+ */
+bool
+RestoreShellModule::shelloutRequest::execute(void)
+{
+	ConsoleSocket *con = this->get_console();
+	OC_ASSERT(con, "Invalid Request object");
+
+	// WebSockets carry their own framing, and would need a
+	// different set of changes.
+	if (con->is_websocket())
+	{
+		send("The restore shell is not available over WebSockets\n");
+		return true;
+	}
+
+	RestoreShell *sh = new RestoreShell();
+	sh->set_socket(con);
+	send("");
+	return true;
+}
+
+/* ===================== END OF FILE ============================ */
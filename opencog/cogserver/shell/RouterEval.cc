@@ -0,0 +1,404 @@
+/*
+ * opencog/cogserver/shell/RouterEval.cc
+ *
+ * Evaluator that spreads s-expression commands across shard servers.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <set>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/exceptions.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+
+#include "RouterEval.h"
+
+using namespace opencog;
+
+typedef std::chrono::steady_clock::time_point time_point;
+
+std::vector<std::string> RouterEval::_addresses;
+
+/// One connection to the sexpr shell of a shard server.
+class RouterEval::Shard
+{
+	private:
+		std::string _host;
+		int _port;
+		int _fd;
+		std::string _buf;
+
+	public:
+		Shard(const std::string& address) : _port(17001), _fd(-1)
+		{
+			size_t colon = address.rfind(':');
+			_host = address.substr(0, colon);
+			if (std::string::npos != colon)
+				_port = atoi(address.c_str() + colon + 1);
+		}
+		~Shard() { disconnect(); }
+
+		std::string name(void) const
+		{
+			return _host + ":" + std::to_string(_port);
+		}
+
+		void disconnect(void)
+		{
+			if (0 <= _fd) close(_fd);
+			_fd = -1;
+			_buf.clear();
+		}
+
+		void connect(time_point);
+		void send(const std::string&);
+		std::string recv(time_point);
+};
+
+void RouterEval::Shard::connect(time_point deadline)
+{
+	if (0 <= _fd) return;
+
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	struct addrinfo* res = nullptr;
+	int rc = getaddrinfo(_host.c_str(), std::to_string(_port).c_str(),
+	                     &hints, &res);
+	if (rc)
+		throw IOException(TRACE_INFO, "Cannot resolve shard %s: %s",
+		                  _host.c_str(), gai_strerror(rc));
+
+	for (struct addrinfo* ai = res; ai; ai = ai->ai_next)
+	{
+		_fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (_fd < 0) continue;
+		if (0 == ::connect(_fd, ai->ai_addr, ai->ai_addrlen)) break;
+		close(_fd);
+		_fd = -1;
+	}
+	freeaddrinfo(res);
+	if (_fd < 0)
+		throw IOException(TRACE_INFO, "Cannot connect to shard %s: %s",
+		                  name().c_str(), strerror(errno));
+
+	// The console prompt comes first, with no newline after it. Ask
+	// something, after entering the shell, and throw away the line
+	// that comes back, prompt and all.
+	send("sexpr\n(cog-node 'ConceptNode \"\")\n");
+	recv(deadline);
+	logger().info("[RouterEval] connected to shard %s", name().c_str());
+}
+
+void RouterEval::Shard::send(const std::string& msg)
+{
+	size_t off = 0;
+	while (off < msg.size())
+	{
+		ssize_t sent = ::send(_fd, msg.c_str() + off, msg.size() - off,
+		                      MSG_NOSIGNAL);
+		if (sent < 0 and EINTR == errno) continue;
+		if (sent < 0)
+		{
+			int err = errno;
+			disconnect();
+			throw IOException(TRACE_INFO, "Cannot send to shard %s: %s",
+			                  name().c_str(), strerror(err));
+		}
+		off += sent;
+	}
+}
+
+/// Return the next line from the shard, newline included.
+std::string RouterEval::Shard::recv(time_point deadline)
+{
+	char rd[65536];
+	while (true)
+	{
+		size_t nl = _buf.find('\n');
+		if (std::string::npos != nl)
+		{
+			std::string line(_buf, 0, nl + 1);
+			_buf.erase(0, nl + 1);
+			return line;
+		}
+
+		auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+			deadline - std::chrono::steady_clock::now());
+		struct pollfd pfd = {_fd, POLLIN, 0};
+		int rc = 0;
+		if (0 < left.count()) rc = poll(&pfd, 1, left.count());
+		if (rc < 0 and EINTR == errno) continue;
+		if (0 == rc)
+		{
+			// The reply may still come; there is no telling it
+			// apart from the next one. Start over.
+			disconnect();
+			throw IOException(TRACE_INFO, "No reply from shard %s",
+			                  name().c_str());
+		}
+
+		ssize_t got = (0 < rc) ? read(_fd, rd, sizeof(rd)) : -1;
+		if (got < 0 and EINTR == errno) continue;
+		if (got <= 0)
+		{
+			disconnect();
+			throw IOException(TRACE_INFO, "Lost connection to shard %s",
+			                  name().c_str());
+		}
+		_buf.append(rd, got);
+	}
+}
+
+/* ============================================================== */
+
+RouterEval::RouterEval(void) :
+	GenericEval(),
+	_running(false)
+{
+	_timeout = std::chrono::milliseconds(
+		config().get_int("ROUTER_TIMEOUT_MS", 10000));
+	for (const std::string& addr : _addresses)
+		_shards.emplace_back(new Shard(addr));
+}
+
+RouterEval::~RouterEval()
+{
+}
+
+void RouterEval::set_shards(const std::string& list)
+{
+	_addresses.clear();
+	size_t pos = 0;
+	while (true)
+	{
+		pos = list.find_first_not_of(", \t", pos);
+		if (std::string::npos == pos) break;
+		size_t end = list.find_first_of(", \t", pos);
+		_addresses.push_back(list.substr(pos, end - pos));
+		pos = end;
+	}
+}
+
+/// The shard that owns the atom. The atom is put into a standard
+/// form first, so that e.g. `(Concept "a")` and `(ConceptNode "a")`
+/// land on the same shard. The hash is FNV-1a, so that ownership
+/// does not change with the compiler or library version.
+size_t RouterEval::owner(const std::string& atom)
+{
+	std::string canon(Sexpr::encode_atom(Sexpr::decode_atom(atom)));
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned char c : canon)
+	{
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+	return hash % _shards.size();
+}
+
+/// Send the command to one shard, and return its reply.
+std::string RouterEval::one(size_t i, const std::string& cmd)
+{
+	time_point deadline = std::chrono::steady_clock::now() + _timeout;
+	Shard& shard = *_shards[i];
+	shard.connect(deadline);
+	shard.send(cmd);
+	return shard.recv(deadline);
+}
+
+/// Send the command to every shard, and then collect the replies, so
+/// that the shards work on it at the same time. If any shard fails,
+/// the replies of the others are still read, so that they stay in
+/// step, and then the first failure is thrown.
+std::vector<std::string> RouterEval::all(const std::string& cmd)
+{
+	time_point deadline = std::chrono::steady_clock::now() + _timeout;
+	std::vector<std::string> replies(_shards.size());
+	std::vector<bool> sent(_shards.size(), false);
+	std::string failure;
+
+	for (size_t i = 0; i < _shards.size(); i++)
+	{
+		try
+		{
+			_shards[i]->connect(deadline);
+			_shards[i]->send(cmd);
+			sent[i] = true;
+		}
+		catch (const std::exception& ex)
+		{
+			if (0 == failure.size()) failure = ex.what();
+		}
+	}
+	for (size_t i = 0; i < _shards.size(); i++)
+	{
+		if (not sent[i]) continue;
+		try
+		{
+			replies[i] = _shards[i]->recv(deadline);
+		}
+		catch (const std::exception& ex)
+		{
+			if (0 == failure.size()) failure = ex.what();
+		}
+	}
+	if (failure.size())
+		throw IOException(TRACE_INFO, "%s", failure.c_str());
+	return replies;
+}
+
+/// Merge lists of atoms from several shards, dropping duplicates.
+/// A reply that is not a list is returned as it is.
+static std::string merge(const std::vector<std::string>& replies)
+{
+	std::set<std::string> seen;
+	std::string rv("(");
+	for (const std::string& r : replies)
+	{
+		size_t pos = r.find_first_not_of(" \t\r\n");
+		if (std::string::npos == pos or '(' != r[pos]) return r;
+		pos++;
+		while (true)
+		{
+			pos = r.find_first_not_of(" \t\r\n", pos);
+			if (std::string::npos == pos or ')' == r[pos]) break;
+			std::string item(ChangeFeed::next_expr(r, pos));
+			if (seen.insert(item).second) rv += item;
+		}
+	}
+	return rv + ")\n";
+}
+
+/// Run one command; return the reply.
+std::string RouterEval::route(const std::string& line)
+{
+	size_t pos = line.find_first_not_of(" \t\r\n");
+	if (std::string::npos == pos) return "";
+	if (0 == _shards.size())
+		throw RuntimeException(TRACE_INFO,
+			"No shards; set ROUTER_SHARDS in the config file");
+	if ('(' != line[pos])
+		throw SyntaxException(TRACE_INFO, "Not a command: %.80s",
+		                      line.c_str());
+
+	size_t end = line.find_first_of(" \t\r\n)", pos);
+	if (std::string::npos == end) end = line.size();
+	std::string cmd(line, pos + 1, end - pos - 1);
+	std::string expr(line, pos, line.find_last_not_of(" \t\r\n") + 1 - pos);
+	expr += "\n";
+	pos = end;
+
+	// Commands about one atom, which comes first.
+	if (cmd == "cog-value" or cmd == "cog-keys->alist" or
+	    cmd == "cog-set-value!" or cmd == "cog-set-values!" or
+	    cmd == "cog-set-tv!" or cmd == "cog-update-value!")
+		return one(owner(ChangeFeed::next_expr(line, pos)), expr);
+
+	// Commands that give the type and the name, or the outgoing set,
+	// of one atom.
+	if (cmd == "cog-node" or cmd == "cog-link")
+	{
+		std::string type(ChangeFeed::next_expr(line, pos));
+		if ('\'' == type[0]) type.erase(0, 1);
+		size_t close = line.find_last_of(')');
+		std::string atom("(" + type + line.substr(pos, close - pos) + ")");
+		return one(owner(atom), expr);
+	}
+
+	// Searches. Links holding an atom may be on any shard.
+	if (cmd == "cog-get-atoms" or cmd == "cog-incoming-set" or
+	    cmd == "cog-incoming-by-type")
+		return merge(all(expr));
+
+	// An atom may be held, in links, on shards other than its owner.
+	if (cmd == "cog-extract!" or cmd == "cog-extract-recursive!")
+	{
+		std::vector<std::string> replies(all(expr));
+		for (const std::string& r : replies)
+			if (0 == r.compare(0, 2, "#t")) return r;
+		return replies[0];
+	}
+
+	if (cmd == "cog-atomspace-clear" or cmd == "cog-define" or
+	    cmd == "cog-set-proxy!" or cmd == "cog-proxy-open" or
+	    cmd == "cog-proxy-close")
+		return all(expr)[0];
+
+	if (cmd == "cog-atomspace")
+		return one(0, expr);
+
+	throw InvalidParamException(TRACE_INFO,
+		"The shard router does not handle %s", cmd.c_str());
+}
+
+void RouterEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void RouterEval::eval_expr(const std::string& expr)
+{
+	std::string reply;
+	try
+	{
+		reply = route(expr);
+	}
+	catch (const std::exception& ex)
+	{
+		reply = std::string("Error: ") + ex.what() + "\n";
+		_caught_error = true;
+	}
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_reply += reply;
+	_running = false;
+	_cv.notify_all();
+}
+
+std::string RouterEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_reply);
+	return rv;
+}
+
+void RouterEval::interrupt(void)
+{
+	// Commands wait no longer than ROUTER_TIMEOUT_MS.
+	_caught_error = true;
+}
+
+// One evaluator per thread, and so one set of connections per client.
+RouterEval* RouterEval::get_evaluator(void)
+{
+	static thread_local RouterEval* evaluator = new RouterEval();
+
+	// The eval_dtor runs when this thread is destroyed.
+	class eval_dtor {
+		public:
+		~eval_dtor() { delete evaluator; }
+	};
+	static thread_local eval_dtor killer;
+
+	return evaluator;
+}
+
+/* ===================== END OF FILE ======================== */
@@ -0,0 +1,88 @@
+/*
+ * opencog/cogserver/shell/RouterEval.h
+ *
+ * Evaluator that spreads s-expression commands across shard servers.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_ROUTER_EVAL_H
+#define _OPENCOG_ROUTER_EVAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/eval/GenericEval.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the RouterShell. It takes the same commands as the
+ * SexprEval, but, instead of running them on the local AtomSpace,
+ * sends them on to the `sexpr` shells of a set of shard servers,
+ * which, together, hold one logical AtomSpace.
+ *
+ * Each atom is owned by one shard, picked by a hash of its
+ * s-expression. Commands about one atom, such as `cog-set-value!`,
+ * `cog-value` or `cog-node`, go to the shard that owns it. Commands
+ * that search, such as `cog-get-atoms` and `cog-incoming-set`, go to
+ * every shard at once, and the lists that come back are merged, with
+ * duplicates removed. Commands that remove atoms or change the whole
+ * AtomSpace go to every shard. Adding a link also adds the atoms in
+ * it, on the link's shard; so an atom may be found on several shards,
+ * but its values are only on the one that owns it.
+ *
+ * The shards are listed in ROUTER_SHARDS; the order matters, as it
+ * decides ownership. Each evaluator holds its own connection to each
+ * shard, opened when first needed. A shard that does not answer
+ * within ROUTER_TIMEOUT_MS is disconnected, and the command fails.
+ */
+class RouterEval : public GenericEval
+{
+	private:
+		class Shard;
+		std::vector<std::unique_ptr<Shard>> _shards;
+		std::chrono::milliseconds _timeout;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _reply;
+
+		static std::vector<std::string> _addresses;
+
+		size_t owner(const std::string& atom);
+		std::string one(size_t, const std::string&);
+		std::vector<std::string> all(const std::string&);
+		std::string route(const std::string&);
+
+		RouterEval(void);
+
+	public:
+		virtual ~RouterEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+
+		/** Set the shards, as a list of `host:port`, separated by
+		 *  commas or spaces. Evaluators made afterwards use them. */
+		static void set_shards(const std::string&);
+		static size_t num_shards(void) { return _addresses.size(); }
+
+		static RouterEval* get_evaluator(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_ROUTER_EVAL_H
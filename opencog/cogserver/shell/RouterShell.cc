@@ -0,0 +1,35 @@
+/*
+ * opencog/cogserver/shell/RouterShell.cc
+ *
+ * Shell that spreads one logical AtomSpace across shard servers.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "RouterEval.h"
+#include "RouterShell.h"
+
+using namespace opencog;
+
+RouterShell::RouterShell(void)
+{
+	// The same as the sexpr shell: no prompts.
+	normal_prompt = "";
+	abort_prompt = "";
+	pending_prompt = "";
+
+	show_prompt = false;
+	_name = "rout";
+}
+
+RouterShell::~RouterShell()
+{
+}
+
+GenericEval* RouterShell::get_evaluator(void)
+{
+	return RouterEval::get_evaluator();
+}
+
+/* ===================== END OF FILE ============================ */
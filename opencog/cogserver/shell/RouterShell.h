@@ -0,0 +1,35 @@
+/*
+ * opencog/cogserver/shell/RouterShell.h
+ *
+ * Shell that spreads one logical AtomSpace across shard servers.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_ROUTER_SHELL_H
+#define _OPENCOG_ROUTER_SHELL_H
+
+#include <opencog/network/GenericShell.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * A stand-in for the SexprShell, that sends the commands on to a set
+ * of shard servers, instead of running them here. See RouterEval.
+ */
+class RouterShell : public GenericShell
+{
+	public:
+		RouterShell(void);
+		virtual ~RouterShell();
+		virtual GenericEval* get_evaluator(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_ROUTER_SHELL_H
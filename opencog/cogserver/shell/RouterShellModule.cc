@@ -0,0 +1,92 @@
+/*
+ * opencog/cogserver/shell/RouterShellModule.cc
+ *
+ * Shell that spreads one logical AtomSpace across shard servers.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_assert.h>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "RouterEval.h"
+#include "RouterShell.h"
+#include "ShellModule.h"
+
+using namespace opencog;
+
+DEFINE_SHELL_MODULE(RouterShellModule);
+DECLARE_MODULE(RouterShellModule);
+
+RouterShellModule::RouterShellModule(CogServer& cs) : Module(cs)
+{
+	RouterEval::set_shards(opencog::config().get("ROUTER_SHARDS", ""));
+	if (0 == RouterEval::num_shards())
+		logger().warn("[RouterShell] ROUTER_SHARDS is not set");
+	else
+		logger().info("[RouterShell] routing to %zu shards",
+		              RouterEval::num_shards());
+}
+
+void RouterShellModule::init(void)
+{
+	// This takes the place of the sexpr shell; only one of the two
+	// can be loaded.
+	if (not _cogserver.registerRequest(shelloutRequest::info().id,
+	                                   &shelloutFactory))
+		logger().error("[RouterShell] the `sexpr` command is taken; "
+		               "do not load libsexpr-shell.so in router mode");
+}
+
+RouterShellModule::~RouterShellModule()
+{
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+}
+
+bool RouterShellModule::config(const char*)
+{
+	return false;
+}
+
+const RequestClassInfo&
+RouterShellModule::shelloutRequest::info(void)
+{
+	static const RequestClassInfo _cci("sexpr",
+		"Enter the sharding s-expression shell",
+		"Usage: sexpr\n\n"
+		"Enter the s-expression shell of a sharding router. It takes the\n"
+		"same commands as the ordinary s-expression shell, and sends\n"
+		"them on to the shard servers listed in ROUTER_SHARDS, which\n"
+		"together hold one AtomSpace. Commands about one atom go to the\n"
+		"shard that owns it; searches go to every shard, and the results\n"
+		"are merged; removals go to every shard.\n\n"
+		"Use either a ^D (ctrl-D) or a single . on a line by itself to exit\n"
+		"the shell.\n",
+		true, false);
+	return _cci;
+}
+
+/**
+ * Register this shell with the console.
+ */
+bool
+RouterShellModule::shelloutRequest::execute(void)
+{
+	ConsoleSocket *con = this->get_console();
+	OC_ASSERT(con, "Invalid Request object");
+
+	RouterShell *sh = new RouterShell();
+	sh->set_socket(con);
+	send("");
+	return true;
+}
+
+/* ===================== END OF FILE ============================ */
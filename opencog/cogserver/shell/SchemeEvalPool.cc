@@ -0,0 +1,150 @@
+/*
+ * opencog/cogserver/shell/SchemeEvalPool.cc
+ *
+ * Pool of pre-warmed scheme evaluators.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifdef HAVE_GUILE
+
+#include <sys/prctl.h>
+
+#include <chrono>
+
+#include <opencog/util/Logger.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "SchemeEvalPool.h"
+
+using namespace opencog;
+
+SchemeEvalPool::SchemeEvalPool(size_t size, const std::string& init) :
+	_nstale(0),
+	_filler(nullptr),
+	_size(size),
+	_stop(false),
+	_init(init)
+{
+	if (0 == _size) return;
+	_filler = new std::thread(&SchemeEvalPool::fill_loop, this);
+}
+
+SchemeEvalPool::~SchemeEvalPool()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_stop = true;
+	}
+	_cv.notify_all();
+
+	if (_filler)
+	{
+		_filler->join();
+		delete _filler;
+		_filler = nullptr;
+	}
+
+	for (const Ready& r : _ready) delete r.ev;
+	for (SchemeEval* ev : _retired) delete ev;
+}
+
+/// Create a new evaluator, and run the init string in it.
+SchemeEvalPool::Ready SchemeEvalPool::make_evaluator(void)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	// The generation is read first; if it changes while the init
+	// string runs, the evaluator is thrown out when it is taken.
+	size_t gen = cogserver().atomSpaceGeneration();
+	AtomSpacePtr asp = cogserver().getAtomSpace();
+	SchemeEval* ev = new SchemeEval(asp);
+	if (0 < _init.size())
+	{
+		std::string rs = ev->eval(_init);
+		if (ev->eval_error())
+			logger().warn("[SchemeEvalPool] init failed: %s", rs.c_str());
+	}
+	ev->clear_pending();
+
+	std::chrono::duration<double, std::milli> ms =
+		std::chrono::steady_clock::now() - start;
+	logger().debug("[SchemeEvalPool] warmed up evaluator in %.1f ms",
+	               ms.count());
+	return {ev, asp, gen};
+}
+
+/// Keep the pool full, and delete evaluators that have been returned.
+/// Both are done here, and not in the shell threads, so that the cost
+/// is never paid by a user waiting on a prompt.
+void SchemeEvalPool::fill_loop(void)
+{
+	prctl(PR_SET_NAME, "cogserv:scmpool", 0, 0, 0);
+
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (not _stop)
+	{
+		while (not _retired.empty())
+		{
+			SchemeEval* ev = _retired.front();
+			_retired.pop_front();
+			lck.unlock();
+			delete ev;
+			lck.lock();
+		}
+
+		if (_ready.size() < _size)
+		{
+			lck.unlock();
+			Ready r = make_evaluator();
+			lck.lock();
+			_ready.push_back(r);
+			continue;
+		}
+
+		_cv.wait(lck);
+	}
+}
+
+SchemeEval* SchemeEvalPool::take(void)
+{
+	AtomSpacePtr asp = cogserver().getAtomSpace();
+	size_t gen = cogserver().atomSpaceGeneration();
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	SchemeEval* ev = nullptr;
+	while (nullptr == ev and not _ready.empty())
+	{
+		Ready r = _ready.front();
+		_ready.pop_front();
+		if (r.as == asp and r.generation == gen)
+			ev = r.ev;
+		else
+		{
+			_retired.push_back(r.ev);
+			if (0 == _nstale++)
+				logger().info("[SchemeEvalPool] the AtomSpace changed; "
+				              "warming up evaluators again");
+		}
+	}
+	_cv.notify_all();
+	return ev;
+}
+
+void SchemeEvalPool::release(SchemeEval* ev)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_retired.push_back(ev);
+	_cv.notify_all();
+}
+
+size_t SchemeEvalPool::num_ready(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	return _ready.size();
+}
+
+#endif // HAVE_GUILE
+/* ===================== END OF FILE ============================ */
@@ -0,0 +1,92 @@
+/*
+ * opencog/cogserver/shell/SchemeEvalPool.h
+ *
+ * Pool of pre-warmed scheme evaluators.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifdef HAVE_GUILE
+
+#ifndef _OPENCOG_SCHEME_EVAL_POOL_H
+#define _OPENCOG_SCHEME_EVAL_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+class SchemeEval;
+
+/**
+ * A small pool of scheme evaluators that have already been created,
+ * and have already run a configurable init string (typically a list
+ * of `use-modules`). New scheme shells take an evaluator from the
+ * pool, so that the first command typed by the user doesn't pay for
+ * guile thread setup and module loading.
+ *
+ * A background thread keeps the pool topped up. Evaluators are not
+ * reused: once a shell is done with one, it is handed back to the
+ * background thread to be deleted, and a fresh one is made to take
+ * its place.
+ *
+ * Each evaluator is made for the server AtomSpace, as it is at the
+ * time; the init string may well have looked atoms up in it. If the
+ * server AtomSpace has since been replaced, or its contents have (see
+ * CogServer::atomSpaceGeneration()), take() throws the evaluator out,
+ * instead of handing it over, and the pool is filled again.
+ */
+class SchemeEvalPool
+{
+	private:
+		// An evaluator, and what it was made for.
+		struct Ready
+		{
+			SchemeEval* ev;
+			AtomSpacePtr as;
+			size_t generation;
+		};
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		std::deque<Ready> _ready;
+		std::deque<SchemeEval*> _retired;
+		size_t _nstale;
+		std::thread* _filler;
+		size_t _size;
+		bool _stop;
+		std::string _init;
+
+		Ready make_evaluator(void);
+		void fill_loop(void);
+
+	public:
+		SchemeEvalPool(size_t size, const std::string& init);
+		~SchemeEvalPool();
+
+		/** Take a ready evaluator, made for the server AtomSpace as it
+		 *  is now; returns null if none are ready. */
+		SchemeEval* take(void);
+
+		/** Give back an evaluator obtained from take(). */
+		void release(SchemeEval*);
+
+		/** The number of evaluators ready, stale or not. */
+		size_t num_ready(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_SCHEME_EVAL_POOL_H
+
+#endif // HAVE_GUILE
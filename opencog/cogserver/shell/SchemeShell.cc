@@ -22,6 +22,8 @@
 
 #ifdef HAVE_GUILE
 
+#include <chrono>
+
 #include <opencog/util/Config.h>
 #include <opencog/util/Logger.h>
 #include <opencog/guile/SchemeEval.h>
@@ -32,8 +34,12 @@
 using namespace opencog;
 
 std::string SchemeShell::_prompt;
+std::shared_ptr<SchemeEvalPool> SchemeShell::evaluator_pool;
 
-SchemeShell::SchemeShell(void)
+SchemeShell::SchemeShell(void) :
+	_pool(evaluator_pool),
+	_pooled(nullptr),
+	_want_snapshot(false)
 {
 	_prompt = "[0;34mguile[1;34m> [0m";
 
@@ -63,11 +69,39 @@ SchemeShell::~SchemeShell()
 	// might never get a chance to run, leading to a NULL
 	// atomspace, leading to a crash.  Bug #2328.
 	while_not_done();
+
+	// A pooled evaluator is ours to give back, but only after the
+	// eval thread is completely done with it.
+	if (_pooled)
+	{
+		join_eval();
+		_pool->release(_pooled);
+		_pooled = nullptr;
+	}
 }
 
 GenericEval* SchemeShell::get_evaluator(void)
 {
-	return SchemeEval::get_evaluator(cogserver().getAtomSpace());
+	auto start = std::chrono::steady_clock::now();
+	GenericEval* ev = nullptr;
+
+	// Pooled evaluators were set up for the server AtomSpace; a
+	// snapshot shell gets a fresh one of its own.
+	if (_want_snapshot)
+		_snapshot = cogserver().readSnapshot();
+	if (_snapshot)
+		ev = SchemeEval::get_evaluator(_snapshot);
+	else if (_pool)
+		ev = _pooled = _pool->take();
+	if (nullptr == ev)
+		ev = SchemeEval::get_evaluator(cogserver().getAtomSpace());
+
+	std::chrono::duration<double, std::milli> ms =
+		std::chrono::steady_clock::now() - start;
+	logger().debug("[SchemeShell] %s evaluator ready in %.2f ms",
+	              _pooled ? "pooled" : (_snapshot ? "snapshot" : "new"),
+	              ms.count());
+	return ev;
 }
 
 /**
@@ -75,7 +109,10 @@ GenericEval* SchemeShell::get_evaluator(void)
  */
 void SchemeShell::thread_init(void)
 {
-	SchemeEval::set_scheme_as(cogserver().getAtomSpace().get());
+	if (_snapshot)
+		SchemeEval::set_scheme_as(_snapshot.get());
+	else
+		SchemeEval::set_scheme_as(cogserver().getAtomSpace().get());
 }
 
 #endif
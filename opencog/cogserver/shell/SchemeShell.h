@@ -25,9 +25,12 @@
 #ifndef _OPENCOG_SCHEME_SHELL_H
 #define _OPENCOG_SCHEME_SHELL_H
 
+#include <memory>
 #include <string>
 
+#include <opencog/atomspace/AtomSpace.h>
 #include <opencog/network/GenericShell.h>
+#include "SchemeEvalPool.h"
 
 namespace opencog {
 /** \addtogroup grp_server
@@ -40,10 +43,29 @@ class SchemeShell : public GenericShell
 		void thread_init();
 		static std::string _prompt;
 
+		// Evaluator taken from the pool, if any. The pool is held
+		// by a shared pointer, as the shell may outlive the module.
+		std::shared_ptr<SchemeEvalPool> _pool;
+		SchemeEval* _pooled;
+
+		// A read-only snapshot, or null, for the server AtomSpace.
+		// Taken in the eval thread, if wanted.
+		bool _want_snapshot;
+		AtomSpacePtr _snapshot;
+
 	public:
+		/** Pool of warm evaluators shared by all new scheme shells. */
+		static std::shared_ptr<SchemeEvalPool> evaluator_pool;
+
 		SchemeShell(void);
 		virtual ~SchemeShell();
 		virtual GenericEval* get_evaluator(void);
+
+		/// Evaluate in a read snapshot, instead of the server
+		/// AtomSpace. Must be called before the shell is given its
+		/// socket; the copy is made in the eval thread, so as not to
+		/// hold up the server loop.
+		void use_snapshot(void) { _want_snapshot = true; }
 };
 
 /** @}*/
@@ -22,6 +22,7 @@
 
 #ifdef HAVE_GUILE
 
+#include <opencog/util/Config.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/guile/SchemeEval.h>
@@ -43,6 +44,31 @@ SchemeShellModule::SchemeShellModule(CogServer& cs) : Module(cs)
 	// Tell scheme which atomspace to use.
 	SchemeEval::init_scheme();
 	SchemeEval::set_scheme_as(cs.getAtomSpace().get());
+
+	// Keep a few evaluators warmed up, so that new shells start hot.
+	// Module loading in guile is global, so the preloads are actually
+	// paid for once, by the first pooled evaluator.
+	int npool = opencog::config().get_int("SCM_EVALUATOR_POOL", 2);
+	std::string init;
+	std::string mods = opencog::config().get("SCM_PRELOAD_MODULES", "");
+	if (0 < mods.size())
+		init = "(use-modules " + mods + ")\n";
+	init += opencog::config().get("SCM_INIT_EXPR", "");
+
+	if (0 < npool)
+		SchemeShell::evaluator_pool =
+			std::make_shared<SchemeEvalPool>(npool, init);
+
+	// Collect garbage while the server is idle. Guile's collector is
+	// not generational, so there is no cheaper light pass; only the
+	// full collection is done.
+	AtomSpacePtr asp = cs.getAtomSpace();
+	cs.idleCollector().add_collector("scm", [asp](bool full)
+	{
+		if (not full) return;
+		SchemeEval* ev = SchemeEval::get_evaluator(asp);
+		ev->eval("(gc)");
+	});
 }
 
 void SchemeShellModule::init(void)
@@ -53,7 +79,12 @@ void SchemeShellModule::init(void)
 
 SchemeShellModule::~SchemeShellModule()
 {
-	_cogserver.unregisterRequest(shelloutRequest::info().id);
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+	_cogserver.idleCollector().remove_collector("scm");
+
+	// Open shells hold their own reference to the pool.
+	SchemeShell::evaluator_pool.reset();
 }
 
 bool SchemeShellModule::config(const char*)
@@ -66,7 +97,7 @@ SchemeShellModule::shelloutRequest::info(void)
 {
 	static const RequestClassInfo _cci("scm",
 		"Enter the scheme shell",
-		"Usage: scm [hush|quiet]\n\n"
+		"Usage: scm [hush|quiet] [snapshot]\n\n"
 		"Enter the scheme interpreter shell. This shell provides a rich\n"
 		"and easy-to-use environment for creating, deleting and manipulating\n"
 		"OpenCog atoms and truth values. It provides a full R5RS-compliant\n"
@@ -74,6 +105,10 @@ SchemeShellModule::shelloutRequest::info(void)
 		"If 'hush' or 'quiet' is specified after the command, then the prompt\n"
 		"will not be returned.  This is nice when catting large scripts using\n"
 		"netcat, as it avoids printing garbage when the scripts work well.\n\n"
+		"If 'snapshot' is specified, the shell works on a read-only copy\n"
+		"of the AtomSpace, taken when the shell is entered. It does not\n"
+		"see changes made after that, so that long reads see the same\n"
+		"data from beginning to end.\n\n"
 		"Use either a ^D (ctrl-D) or a single . on a line by itself to exit\n"
 		"the shell. A ^C (ctrl-C) can be used to kill long-running or\n"
 		"unresponsive scheme functions.\n",
@@ -90,14 +125,29 @@ SchemeShellModule::shelloutRequest::execute(void)
 	ConsoleSocket *con = this->get_console();
 	OC_ASSERT(con, "Invalid Request object");
 
+	bool hush = false;
+	bool snapshot = false;
+	for (const std::string& arg : _parameters)
+	{
+		if (arg == "quiet" || arg == "hush") hush = true;
+		else if (arg == "snapshot") snapshot = true;
+	}
+
+	// A snapshot is read-only; there is nothing to publish.
+	std::string warn;
+	if (not snapshot and not _cogserver.checkUnpublished("scheme", warn))
+	{
+		send(warn);
+		return true;
+	}
+
 	SchemeShell *sh = new SchemeShell();
+	if (snapshot)
+		sh->use_snapshot();
 	sh->set_socket(con);
 
 	if (!_parameters.empty())
 	{
-		bool hush = false;
-		std::string &arg = _parameters.front();
-		if (arg == "quiet" || arg == "hush") hush = true;
 		sh->hush_prompt(hush);
 		sh->hush_output(hush);
 
@@ -105,7 +155,7 @@ SchemeShellModule::shelloutRequest::execute(void)
 		if (hush) { send(""); return true; }
 	}
 
-	std::string rv =
+	std::string rv = warn +
 		"Entering scheme shell; use ^D or a single . on a "
 		"line by itself to exit.\n" + sh->get_prompt();
 	send(rv);
@@ -0,0 +1,268 @@
+/*
+ * opencog/cogserver/shell/SexprBatchEval.cc
+ *
+ * Client-delimited write batches for the s-expression shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "SexprBatchEval.h"
+
+using namespace opencog;
+
+SexprBatchEval::SexprBatchEval(GenericEval* sexpr, Applied applied) :
+	GenericEval(),
+	_sexpr(sexpr),
+	_applied(applied),
+	_running(false),
+	_batching(false)
+{
+	_max = config().get_int("SEXPR_BATCH_MAX", 100000);
+}
+
+SexprBatchEval::~SexprBatchEval()
+{
+}
+
+/* ============================================================== */
+
+/// Run the buffered commands, publishing their changes as one batch.
+/// Return the reply.
+std::string SexprBatchEval::commit(void)
+{
+	auto start = std::chrono::steady_clock::now();
+	ChangeFeed& feed = cogserver().changeFeed();
+
+	std::string errors;
+	size_t nok = 0;
+	size_t nfail = 0;
+	std::string lost;
+	feed.begin_batch();
+	for (const std::string& expr : _batch)
+	{
+		_sexpr->begin_eval();
+		_sexpr->eval_expr(expr);
+		std::string reply(_sexpr->poll_result());
+		if (_sexpr->input_pending())
+		{
+			// Only whole expressions are buffered, so the SexprEval
+			// should never be left waiting for more.
+			_sexpr->clear_pending();
+			nfail++;
+			errors += "Error: incomplete expression: " + expr;
+		}
+		else if (_sexpr->eval_error())
+		{
+			nfail++;
+			errors += reply;
+		}
+		else nok++;
+		try
+		{
+			if (_applied) _applied();
+		}
+		catch (const std::exception& ex)
+		{
+			if (lost.empty()) lost = ex.what();
+		}
+	}
+	try
+	{
+		feed.end_batch();
+	}
+	catch (const std::exception& ex)
+	{
+		if (lost.empty()) lost = ex.what();
+	}
+	if (not lost.empty())
+	{
+		_caught_error = true;
+		errors += "Error: " + lost + "\n";
+	}
+
+	std::chrono::duration<double> secs =
+		std::chrono::steady_clock::now() - start;
+	logger().info("[SexprShell] committed %zu commands (%zu failed) "
+	              "in %.3f seconds; %.0f commands/s",
+	              nok, nfail, secs.count(),
+	              _batch.size() / std::max(secs.count(), 1e-6));
+
+	_batch.clear();
+	_batch.shrink_to_fit();
+	return errors + "(commit " + std::to_string(nok) + " " +
+	       std::to_string(nfail) + ")\n";
+}
+
+/// True if the text holds nothing but whole expressions: every paren
+/// that is opened is closed again. Parens in strings do not count. Too many closing parens count as complete, so that the
+/// SexprEval gets to report the error.
+static bool complete(const std::string& text)
+{
+	int depth = 0;
+	bool quoted = false;
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		char c = text[i];
+		if (quoted)
+		{
+			if ('\\' == c) i++;
+			else if ('"' == c) quoted = false;
+		}
+		else if ('"' == c) quoted = true;
+		else if ('(' == c) depth++;
+		else if (')' == c) depth--;
+	}
+	return not quoted and depth <= 0;
+}
+
+/// Handle the command here, if it is about batching, or if a batch
+/// is open. Return false, if it should go to the SexprEval instead.
+bool SexprBatchEval::cmd(const std::string& line)
+{
+	// The batch commands are only seen between expressions, not in
+	// the middle of one.
+	if (_partial.empty())
+	{
+		size_t beg = line.find_first_not_of(" \t\r\n");
+		size_t end = line.find_last_not_of(" \t\r\n");
+		std::string verb;
+		if (std::string::npos != beg)
+			verb = line.substr(beg, end - beg + 1);
+
+		if (verb == "begin")
+		{
+			if (_batching)
+			{
+				_caught_error = true;
+				_reply = "Error: a batch is already open\n";
+				return true;
+			}
+			_batching = true;
+			return true;
+		}
+		if (verb == "commit" or verb == "abort")
+		{
+			if (not _batching)
+			{
+				_caught_error = true;
+				_reply = "Error: no batch is open\n";
+				return true;
+			}
+			_batching = false;
+			if (verb == "commit")
+				_reply = commit();
+			else
+			{
+				_batch.clear();
+				_batch.shrink_to_fit();
+			}
+			return true;
+		}
+	}
+	if (not _batching) return false;
+
+	// Buffer whole expressions only, so that each is run, counted and
+	// published as one command, however many lines it took.
+	_partial += line;
+	if (not complete(_partial)) return true;
+
+	std::string expr;
+	expr.swap(_partial);
+	if (std::string::npos == expr.find_first_not_of(" \t\r\n"))
+		return true;
+	if (_max <= _batch.size())
+	{
+		_caught_error = true;
+		_reply = "Error: batch is full (SEXPR_BATCH_MAX = " +
+			std::to_string(_max) + "); commit or abort\n";
+		return true;
+	}
+	_batch.push_back(expr);
+	return true;
+}
+
+void SexprBatchEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void SexprBatchEval::eval_expr(const std::string& expr)
+{
+	// The SexprEval finishes its work in eval_expr(), so its reply can
+	// be collected here, and held back until the change is published.
+	std::string reply;
+	bool error = false;
+	bool pending = false;
+	if ((_batching or _partial.empty()) and cmd(expr))
+	{
+		reply.swap(_reply);
+		error = _caught_error;
+		pending = not _partial.empty();
+	}
+	else
+	{
+		_sexpr->begin_eval();
+		_sexpr->eval_expr(expr);
+		reply = _sexpr->poll_result();
+		error = _sexpr->eval_error();
+		pending = _sexpr->input_pending();
+
+		if (pending) _partial += expr;
+		else
+		{
+			_partial.clear();
+			try
+			{
+				if (_applied) _applied();
+			}
+			catch (const std::exception& ex)
+			{
+				error = true;
+				reply += std::string("Error: ") + ex.what() + "\n";
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_reply = reply;
+	_caught_error = error;
+	_pending_input = pending;
+	_running = false;
+	_cv.notify_all();
+}
+
+/// Wait for the command to be done, like the SexprEval would.
+std::string SexprBatchEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_reply);
+	return rv;
+}
+
+void SexprBatchEval::interrupt(void)
+{
+	_sexpr->interrupt();
+	_caught_error = true;
+}
+
+void SexprBatchEval::clear_pending(void)
+{
+	_sexpr->clear_pending();
+	_partial.clear();
+	_pending_input = false;
+}
+
+/* ===================== END OF FILE ======================== */
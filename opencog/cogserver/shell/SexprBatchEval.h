@@ -0,0 +1,100 @@
+/*
+ * opencog/cogserver/shell/SexprBatchEval.h
+ *
+ * Client-delimited write batches for the s-expression shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_SEXPR_BATCH_EVAL_H
+#define _OPENCOG_SEXPR_BATCH_EVAL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/eval/GenericEval.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the SexprShell, that passes everything on to the
+ * SexprEval, except for three commands:
+ *
+ *   begin   -- start buffering commands
+ *   commit  -- run the buffered commands, and stop buffering
+ *   abort   -- throw the buffered commands away, and stop buffering
+ *
+ * A command may take several lines; it is buffered once its parens
+ * balance, and counts as one. The three commands above are only
+ * seen between commands, not in the middle of one.
+ *
+ * Buffered commands get no reply. On commit, they are run one after
+ * another, without going back to the network in between, and the
+ * changes they make are published as one batch, so that the
+ * write-ahead log is waited on only once. The reply to `commit` is
+ * the error messages from the commands that failed, if any, followed
+ * by `(commit <ok> <failed>)`.
+ *
+ * Commands in a batch see the AtomSpace as it is at the time of the
+ * commit; a read in the middle of a batch is pointless, as its reply
+ * is dropped. No more than SEXPR_BATCH_MAX commands are buffered;
+ * past that, each command is refused with an error.
+ *
+ * Outside of a batch, the Applied callback runs after each command,
+ * too. Either way, it runs before the reply is released, so that a
+ * client that has seen the reply knows that the change was published,
+ * and, with a sync write-ahead log, is on disk. If the callback throws,
+ * the reply is an error.
+ */
+class SexprBatchEval : public GenericEval
+{
+	public:
+		/// Called after each command is run, to publish its changes.
+		typedef std::function<void(void)> Applied;
+
+	private:
+		GenericEval* _sexpr;
+		Applied _applied;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _reply;
+
+		// The lines of a command that is not complete yet, whether
+		// it is for the SexprEval or for the batch.
+		std::string _partial;
+
+		bool _batching;
+		std::vector<std::string> _batch;
+		size_t _max;
+
+		bool cmd(const std::string&);
+		std::string commit(void);
+
+	public:
+		SexprBatchEval(GenericEval*, Applied);
+		virtual ~SexprBatchEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+		virtual void clear_pending(void);
+
+		/// True while commands are being buffered. Only meaningful
+		/// in the evaluating thread.
+		bool batching(void) const { return _batching; }
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_SEXPR_BATCH_EVAL_H
@@ -0,0 +1,192 @@
+/*
+ * opencog/cogserver/shell/SexprCommands.cc
+ *
+ * Command hooks for the s-expression shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <functional>
+
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/cogserver/server/AccessSampler.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+#include <opencog/cogserver/server/ReadThrough.h>
+
+#include "SexprCommands.h"
+
+using namespace opencog;
+
+SexprCommands::SexprCommands(const AtomSpacePtr& as, AccessSampler* hot,
+                             ReadThrough* rt) :
+	_as(as),
+	_hot(hot),
+	_rt(rt),
+	_decoder(*dynamic_cast<UnwrappedCommands*>(this))
+{
+	_decoder.set_base_space(_as);
+
+	have_get_atoms_cb = true;
+	have_incoming_set_cb = true;
+	have_incoming_by_type_cb = true;
+	have_keys_alist_cb = true;
+	have_node_cb = true;
+	have_link_cb = true;
+	have_value_cb = true;
+
+	have_extract_cb = true;
+	have_extract_recursive_cb = true;
+	have_set_value_cb = true;
+	have_set_values_cb = true;
+	have_set_tv_cb = true;
+	have_update_value_cb = true;
+}
+
+SexprCommands::~SexprCommands()
+{
+}
+
+void SexprCommands::install(SexprEval* sev)
+{
+	using namespace std::placeholders;
+
+#define INST(STR,CB) \
+	sev->install_handler(STR, std::bind(&Commands::CB, &_decoder, _1));
+
+	INST("cog-get-atoms",          cog_get_atoms);
+	INST("cog-incoming-by-type",   cog_incoming_by_type);
+	INST("cog-incoming-set",       cog_incoming_set);
+	INST("cog-keys->alist",        cog_keys_alist);
+	INST("cog-link",               cog_link);
+	INST("cog-node",               cog_node);
+	INST("cog-value",              cog_value);
+
+	INST("cog-extract!",           cog_extract);
+	INST("cog-extract-recursive!", cog_extract_recursive);
+	INST("cog-set-value!",         cog_set_value);
+	INST("cog-set-values!",        cog_set_values);
+	INST("cog-set-tv!",            cog_set_tv);
+	INST("cog-update-value!",      cog_update_value);
+
+#undef INST
+}
+
+// ------------------------------------------------------------------
+// Reads. These are called before the read is done.
+
+void SexprCommands::get_atoms_cb(Type t, bool subtypes)
+{
+	if (_rt) _rt->fetch_type(t, subtypes);
+}
+
+void SexprCommands::incoming_set_cb(const Handle& h)
+{
+	if (_rt) _rt->fetch_incoming(h, NOTYPE);
+	if (_hot) _hot->sample(h);
+}
+
+void SexprCommands::incoming_by_type_cb(const Handle& h, Type t)
+{
+	if (_rt) _rt->fetch_incoming(h, t);
+	if (_hot) _hot->sample(h);
+}
+
+void SexprCommands::keys_alist_cb(const Handle& h)
+{
+	if (_rt) _rt->fetch_atom(h);
+	if (_hot) _hot->sample(h);
+}
+
+void SexprCommands::node_cb(const Handle& h)
+{
+	if (_rt) _rt->fetch_atom(h);
+	if (_hot) _hot->sample(h);
+}
+
+void SexprCommands::link_cb(const Handle& h)
+{
+	if (_rt) _rt->fetch_atom(h);
+	if (_hot) _hot->sample(h);
+}
+
+void SexprCommands::value_cb(const Handle& atom, const Handle& key)
+{
+	if (_rt) _rt->fetch_value(atom, key);
+	if (_hot) _hot->sample(atom, key);
+}
+
+// ------------------------------------------------------------------
+// Writes. The callbacks only take notes; publish() looks at the
+// AtomSpace once the command is done.
+
+void SexprCommands::extract_cb(const Handle& h, bool recursive)
+{
+	if (_hot) _hot->sample(h);
+	_extracted.push_back(h);
+}
+
+void SexprCommands::set_value_cb(const Handle& atom, const Handle& key,
+                                 const ValuePtr& v)
+{
+	if (_hot) _hot->sample(atom, key);
+	_changed.push_back({atom, key});
+}
+
+void SexprCommands::set_values_cb(const Handle& atom)
+{
+	if (_hot) _hot->sample(atom);
+	_added.push_back(atom);
+}
+
+void SexprCommands::set_tv_cb(const Handle& atom, const TruthValuePtr& tv)
+{
+	// The truth value is kept under a well-known key.
+	if (nullptr == _truth_key)
+		_truth_key = _as->add_node(PREDICATE_NODE, "*-TruthValueKey-*");
+	if (_hot) _hot->sample(atom, _truth_key);
+	_changed.push_back({atom, _truth_key});
+}
+
+void SexprCommands::update_value_cb(const Handle& atom, const Handle& key,
+                                    const ValuePtr& delta)
+{
+	if (_hot) _hot->sample(atom, key);
+	_changed.push_back({atom, key});
+}
+
+// ------------------------------------------------------------------
+
+void SexprCommands::publish(ChangeFeed& feed)
+{
+	HandleSeq extracted, added;
+	std::vector<std::pair<Handle, Handle>> changed;
+	extracted.swap(_extracted);
+	added.swap(_added);
+	changed.swap(_changed);
+	if (not feed.active()) return;
+
+	// A recursive extract is published as one event.
+	for (const Handle& h : extracted)
+		if (nullptr == _as->get_atom(h)) feed.atom_removed(h);
+
+	// The callback does not say which values were given; send them all.
+	for (const Handle& a : added)
+	{
+		Handle h(_as->get_atom(a));
+		if (nullptr == h) continue;
+		feed.atom_added(h);
+		for (const Handle& key : h->getKeys())
+			feed.value_changed(h, key, h->getValue(key));
+	}
+
+	for (const auto& ch : changed)
+	{
+		Handle h(_as->get_atom(ch.first));
+		if (nullptr == h) continue;
+		feed.value_changed(h, ch.second, h->getValue(ch.second));
+	}
+}
+
+/* ===================== END OF FILE ======================== */
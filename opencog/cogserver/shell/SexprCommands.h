@@ -0,0 +1,95 @@
+/*
+ * opencog/cogserver/shell/SexprCommands.h
+ *
+ * Command hooks for the s-expression shell.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_SEXPR_COMMANDS_H
+#define _OPENCOG_SEXPR_COMMANDS_H
+
+#include <utility>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/persist/sexcom/Commands.h>
+#include <opencog/persist/sexcom/SexprEval.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+class AccessSampler;
+class ChangeFeed;
+class ReadThrough;
+
+/**
+ * Handlers for the SexprEval commands that read or change atoms.
+ * The commands are decoded and run by the AtomSpace's own Commands
+ * class, as they would be without the hooks.
+ *
+ * Before a read, the ReadThrough, if any, is asked to fetch what is
+ * about to be read. Each atom and key used is handed to the
+ * AccessSampler, if any.
+ *
+ * For the commands that change the AtomSpace, the callbacks also
+ * note which atoms and keys were touched. After the command, publish()
+ * tells the ChangeFeed what changed, using the AtomSpace as it is
+ * by then: an extracted atom is published as removed only if it
+ * is gone, and a value with whatever it holds now.
+ *
+ * Atoms given on their own, without a command around them, are
+ * added by the SexprEval without a callback, and are not published.
+ * Clients that need them seen elsewhere should set a value on them;
+ * a value change carries its atom with it.
+ */
+class SexprCommands : public UnwrappedCommands
+{
+	private:
+		AtomSpacePtr _as;
+		AccessSampler* _hot;
+		ReadThrough* _rt;
+		Handle _truth_key;
+		Commands _decoder;
+
+		// Touched by the current command.
+		HandleSeq _extracted;
+		HandleSeq _added;
+		std::vector<std::pair<Handle, Handle>> _changed;
+
+	protected:
+		virtual void get_atoms_cb(Type, bool);
+		virtual void incoming_set_cb(const Handle&);
+		virtual void incoming_by_type_cb(const Handle&, Type);
+		virtual void keys_alist_cb(const Handle&);
+		virtual void node_cb(const Handle&);
+		virtual void link_cb(const Handle&);
+		virtual void value_cb(const Handle&, const Handle&);
+
+		virtual void extract_cb(const Handle&, bool);
+		virtual void set_value_cb(const Handle&, const Handle&,
+		                          const ValuePtr&);
+		virtual void set_values_cb(const Handle&);
+		virtual void set_tv_cb(const Handle&, const TruthValuePtr&);
+		virtual void update_value_cb(const Handle&, const Handle&,
+		                             const ValuePtr&);
+
+	public:
+		SexprCommands(const AtomSpacePtr&, AccessSampler*, ReadThrough*);
+		virtual ~SexprCommands();
+
+		/// Take over the commands that read or change atoms.
+		void install(SexprEval*);
+
+		/// Publish what the last command changed, and forget it.
+		/// Throws if the write-ahead log has failed.
+		void publish(ChangeFeed&);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_SEXPR_COMMANDS_H
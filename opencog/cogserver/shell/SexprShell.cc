@@ -20,7 +20,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <opencog/util/exceptions.h>
 #include <opencog/persist/sexcom/SexprEval.h>
+#include <opencog/atoms/base/Atom.h>
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/cogserver/server/CogServer.h>
 
@@ -28,7 +30,8 @@
 
 using namespace opencog;
 
-SexprShell::SexprShell(void)
+SexprShell::SexprShell(void) :
+	_want_snapshot(false)
 {
 	normal_prompt = "";
 	abort_prompt = "";
@@ -40,11 +43,37 @@ SexprShell::SexprShell(void)
 
 SexprShell::~SexprShell()
 {
+	// The batch evaluator is ours; the eval thread must be done
+	// with it before it goes.
+	while_not_done();
+	join_eval();
 }
 
+/// The thread's SexprEval, wrapped so that the client can batch
+/// its writes with `begin` and `commit`. The commands that change
+/// the AtomSpace are hooked, so that each change is published before
+/// the reply goes out. A snapshot is read-only, so nothing in it
+/// changes.
 GenericEval* SexprShell::get_evaluator(void)
 {
-	return SexprEval::get_evaluator(cogserver().getAtomSpace());
+	if (_want_snapshot)
+		_snapshot = cogserver().readSnapshot();
+	if (_snapshot)
+	{
+		_batch.reset(new SexprBatchEval(
+			SexprEval::get_evaluator(_snapshot), nullptr));
+		return _batch.get();
+	}
+
+	const AtomSpacePtr& as = cogserver().getAtomSpace();
+	SexprEval* sev = SexprEval::get_evaluator(as);
+	_commands.reset(new SexprCommands(as, &cogserver().accessSampler(),
+	                                  &cogserver().readThrough()));
+	_commands->install(sev);
+
+	_batch.reset(new SexprBatchEval(sev,
+		[this]() { _commands->publish(cogserver().changeFeed()); }));
+	return _batch.get();
 }
 
 /* ===================== END OF FILE ============================ */
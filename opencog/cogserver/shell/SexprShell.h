@@ -23,7 +23,12 @@
 #ifndef _OPENCOG_SEXPR_SHELL_H
 #define _OPENCOG_SEXPR_SHELL_H
 
+#include <memory>
+
+#include <opencog/atomspace/AtomSpace.h>
 #include <opencog/network/GenericShell.h>
+#include "SexprBatchEval.h"
+#include "SexprCommands.h"
 
 namespace opencog {
 /** \addtogroup grp_server
@@ -32,10 +37,26 @@ namespace opencog {
 
 class SexprShell : public GenericShell
 {
+	private:
+		// A read-only snapshot, or null, for the server AtomSpace.
+		// Taken in the eval thread, if wanted.
+		bool _want_snapshot;
+		AtomSpacePtr _snapshot;
+
+		// Created in the eval thread; see get_evaluator().
+		std::unique_ptr<SexprCommands> _commands;
+		std::unique_ptr<SexprBatchEval> _batch;
+
 	public:
 		SexprShell(void);
 		virtual ~SexprShell();
 		virtual GenericEval* get_evaluator(void);
+
+		/// Evaluate in a read snapshot, instead of the server
+		/// AtomSpace. Must be called before the shell is given its
+		/// socket; the copy is made in the eval thread, so as not to
+		/// hold up the server loop.
+		void use_snapshot(void) { _want_snapshot = true; }
 };
 
 /** @}*/
@@ -49,7 +49,8 @@ void SexprShellModule::init(void)
 
 SexprShellModule::~SexprShellModule()
 {
-	_cogserver.unregisterRequest(shelloutRequest::info().id);
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
 }
 
 // This is currently unused.
@@ -81,7 +82,7 @@ SexprShellModule::shelloutRequest::info(void)
 {
 	static const RequestClassInfo _cci("sexpr",
 		"Enter the s-expression shell",
-		"Usage: sexpr\n\n"
+		"Usage: sexpr [snapshot]\n\n"
 		"Enter the s-expression interpreter shell. This shell provides\n"
 		"a very minimal s-expression shell, with just enough commands\n"
 		"to interpret Atomese strings and move Atoms and Values between\n"
@@ -92,6 +93,13 @@ SexprShellModule::shelloutRequest::info(void)
 		"https://github.com/opencog/atomspace/tree/master/opencog/persist/sexpr/Commands.cc\n"
 		"See that file for details. Example usage: `(cog-get-atoms 'Node #t)`\n"
 		"will return a list of all Nodes in the AtomSpace.\n\n"
+		"Writes can be batched: after a line holding just `begin`, commands\n"
+		"are buffered, without reply, until a line holding `commit`, when\n"
+		"they are all run at once, or `abort`, when they are dropped.\n\n"
+		"If 'snapshot' is specified, the shell works on a read-only copy\n"
+		"of the AtomSpace, taken when the shell is entered. It does not\n"
+		"see changes made after that, so that long reads see the same\n"
+		"data from beginning to end.\n\n"
 		"Use either a ^D (ctrl-D) or a single . on a line by itself to exit\n"
 		"the shell.\n\n",
 		true, false);
@@ -108,6 +116,9 @@ SexprShellModule::shelloutRequest::execute(void)
 	OC_ASSERT(con, "Invalid Request object");
 
 	SexprShell *sh = new SexprShell();
+	for (const std::string& arg : _parameters)
+		if (arg == "snapshot")
+			sh->use_snapshot();
 
 #ifdef DEAD_CODE
 	// We don't do this, need this any more. Its here as
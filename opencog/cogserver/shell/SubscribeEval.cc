@@ -0,0 +1,164 @@
+/*
+ * opencog/cogserver/shell/SubscribeEval.cc
+ *
+ * Evaluator for AtomSpace change-feed subscriptions.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/atom_types/NameServer.h>
+#include <opencog/persist/sexpr/Sexpr.h>
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "SubscribeEval.h"
+
+using namespace opencog;
+
+SubscribeEval::SubscribeEval(const AtomSpacePtr& asp) :
+	GenericEval(),
+	_atomspace(asp),
+	_running(false)
+{
+	_subscriber = cogserver().changeFeed().subscribe();
+}
+
+SubscribeEval::~SubscribeEval()
+{
+	cogserver().changeFeed().unsubscribe(_subscriber);
+}
+
+/* ============================================================== */
+
+static const char* help_text =
+	"Available commands:\n"
+	"  all                     Subscribe to every change.\n"
+	"  type <Type> [subtypes]  Changes to atoms of the given type.\n"
+	"  key <atom>              Value changes under the given key.\n"
+	"  root <atom>             Changes to the atom, or to links holding it.\n"
+	"  clear                   Remove all subscriptions.\n"
+	"  list                    Show the current subscriptions.\n";
+
+/// Run one command; return the reply.
+std::string SubscribeEval::cmd(const std::string& line)
+{
+	size_t beg = line.find_first_not_of(" \t\r\n");
+	if (std::string::npos == beg) return "";
+	size_t end = line.find_first_of(" \t\r\n", beg);
+	std::string verb(line.substr(beg, end - beg));
+	std::string arg;
+	if (std::string::npos != end)
+	{
+		size_t ab = line.find_first_not_of(" \t\r\n", end);
+		size_t ae = line.find_last_not_of(" \t\r\n");
+		if (std::string::npos != ab) arg = line.substr(ab, ae - ab + 1);
+	}
+
+	if (verb == "all")
+	{
+		_subscriber->add_all();
+		return "ok\n";
+	}
+	if (verb == "type")
+	{
+		size_t sp = arg.find_first_of(" \t");
+		std::string tname(arg.substr(0, sp));
+		bool subtypes = std::string::npos != sp and
+			std::string::npos != arg.find("subtypes", sp);
+		Type t = nameserver().getType(tname);
+		if (NOTYPE == t)
+			throw InvalidParamException(TRACE_INFO,
+				"Unknown type: \"%s\"", tname.c_str());
+		_subscriber->add_type(t, subtypes);
+		return "ok\n";
+	}
+	if (verb == "key" or verb == "root")
+	{
+		if (0 == arg.size())
+			throw InvalidParamException(TRACE_INFO,
+				"Expecting an atom, e.g. (Predicate \"foo\")");
+
+		// Add the atom, so that it is the same one that the
+		// AtomSpace will hand out, when it is used later.
+		Handle h(_atomspace->add_atom(Sexpr::decode_atom(arg)));
+		if (verb == "key") _subscriber->add_key(h);
+		else _subscriber->add_root(h);
+		return "ok\n";
+	}
+	if (verb == "clear")
+	{
+		_subscriber->clear_filters();
+		return "ok\n";
+	}
+	if (verb == "list")
+		return _subscriber->describe();
+	if (verb == "help")
+		return help_text;
+
+	throw InvalidParamException(TRACE_INFO,
+		"Unknown command \"%s\"; try `help`", verb.c_str());
+}
+
+void SubscribeEval::begin_eval(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_running = true;
+	_caught_error = false;
+}
+
+void SubscribeEval::eval_expr(const std::string& expr)
+{
+	std::string reply;
+	try
+	{
+		reply = cmd(expr);
+	}
+	catch (const std::exception& ex)
+	{
+		reply = std::string("Error: ") + ex.what() + "\n";
+		_caught_error = true;
+	}
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_reply += reply;
+	_running = false;
+	_cv.notify_all();
+}
+
+/// The shell polls this about a hundred times a second, whether or
+/// not a command is running; that is what delivers the events.
+std::string SubscribeEval::poll_result(void)
+{
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (_running) _cv.wait(lck);
+
+	std::string rv;
+	rv.swap(_reply);
+	lck.unlock();
+
+	return rv + _subscriber->drain();
+}
+
+void SubscribeEval::interrupt(void)
+{
+	// Commands are short, and run to completion.
+	_caught_error = true;
+}
+
+// One evaluator per thread, and so one subscription per connection.
+SubscribeEval* SubscribeEval::get_evaluator(const AtomSpacePtr& asp)
+{
+	static thread_local SubscribeEval* evaluator = new SubscribeEval(asp);
+
+	// The eval_dtor runs when this thread is destroyed.
+	class eval_dtor {
+		public:
+		~eval_dtor() { delete evaluator; }
+	};
+	static thread_local eval_dtor killer;
+
+	return evaluator;
+}
+
+/* ===================== END OF FILE ======================== */
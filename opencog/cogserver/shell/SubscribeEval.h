@@ -0,0 +1,72 @@
+/*
+ * opencog/cogserver/shell/SubscribeEval.h
+ *
+ * Evaluator for AtomSpace change-feed subscriptions.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_SUBSCRIBE_EVAL_H
+#define _OPENCOG_SUBSCRIBE_EVAL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/eval/GenericEval.h>
+#include <opencog/cogserver/server/ChangeFeed.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * Evaluator for the SubscribeShell. Each evaluator holds one
+ * subscription to the cogserver ChangeFeed. The input lines edit
+ * the filters of that subscription:
+ *
+ *   all                    -- every change
+ *   type <Type> [subtypes] -- changes to atoms of this type
+ *   key <atom>             -- value changes under this key
+ *   root <atom>            -- changes to this atom, or to any link
+ *                             that contains it, at any depth
+ *   clear                  -- remove all filters
+ *   list                   -- print the current filters
+ *
+ * The atoms are given as s-expressions, e.g. `(Predicate "foo")`.
+ * Matching events are returned from poll_result(), one per line,
+ * as the shell polls for output.
+ */
+class SubscribeEval : public GenericEval
+{
+	private:
+		AtomSpacePtr _atomspace;
+		ChangeFeed::SubscriberPtr _subscriber;
+
+		std::mutex _mtx;
+		std::condition_variable _cv;
+		bool _running;
+		std::string _reply;
+
+		std::string cmd(const std::string&);
+
+		SubscribeEval(const AtomSpacePtr&);
+
+	public:
+		virtual ~SubscribeEval();
+
+		virtual void begin_eval(void);
+		virtual void eval_expr(const std::string&);
+		virtual std::string poll_result(void);
+		virtual void interrupt(void);
+
+		static SubscribeEval* get_evaluator(const AtomSpacePtr&);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_SUBSCRIBE_EVAL_H
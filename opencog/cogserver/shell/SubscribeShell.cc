@@ -0,0 +1,37 @@
+/*
+ * opencog/cogserver/shell/SubscribeShell.cc
+ *
+ * Shell for AtomSpace change-feed subscriptions.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/cogserver/server/CogServer.h>
+
+#include "SubscribeEval.h"
+#include "SubscribeShell.h"
+
+using namespace opencog;
+
+SubscribeShell::SubscribeShell(void)
+{
+	// No prompts; they would be interleaved with the events.
+	normal_prompt = "";
+	abort_prompt = "";
+	pending_prompt = "";
+
+	show_prompt = false;
+	_name = "subs";
+}
+
+SubscribeShell::~SubscribeShell()
+{
+}
+
+GenericEval* SubscribeShell::get_evaluator(void)
+{
+	return SubscribeEval::get_evaluator(cogserver().getAtomSpace());
+}
+
+/* ===================== END OF FILE ============================ */
@@ -0,0 +1,35 @@
+/*
+ * opencog/cogserver/shell/SubscribeShell.h
+ *
+ * Shell for AtomSpace change-feed subscriptions.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#ifndef _OPENCOG_SUBSCRIBE_SHELL_H
+#define _OPENCOG_SUBSCRIBE_SHELL_H
+
+#include <opencog/network/GenericShell.h>
+
+namespace opencog {
+/** \addtogroup grp_server
+ *  @{
+ */
+
+/**
+ * A shell that streams AtomSpace changes to the client, as they
+ * happen. See SubscribeEval for the commands.
+ */
+class SubscribeShell : public GenericShell
+{
+	public:
+		SubscribeShell(void);
+		virtual ~SubscribeShell();
+		virtual GenericEval* get_evaluator(void);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_SUBSCRIBE_SHELL_H
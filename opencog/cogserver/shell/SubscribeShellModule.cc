@@ -0,0 +1,90 @@
+/*
+ * opencog/cogserver/shell/SubscribeShellModule.cc
+ *
+ * Shell for AtomSpace change-feed subscriptions.
+ * Copyright (c) 2026 OpenCog Foundation
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/util/Logger.h>
+#include <opencog/util/oc_assert.h>
+
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+#include <opencog/cogserver/server/Request.h>
+#include <opencog/network/ConsoleSocket.h>
+
+#include "SubscribeShell.h"
+#include "ShellModule.h"
+
+using namespace opencog;
+
+DEFINE_SHELL_MODULE(SubscribeShellModule);
+DECLARE_MODULE(SubscribeShellModule);
+
+SubscribeShellModule::SubscribeShellModule(CogServer& cs) : Module(cs)
+{
+}
+
+void SubscribeShellModule::init(void)
+{
+	_cogserver.registerRequest(shelloutRequest::info().id,
+	                           &shelloutFactory);
+}
+
+SubscribeShellModule::~SubscribeShellModule()
+{
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
+}
+
+bool SubscribeShellModule::config(const char*)
+{
+	return false;
+}
+
+const RequestClassInfo&
+SubscribeShellModule::shelloutRequest::info(void)
+{
+	static const RequestClassInfo _cci("subscribe",
+		"Enter the AtomSpace change-feed shell",
+		"Usage: subscribe\n\n"
+		"Enter the change-feed shell. Changes made to the AtomSpace\n"
+		"are sent to the client as they happen, one per line:\n"
+		"    (atom-added <atom>)\n"
+		"    (atom-removed <atom>)\n"
+		"    (value-changed <atom> <key> <value>)\n"
+		"Only changes that match one of the subscriptions are sent.\n"
+		"The subscriptions are set up with these commands:\n"
+		"    all                     -- every change\n"
+		"    type <Type> [subtypes]  -- atoms of the given type\n"
+		"    key <atom>              -- value changes under this key\n"
+		"    root <atom>             -- the atom, or links holding it\n"
+		"    clear                   -- remove all subscriptions\n"
+		"    list                    -- show the current subscriptions\n"
+		"A client that does not keep up will miss events; this is\n"
+		"reported with a `(dropped <count>)` line. The queue size is\n"
+		"set with SUBSCRIBE_QUEUE_MAX in the config file.\n\n"
+		"Changes made through the binary shell and the `ingest` command\n"
+		"are reported. Available over WebSockets, at /subscribe.\n",
+		true, false);
+	return _cci;
+}
+
+/**
+ * Register this shell with the console.
+ */
+bool
+SubscribeShellModule::shelloutRequest::execute(void)
+{
+	ConsoleSocket *con = this->get_console();
+	OC_ASSERT(con, "Invalid Request object");
+
+	SubscribeShell *sh = new SubscribeShell();
+	sh->set_socket(con);
+	send("");
+	return true;
+}
+
+/* ===================== END OF FILE ============================ */
@@ -47,7 +47,8 @@ void TopShellModule::init(void)
 
 TopShellModule::~TopShellModule()
 {
-	_cogserver.unregisterRequest(shelloutRequest::info().id);
+	_cogserver.unregisterRequest(shelloutRequest::info().id,
+	                             &shelloutFactory);
 }
 
 bool TopShellModule::config(const char*)
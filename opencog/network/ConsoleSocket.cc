@@ -52,6 +52,7 @@ ConsoleSocket::~ConsoleSocket()
 void ConsoleSocket::SetShell(GenericShell *g)
 {
     _shell = g;
+    set_binary_io(g and g->binary_io());
 
 	// Push out a new prompt, when the shell closes.
 	if (nullptr == g) OnLine("");
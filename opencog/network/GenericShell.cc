@@ -24,6 +24,7 @@
 
 #include <chrono>
 #include <mutex>
+#include <shared_mutex>
 #include <thread>
 
 #include <opencog/util/Logger.h>
@@ -66,6 +67,9 @@ using namespace opencog;
 #define CAN 0x18  // cancel or ^X at keyboard.
 #define ESC 0x1b  // ecsape or ^[ at keyboard.
 
+std::atomic_size_t GenericShell::_num_evaluating(0);
+std::shared_timed_mutex GenericShell::_eval_barrier;
+
 GenericShell::GenericShell(void) :
     socket(nullptr),
     evalthr(nullptr),
@@ -78,12 +82,23 @@ GenericShell::GenericShell(void) :
     show_prompt(true),
     self_destruct(false),
     apply_discipline(true),
+    binary_frames(false),
     _eval_done(true),
     _evaluator(nullptr),
     _name("gnrc")
 {}
 
 GenericShell::~GenericShell()
+{
+	join_eval();
+	logger().debug("[GenericShell] dtor finished.");
+}
+
+/// Stop accepting input, finish whatever is queued, and wait for the
+/// evaluator thread to exit. Derived classes that need to reclaim the
+/// evaluator may call this from their own dtor; it's safe to call
+/// more than once.
+void GenericShell::join_eval(void)
 {
 	self_destruct = true;
 
@@ -101,7 +116,6 @@ GenericShell::~GenericShell()
 		delete evalthr;
 		evalthr = nullptr;
 	}
-	logger().debug("[GenericShell] dtor finished.");
 }
 
 /* ============================================================== */
@@ -472,6 +486,7 @@ void GenericShell::start_eval()
 	OC_ASSERT(_eval_done, "Bad evaluator flag state!");
 	std::unique_lock<std::mutex> lck(_eval_mtx);
 	_eval_done = false;
+	_num_evaluating++;
 }
 
 void GenericShell::finish_eval()
@@ -479,6 +494,7 @@ void GenericShell::finish_eval()
 	{
 		// Repeated control-C will send us here with _eval_done already set..
 		std::unique_lock<std::mutex> lck(_eval_mtx);
+		if (not _eval_done) _num_evaluating--;
 		_eval_done = true;
 		_eval_cv.notify_all();
 	}
@@ -535,14 +551,19 @@ void GenericShell::eval_loop(void)
 
 			wake_poll();
 			start_eval();
-			_evaluator->begin_eval();
-			_evaluator->eval_expr(in);
+			{
+				std::shared_lock<std::shared_timed_mutex> lck(_eval_barrier);
+				_evaluator->begin_eval();
+				_evaluator->eval_expr(in);
+				after_eval(in);
+			}
 			wake_poll();
 		}
 		catch (const RuntimeException& ex)
 		{
 			/* Python throws these on user syntax errors.*/
 			/* Python sometimes deadlocks. Don't know why. */
+			if (not _eval_done) _num_evaluating--;
 			_eval_done = true;
 			_poll_mtx.unlock();
 		}
@@ -590,8 +611,10 @@ void GenericShell::eval_loop(void)
 
 		logger().debug("[GenericShell] finishing; eval of '%s'", in.c_str());
 		start_eval();
+		std::shared_lock<std::shared_timed_mutex> lck(_eval_barrier);
 		_evaluator->begin_eval();
 		_evaluator->eval_expr(in);
+		after_eval(in);
 	}
 
 	// Continue polling until the evaluation really is done.
@@ -671,6 +694,16 @@ void GenericShell::thread_init(void)
 	/* No-op. The Scheme shell sets the current atomspace here */
 }
 
+/// Called in the eval thread, after eval_expr() returns. Only useful
+/// for evaluators that finish their work within eval_expr(). Note that
+/// the poll thread may already have sent the reply by then; work that
+/// the client must be able to count on once it has the reply belongs
+/// in the evaluator.
+void GenericShell::after_eval(const std::string& expr)
+{
+	/* No-op. */
+}
+
 /* ============================================================== */
 
 void GenericShell::put_output(const std::string& s)
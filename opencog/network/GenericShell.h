@@ -23,8 +23,10 @@
 #ifndef _OPENCOG_GENERIC_SHELL_H
 #define _OPENCOG_GENERIC_SHELL_H
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <thread>
 
@@ -61,10 +63,14 @@ class GenericShell
 		ConsoleSocket* socket;
 		std::thread* evalthr;
 		std::thread* pollthr;
-		concurrent_queue<std::string> evalque;
 		volatile bool _init_done;
 
+		static std::atomic_size_t _num_evaluating;
+		static std::shared_timed_mutex _eval_barrier;
+
 	protected:
+		concurrent_queue<std::string> evalque;
+
 		std::string abort_prompt;
 		std::string normal_prompt;
 		std::string pending_prompt;
@@ -72,9 +78,11 @@ class GenericShell
 		bool show_prompt;
 		volatile bool self_destruct;
 		bool apply_discipline;
+		bool binary_frames;
 
 		virtual GenericEval* get_evaluator(void) = 0;
 		virtual void thread_init(void);
+		virtual void after_eval(const std::string &expr);
 		virtual void line_discipline(const std::string &expr);
 
 		// Concurrency handling
@@ -92,6 +100,7 @@ class GenericShell
 		void start_eval();
 		void finish_eval();
 		void while_not_done();
+		void join_eval();
 
 		virtual void user_interrupt();
 
@@ -112,11 +121,26 @@ class GenericShell
 		virtual void hush_prompt(bool);
 		virtual void discipline(bool);
 
+		/** True if the socket should deliver length-prefixed binary
+		 *  frames to this shell, instead of lines of text. */
+		bool binary_io(void) const { return binary_frames; }
+
 		// Monitor statistics
 		const char* _name;
 		bool eval_done() const { return _eval_done; }
 		size_t pending() const { return _pending_output.size(); }
 		size_t queued() const { return evalque.size(); }
+
+		/** Number of shells, in total, that are running an evaluation
+		 *  right now. Used to find idle periods. */
+		static size_t num_evaluating() { return _num_evaluating; }
+
+		/** Held, shared, by every shell while it evaluates. Locking
+		 *  it exclusively waits for the evaluations in progress to
+		 *  finish, and holds off new ones, so that nothing is inside
+		 *  the AtomSpace; other threads that write to the AtomSpace
+		 *  hold it, shared, too. */
+		static std::shared_timed_mutex& eval_barrier() { return _eval_barrier; }
 };
 
 /** @}*/
@@ -25,14 +25,30 @@
 
 using namespace opencog;
 
+bool NetworkServer::_share_port = false;
+
+typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>
+    reuse_port;
+
 NetworkServer::NetworkServer(unsigned short port, const char* name) :
     _name(name),
     _port(port),
     _running(false),
-    _acceptor(_io_service,
-        boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port))
+    _acceptor(_io_service)
 {
     logger().debug("[NetworkServer] constructor for %s at %d", name, port);
+
+    // Same as the endpoint constructor does, with SO_REUSEPORT added,
+    // if asked for, so that several processes can listen on the port,
+    // and the kernel spreads the connections among them.
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+    _acceptor.open(endpoint.protocol());
+    _acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+    if (_share_port)
+        _acceptor.set_option(reuse_port(true));
+    _acceptor.bind(endpoint);
+    _acceptor.listen();
+
     _start_time = time(nullptr);
     _last_connect = 0;
     _nconnections = 0;
@@ -57,6 +57,8 @@ protected:
     time_t _last_connect;
     size_t _nconnections;
 
+    static bool _share_port;
+
 public:
 
     /**
@@ -72,6 +74,10 @@ public:
 
     /** Print network stats in human-readable tabular form */
     std::string display_stats(void);
+
+    /** Let servers constructed afterwards share their port with
+     *  other processes (SO_REUSEPORT). Used by pre-forked workers. */
+    static void share_port(bool share) { _share_port = share; }
 }; // class
 
 /** @}*/
@@ -7,12 +7,19 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <errno.h>
+#include <string.h>
 #include <sys/prctl.h>
+#include <sys/sendfile.h>
 #include <sys/types.h>
 #include <time.h>
 #include <mutex>
 #include <set>
 
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 #include <opencog/util/exceptions.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
@@ -20,6 +27,49 @@
 
 using namespace opencog;
 
+#ifdef HAVE_ZSTD
+// Compression state of one connection; see ServerSocket::compress().
+struct ServerSocket::Zstd
+{
+    int level;
+    ZSTD_CCtx* cctx;
+    ZSTD_DCtx* dctx;
+
+    // Output of the compressor, used with _send_mtx held, and of
+    // the decompressor, used by the reading thread only.
+    std::string obuf;
+    std::string dbuf;
+
+    // Compressed input not yet decompressed, and how far into it.
+    std::string raw;
+    size_t rpos;
+    bool reading;
+
+    std::atomic_size_t in_raw;
+    std::atomic_size_t in_wire;
+    std::atomic_size_t out_raw;
+    std::atomic_size_t out_wire;
+
+    Zstd(int lvl) : level(lvl), rpos(0), reading(false),
+        in_raw(0), in_wire(0), out_raw(0), out_wire(0)
+    {
+        cctx = ZSTD_createCCtx();
+        dctx = ZSTD_createDCtx();
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+        obuf.resize(ZSTD_CStreamOutSize());
+        dbuf.resize(ZSTD_DStreamOutSize());
+    }
+    ~Zstd()
+    {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+#else
+struct ServerSocket::Zstd {};
+#endif // HAVE_ZSTD
+
 // ==================================================================
 // Infrastrucure for printing connection stats
 //
@@ -78,6 +128,10 @@ std::string ServerSocket::display_stats(void)
         rc += ss->connection_stats() + "\n";
     }
 
+    // Compression, for the connections that asked for it.
+    for (ServerSocket* ss : sov)
+        if (ss->_zstd) rc += ss->zstd_stats();
+
     return rc;
 }
 
@@ -140,7 +194,7 @@ std::string ServerSocket::connection_stats(void)
     char bf[132];
     snprintf(bf, 132, "%s %8d %s %5zd %s %c",
         sbuff, _tid, _status, _line_count, abuff,
-        _is_websocket?'W':'T');
+        _is_websocket?'W':(_zstd?'Z':'T'));
 
     return bf;
 }
@@ -191,9 +245,13 @@ bool ServerSocket::_network_gone = false;
 
 ServerSocket::ServerSocket(void) :
     _socket(nullptr),
+    _do_binary_io(false),
+    _zstd(nullptr),
     _got_first_line(false),
     _got_http_header(false),
     _do_frame_io(false),
+    _ws_binary(false),
+    _ws_binary_frame(false),
     _is_websocket(false),
     _got_websock_header(false)
 {
@@ -241,6 +299,7 @@ ServerSocket::~ServerSocket()
 
     _socket = nullptr;
     rem_sock(this);
+    delete _zstd;
 
     // If anyone is waiting for a socket, let them know that
     // we've freed one up.
@@ -263,8 +322,16 @@ void ServerSocket::Send(const std::string& cmd)
     // no particular reason.  Due to old confusions about line
     // discipline. Just avoid them. The only place this might
     // matter would be python, and the "obvious" solution is to
-    // use two newlines, or a crlf.
-    if (1 == cmdsize and '\n' == cmd[0]) return;
+    // use two newlines, or a crlf. Binary replies are never
+    // filtered; a single 0x0a byte is a valid MessagePack reply.
+    if (1 == cmdsize and '\n' == cmd[0] and not _ws_binary) return;
+
+    std::lock_guard<std::mutex> lck(_send_mtx);
+    if (_zstd)
+    {
+        zstd_send(cmd.c_str(), cmdsize);
+        return;
+    }
 
     if (not _do_frame_io)
     {
@@ -299,6 +366,45 @@ void ServerSocket::Send(const boost::asio::const_buffer& buf)
              error.message().c_str(), pthread_self());
 }
 
+bool ServerSocket::SendFile(int fd, size_t len)
+{
+    OC_ASSERT(_socket, "Use of socket after it's been closed!\n");
+    std::lock_guard<std::mutex> lck(_send_mtx);
+
+    // Compressed data has to come up into user space after all.
+    if (_zstd)
+    {
+        std::string buf(65536, 0);
+        while (0 < len)
+        {
+            ssize_t got = read(fd, &buf[0], std::min(len, buf.size()));
+            if (got < 0 and EINTR == errno) continue;
+            if (got <= 0) return false;
+            zstd_send(buf.c_str(), got);
+            len -= got;
+        }
+        return true;
+    }
+
+    // The kernel copies from the page cache straight to the socket;
+    // the data never comes up into user space.
+    int sock = _socket->native_handle();
+    while (0 < len)
+    {
+        ssize_t sent = sendfile(sock, fd, nullptr, len);
+        if (sent < 0 and (EINTR == errno or EAGAIN == errno)) continue;
+        if (sent <= 0)
+        {
+            if (sent < 0 and EPIPE != errno and ECONNRESET != errno)
+                logger().warn("ServerSocket::SendFile(): %s on thread 0x%x\n",
+                     strerror(errno), pthread_self());
+            return false;
+        }
+        len -= sent;
+    }
+    return true;
+}
+
 // As far as I can tell, boost::asio is not actually thread-safe,
 // in particular, when closing and destroying sockets.  This strikes
 // me as incredibly stupid -- a first-class reason to not use boost.
@@ -404,13 +510,200 @@ match_eol_or_escape(bitter begin, bitter end)
 /// Return immediately if a ctrl-C or ctrl-D is found.
 std::string ServerSocket::get_telnet_line(boost::asio::streambuf& b)
 {
-    boost::asio::read_until(*_socket, b, match_eol_or_escape);
+    if (_zstd)
+    {
+        // Compressed clients are programs; there are no telnet
+        // escapes to look for.
+        while (true)
+        {
+            auto data = b.data();
+            auto end = boost::asio::buffers_end(data);
+            if (end != std::find(boost::asio::buffers_begin(data), end, '\n'))
+                break;
+            zstd_fill(b);
+        }
+    }
+    else
+        boost::asio::read_until(*_socket, b, match_eol_or_escape);
     std::istream is(&b);
     std::string line;
     std::getline(is, line);
     return line;
 }
 
+// Largest binary frame we are willing to buffer. Anything bigger
+// is almost surely a client speaking some other protocol.
+#define MAX_BINARY_FRAME (256*1024*1024)
+
+/// Read a single length-prefixed frame from the socket: a four-byte
+/// little-endian byte count, followed by that many bytes of data.
+std::string ServerSocket::get_binary_frame(boost::asio::streambuf& b)
+{
+    fill(b, 4);
+
+    std::istream is(&b);
+    unsigned char hdr[4];
+    is.read((char*) hdr, 4);
+    size_t len = hdr[0] | (hdr[1] << 8) | (hdr[2] << 16) |
+        ((size_t) hdr[3] << 24);
+
+    if (MAX_BINARY_FRAME < len)
+    {
+        logger().warn("ServerSocket::get_binary_frame(): "
+            "frame of %zu bytes is too large; closing connection", len);
+        throw SilentException();
+    }
+
+    fill(b, len);
+
+    std::string frame(len, 0);
+    is.read(&frame[0], len);
+    return frame;
+}
+
+void ServerSocket::fill(boost::asio::streambuf& b, size_t len)
+{
+    if (len <= b.size()) return;
+    if (not _zstd)
+    {
+        boost::asio::read(*_socket, b,
+            boost::asio::transfer_exactly(len - b.size()));
+        return;
+    }
+    while (b.size() < len) zstd_fill(b);
+}
+
+// ==================================================================
+// zstd stream compression
+
+#ifdef HAVE_ZSTD
+
+void ServerSocket::compress(int level, const std::string& ack)
+{
+    // Whatever another thread is sending goes out, whole, either
+    // before the ack, plain, or after it, compressed.
+    std::lock_guard<std::mutex> lck(_send_mtx);
+    if (_zstd)
+        throw RuntimeException(TRACE_INFO, "Already compressing");
+    if (_is_websocket)
+        throw RuntimeException(TRACE_INFO,
+            "Compression is not available over WebSockets");
+    if (level < ZSTD_minCLevel() or ZSTD_maxCLevel() < level)
+        throw RuntimeException(TRACE_INFO,
+            "zstd level must be from %d to %d",
+            ZSTD_minCLevel(), ZSTD_maxCLevel());
+
+    Send(boost::asio::const_buffer(ack.c_str(), ack.size()));
+    _zstd = new Zstd(level);
+}
+
+/// Compress, and send, flushing, so that the client can decompress
+/// all of it at once. Called with _send_mtx held.
+void ServerSocket::zstd_send(const char* data, size_t len)
+{
+    Zstd& z = *_zstd;
+    ZSTD_inBuffer in = {data, len, 0};
+    size_t left = 0;
+    do
+    {
+        ZSTD_outBuffer out = {&z.obuf[0], z.obuf.size(), 0};
+        left = ZSTD_compressStream2(z.cctx, &out, &in, ZSTD_e_flush);
+        if (ZSTD_isError(left))
+        {
+            logger().warn("ServerSocket::zstd_send(): %s",
+                ZSTD_getErrorName(left));
+            return;
+        }
+        if (out.pos)
+        {
+            Send(boost::asio::const_buffer(out.dst, out.pos));
+            z.out_wire += out.pos;
+        }
+    }
+    while (0 < left or in.pos < in.size);
+    z.out_raw += len;
+}
+
+/// Whatever was read past the line that turned on compression is
+/// already compressed. Move it out of the line buffer.
+void ServerSocket::zstd_take_input(boost::asio::streambuf& b)
+{
+    Zstd& z = *_zstd;
+    if (z.reading) return;
+    z.reading = true;
+    auto data = b.data();
+    z.raw.assign(boost::asio::buffers_begin(data),
+                 boost::asio::buffers_end(data));
+    b.consume(b.size());
+}
+
+/// Decompress at least one more byte into the buffer, reading the
+/// socket as needed.
+void ServerSocket::zstd_fill(boost::asio::streambuf& b)
+{
+    Zstd& z = *_zstd;
+    while (true)
+    {
+        if (z.raw.size() <= z.rpos)
+        {
+            z.raw.resize(65536);
+            size_t got = _socket->read_some(
+                boost::asio::buffer(&z.raw[0], z.raw.size()));
+            z.raw.resize(got);
+            z.rpos = 0;
+        }
+
+        ZSTD_inBuffer in = {z.raw.c_str(), z.raw.size(), z.rpos};
+        ZSTD_outBuffer ob = {&z.dbuf[0], z.dbuf.size(), 0};
+        size_t rc = ZSTD_decompressStream(z.dctx, &ob, &in);
+        if (ZSTD_isError(rc))
+        {
+            logger().warn("ServerSocket::zstd_fill(): %s; closing connection",
+                ZSTD_getErrorName(rc));
+            throw SilentException();
+        }
+        z.in_wire += in.pos - z.rpos;
+        z.rpos = in.pos;
+        if (0 == ob.pos) continue;
+
+        z.in_raw += ob.pos;
+        b.commit(boost::asio::buffer_copy(b.prepare(ob.pos),
+                                          boost::asio::buffer(z.dbuf, ob.pos)));
+        return;
+    }
+}
+
+std::string ServerSocket::zstd_stats(void)
+{
+    Zstd& z = *_zstd;
+    char buf[200];
+    snprintf(buf, sizeof(buf),
+        "zstd %8d  level: %d  in: %zu / %zu (%.1fx)  out: %zu / %zu (%.1fx)\n",
+        _tid, z.level,
+        z.in_raw.load(), z.in_wire.load(),
+        z.in_raw / std::max(1.0, (double) z.in_wire),
+        z.out_raw.load(), z.out_wire.load(),
+        z.out_raw / std::max(1.0, (double) z.out_wire));
+    return buf;
+}
+
+#else // HAVE_ZSTD
+
+// Without zstd, the `compress` command is not registered, so nothing
+// turns compression on, and the rest is never called.
+void ServerSocket::compress(int, const std::string&)
+{
+    throw RuntimeException(TRACE_INFO,
+        "The server was built without zstd");
+}
+
+void ServerSocket::zstd_send(const char*, size_t) {}
+void ServerSocket::zstd_take_input(boost::asio::streambuf&) {}
+void ServerSocket::zstd_fill(boost::asio::streambuf&) {}
+std::string ServerSocket::zstd_stats(void) { return ""; }
+
+#endif // HAVE_ZSTD
+
 // ==================================================================
 
 // Ths method is called in a new thread, when a new network connection is
@@ -431,15 +724,20 @@ void ServerSocket::handle_connection(void)
         try
         {
             _status = IWAIT;
+            if (_zstd) zstd_take_input(b);
             std::string line;
-            if (not _do_frame_io)
+            bool binary = _do_binary_io;
+            if (binary)
+               line = get_binary_frame(b);
+            else if (not _do_frame_io)
                line = get_telnet_line(b);
             else
                line = get_websocket_line();
 
             // Strip off carriage returns. The line already stripped
-            // newlines.
-            if (not line.empty() and line[line.length()-1] == '\r') {
+            // newlines. Binary WebSocket frames are left as they are.
+            if (not binary and not _ws_binary_frame and
+                not line.empty() and line[line.length()-1] == '\r') {
                 line.erase(line.end()-1);
             }
 
@@ -475,8 +773,9 @@ void ServerSocket::handle_connection(void)
     _last_activity = time(nullptr);
     _status = CLOSE;
 
-    // Perform cleanup at end, if in telnet mode.
-    if (not _is_websocket)
+    // Perform cleanup at end, if in telnet mode. A partial binary
+    // frame is useless; drop it.
+    if (not _is_websocket and not _do_binary_io)
     {
         // If the data sent to us is not new-line terminated, then
         // there may still be some bytes sitting in the buffer. Get
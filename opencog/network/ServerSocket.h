@@ -59,13 +59,35 @@ private:
     // Read a newline-delimited line of text from socket.
     std::string get_telnet_line(boost::asio::streambuf&);
 
+    // Read a length-prefixed binary frame from socket.
+    bool _do_binary_io;
+    std::string get_binary_frame(boost::asio::streambuf&);
+
     // Send an asio buffer that has data in it.
     void Send(const boost::asio::const_buffer&);
 
+    // Wait until the buffer holds at least this many bytes.
+    void fill(boost::asio::streambuf&, size_t);
+
+    // Held while anything is being sent, so that replies from
+    // different threads do not interleave, and so that compression
+    // starts between two of them, not in the middle of one.
+    std::mutex _send_mtx;
+
+    // zstd stream compression, once asked for; see compress().
+    struct Zstd;
+    std::atomic<Zstd*> _zstd;
+    void zstd_send(const char*, size_t);
+    void zstd_take_input(boost::asio::streambuf&);
+    void zstd_fill(boost::asio::streambuf&);
+    std::string zstd_stats(void);
+
     // WebSocket state machine; unused in the telnet interface.
     bool _got_first_line;
     bool _got_http_header;
     bool _do_frame_io;
+    bool _ws_binary;
+    bool _ws_binary_frame;  // The last frame read had the binary opcode.
     std::string _webkey;
     void HandshakeLine(const std::string&);
     std::string get_websocket_data(void);
@@ -84,6 +106,21 @@ protected:
      */
     virtual void OnConnection(void) = 0;
 
+    /**
+     * Switch between newline-delimited text and length-prefixed
+     * binary frames. In binary mode, each frame is a four-byte
+     * little-endian length followed by that many bytes; OnLine()
+     * receives the bytes, with nothing stripped. Used only by the
+     * reader thread, between calls to OnLine(). WebSockets have
+     * framing of their own; for them, this only makes replies go
+     * out as binary frames, instead of text frames.
+     */
+    void set_binary_io(bool b)
+    {
+        _do_binary_io = b and not _is_websocket;
+        _ws_binary = b and _is_websocket;
+    }
+
     /**
      * Callback: called when a client has sent us a line of text.
      */
@@ -105,6 +142,7 @@ public:
     ServerSocket(void);
     virtual ~ServerSocket();
     void act_as_websocket(void) { _is_websocket = true; }
+    bool is_websocket(void) const { return _is_websocket; }
 
     void set_connection(boost::asio::ip::tcp::socket*);
     void handle_connection(void);
@@ -114,6 +152,23 @@ public:
      */
     void Send(const std::string&);
 
+    /**
+     * Send `len` bytes from the file `fd`, starting at its current
+     * offset, with no framing of any kind. Returns false if the
+     * client went away. Not for WebSockets.
+     */
+    bool SendFile(int fd, size_t len);
+
+    /**
+     * Send `ack` as it is, and then compress everything sent after
+     * it with zstd, flushing after each Send(). Everything received
+     * after the line or frame now being handled is decompressed.
+     * Call only from OnLine(). Throws if already compressing, or on
+     * WebSockets. Only available when built with zstd.
+     */
+    void compress(int level, const std::string& ack);
+    bool compressing(void) const { return nullptr != _zstd; }
+
     /**
      * Close this socket. Called from a thread other than
      * the one that is actually polling the socket.
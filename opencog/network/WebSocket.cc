@@ -64,13 +64,14 @@ std::string ServerSocket::get_websocket_line()
 		throw SilentException();
 	}
 
-	// We only support text data.
-	if (1 != opcode)
+	// Text and binary data are both passed on as they are; it is up
+	// to the shell to make sense of them.
+	if (1 != opcode and 2 != opcode)
 	{
-		logger().warn("Not expecting binary websocket data; opcode=%d",
-			opcode);
+		logger().warn("Not expecting websocket opcode=%d", opcode);
 		throw SilentException();
 	}
+	_ws_binary_frame = (2 == opcode);
 
 	return get_websocket_data();
 }
@@ -161,7 +162,7 @@ void ServerSocket::send_websocket(const std::string& cmd)
     // Send only one packet, and indicate it's length.
     size_t paylen = cmd.size();
     char header[10];
-    header[0] = 0x81;
+    header[0] = _ws_binary ? 0x82 : 0x81;
     if (paylen < 126)
     {
         header[1] = (char) paylen;
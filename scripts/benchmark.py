@@ -0,0 +1,202 @@
+#! /usr/bin/env python3
+#
+# scripts/benchmark.py
+#
+# Time a cogserver from a build tree, so that the effect of the
+# startup, loading and dump options can be measured, and measured
+# again, on the same machine. Each measurement is repeated, and the
+# median is printed. Nothing is compared against a fixed number; the
+# point is to run it before and after a change.
+#
+# Usage:
+#    scripts/benchmark.py <build-dir> [--atoms N] [--repeat R] [--port P]
+#
+# The AtomSpace used for the loading measurements is synthetic: N
+# ListLinks of two ConceptNodes, each with a FloatValue.
+
+import argparse
+import os
+import re
+import socket
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+PROMPT = b"opencog> "
+
+
+class Server:
+    """A cogserver started with the given config text and options."""
+
+    def __init__(self, args, conf="", options=()):
+        self.port = args.port
+        self.conf = tempfile.NamedTemporaryFile("w", suffix=".conf")
+        self.conf.write(conf)
+        self.conf.flush()
+        cmd = [args.cogserver, "-c", self.conf.name, "-p", str(self.port),
+               "-w", "0", "-DANSI_ENABLED=false"]
+        cmd += ["-D" + opt for opt in options]
+
+        start = time.monotonic()
+        self.proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL,
+                                     stderr=subprocess.DEVNULL)
+        while True:
+            try:
+                self.sock = socket.create_connection(("127.0.0.1", self.port))
+                break
+            except ConnectionRefusedError:
+                if self.proc.poll() is not None:
+                    sys.exit("cogserver exited during startup")
+                time.sleep(0.005)
+        self.startup = time.monotonic() - start
+        self.buf = b""
+        self.read_until(PROMPT)
+
+    def recv(self):
+        got = self.sock.recv(1 << 20)
+        if not got:
+            sys.exit("cogserver closed the connection")
+        self.buf += got
+
+    def read_until(self, marker):
+        """Return everything up to and including `marker`."""
+        while marker not in self.buf:
+            self.recv()
+        end = self.buf.index(marker) + len(marker)
+        out, self.buf = self.buf[:end], self.buf[end:]
+        return out
+
+    def read_bytes(self, n):
+        while len(self.buf) < n:
+            self.recv()
+        out, self.buf = self.buf[:n], self.buf[n:]
+        return out
+
+    def command(self, line):
+        self.sock.sendall(line.encode() + b"\n")
+        return self.read_until(PROMPT).decode(errors="replace")
+
+    def dump(self):
+        """Read a `dump` to the end; return its size and the time."""
+        start = time.monotonic()
+        self.sock.sendall(b"dump\n")
+        nbytes = 0
+        while True:
+            n = int.from_bytes(self.read_bytes(4), "little")
+            if 0 == n:
+                break
+            self.read_bytes(n)
+            nbytes += n
+        secs = time.monotonic() - start
+        self.read_until(PROMPT)
+        return nbytes, secs
+
+    def stop(self):
+        self.sock.close()
+        self.proc.kill()
+        self.proc.wait()
+        self.conf.close()
+
+
+def seconds(reply, what):
+    """The number before ` seconds` in a command's reply."""
+    m = re.search(r"([0-9.]+) seconds", reply)
+    if not m:
+        sys.exit("unexpected reply to %s: %s" % (what, reply.strip()))
+    return float(m.group(1))
+
+
+def report(name, values, unit="s"):
+    med = statistics.median(values)
+    print("%-40s %10.3f %s   (%s)" % (name, med, unit,
+          ", ".join("%.3f" % v for v in values)))
+
+
+def startup(args):
+    modules = ("MODULES = libbuiltinreqs.so, libscheme-shell.so, "
+               "libpy-shell.so, libsexpr-shell.so, libjson-shell.so, "
+               "libtop-shell.so, libcheckpoint.so\n")
+    lazy = ("LAZY_MODULES = libscheme-shell.so:scm, libpy-shell.so:py:py-eval, "
+            "libjson-shell.so:json, libtop-shell.so:top\n")
+    cases = [
+        ("startup, modules in parallel", modules, ["PARALLEL_MODULE_LOAD=true"]),
+        ("startup, modules one at a time", modules, ["PARALLEL_MODULE_LOAD=false"]),
+        ("startup, shells loaded on first use", modules + lazy, []),
+    ]
+    for name, conf, options in cases:
+        times = []
+        for _ in range(args.repeat):
+            srv = Server(args, conf, options)
+            times.append(srv.startup)
+            srv.stop()
+        report(name, times)
+
+
+def write_atoms(path, natoms):
+    with open(path, "w") as out:
+        for i in range(natoms):
+            atom = '(List (Concept "left %d") (Concept "right %d"))' % (i, i % 97)
+            out.write(atom + "\n")
+            out.write('(cog-set-value! %s (Predicate "count") (FloatValue %d %d))\n'
+                      % (atom, i, 2 * i))
+
+
+def loading(args, workdir):
+    text = os.path.join(workdir, "atoms.scm")
+    snap = os.path.join(workdir, "atoms.snap")
+    write_atoms(text, args.atoms)
+    print("%d atoms, %.1f MB of text" %
+          (args.atoms, os.path.getsize(text) / 1048576.0))
+
+    modules = "MODULES = libbuiltinreqs.so, libcheckpoint.so\n"
+    threads = os.cpu_count() or 1
+    ingest = {1: [], threads: []}
+    save, load, dump, dump_mb = [], [], [], []
+    for _ in range(args.repeat):
+        for nthreads in ingest:
+            srv = Server(args, modules, ["INGEST_THREADS=%d" % nthreads])
+            ingest[nthreads].append(seconds(srv.command("ingest " + text),
+                                            "ingest"))
+            if nthreads == threads:
+                save.append(seconds(srv.command("snapshot save " + snap),
+                                    "snapshot save"))
+                nbytes, secs = srv.dump()
+                dump.append(secs)
+                dump_mb.append(nbytes / 1048576.0 / secs)
+            srv.stop()
+
+        srv = Server(args, modules, ["SNAPSHOT_LOAD_THREADS=%d" % threads])
+        load.append(seconds(srv.command("snapshot load " + snap),
+                            "snapshot load"))
+        srv.stop()
+
+    report("ingest text, 1 thread", ingest[1])
+    report("ingest text, %d threads" % threads, ingest[threads])
+    report("snapshot save", save)
+    report("snapshot load, %d threads" % threads, load)
+    report("dump, received by the client", dump)
+    report("dump rate", dump_mb, "MB/s")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Time a cogserver from a build tree.")
+    parser.add_argument("build", help="the cmake build directory")
+    parser.add_argument("--atoms", type=int, default=1000000)
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--port", type=int, default=17599)
+    args = parser.parse_args()
+    args.cogserver = os.path.join(args.build,
+                                  "opencog/cogserver/server/cogserver")
+    if not os.access(args.cogserver, os.X_OK):
+        sys.exit("no cogserver in " + args.build)
+
+    startup(args)
+    with tempfile.TemporaryDirectory() as workdir:
+        loading(args, workdir)
+
+
+if __name__ == "__main__":
+    main()
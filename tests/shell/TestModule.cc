@@ -0,0 +1,73 @@
+/*
+ * tests/shell/TestModule.cc
+ *
+ * A module that does nothing but take a while to construct, and note
+ * when it did so. Built several times, under different names, by
+ * tests/shell/CMakeLists.txt, for ModuleOrderUTest.
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <vector>
+
+#include <opencog/util/Config.h>
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/cogserver/server/CogServer.h>
+#include <opencog/cogserver/server/Module.h>
+
+using namespace opencog;
+
+#ifndef TEST_MODULE
+#define TEST_MODULE TestModule
+#endif
+#ifndef TEST_SLEEP_MS
+#define TEST_SLEEP_MS 0
+#endif
+
+static double now(void)
+{
+	std::chrono::duration<double> secs =
+		std::chrono::steady_clock::now().time_since_epoch();
+	return secs.count();
+}
+
+class TEST_MODULE : public Module
+{
+public:
+	static const char* id(void);
+
+	/// The start and end times of the constructor are attached to
+	/// (Concept "<id>") under (Predicate "constructed").
+	TEST_MODULE(CogServer& cs) : Module(cs)
+	{
+		double start = now();
+		usleep(TEST_SLEEP_MS * 1000);
+		AtomSpacePtr as = cs.getAtomSpace();
+		as->set_value(as->add_node(CONCEPT_NODE, id()),
+		              as->add_node(PREDICATE_NODE, "constructed"),
+		              createFloatValue(std::vector<double>{start, now()}));
+	}
+
+	/// The ids of the modules, in the order their init() ran.
+	virtual void init(void)
+	{
+		opencog::config().set("TEST_MODULE_INIT",
+		    opencog::config().get("TEST_MODULE_INIT", "") + id() + " ");
+	}
+
+	virtual bool config(const char*) { return false; }
+};
+
+// One more level, so that the name is expanded before it is quoted.
+#define DECLARE_TEST_MODULE(NAME) DECLARE_MODULE(NAME)
+DECLARE_TEST_MODULE(TEST_MODULE)
+
+#ifdef TEST_DEPENDS_FIRST
+DECLARE_MODULE_DEPENDS("FirstTestModule")
+#endif